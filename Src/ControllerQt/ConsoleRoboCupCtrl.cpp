@@ -11,6 +11,7 @@
 #include "Platform/SimRobotQt/LocalRobot.h"
 #include "Platform/Directory.h"
 #include "Platform/itoa.h"
+#include "Tools/ImageProcessing/YCbCrConversions.h"
 
 SystemCall::Mode ConsoleRoboCupCtrl::mode = SystemCall::simulatedRobot;
 std::string ConsoleRoboCupCtrl::logFile;
@@ -230,16 +231,24 @@ void ConsoleRoboCupCtrl::executeConsoleCommand(const std::string& command, Robot
   else if(buffer == "st")
   {
     stream >> buffer;
-    if(buffer == "on")
+    if(buffer == "on" || buffer == "lockstep")
     {
       if(!simTime)
       { // simulation time continues at real time
         time = getTime();
         simTime = true;
       }
+      setLockstep(buffer == "lockstep");
+      if(buffer == "lockstep" && !stream.eof())
+      {
+        unsigned seed;
+        stream >> seed;
+        setRandomSeed(seed);
+      }
     }
     else if(buffer == "off")
     {
+      setLockstep(false);
       if(simTime)
       { // real time contiues at simulation time
         time = getTime() - SystemCall::getRealSystemTime();
@@ -249,6 +258,15 @@ void ConsoleRoboCupCtrl::executeConsoleCommand(const std::string& command, Robot
     else
       printLn("Syntax Error");
   }
+  else if(buffer == "test")
+  {
+    stream >> buffer;
+    if(buffer == "yCbCr")
+      printLn(YCbCrConversions::selfTest() ? "The color conversions are bit-exact."
+                                           : "Error: The color conversions differ from their reference.");
+    else
+      printLn("Syntax Error");
+  }
   else if(buffer == "dt")
   {
     stream >> buffer;
@@ -344,8 +362,9 @@ void ConsoleRoboCupCtrl::help(InConfigMemory& stream)
   list("  echo <text> : Print text into console window. Useful in console.con.",pattern,true);
   list("  help | ? [<pattern>] : Display this text.",pattern,true);
   list("  robot ? | all | <name> {<name>} : Connect console to a set of active robots. Alternatively, double click one robot.",pattern,true);
-  list("  ro stopwatch ( off | <letter> ) | ( sensorData | robotHealth | motionRequest | linePercept ) ( off | on ) : Set release options sent by team communication.",pattern,true);
-  list("  st off | on : Switch simulation of time on or off.",pattern,true);
+  list("  ro stopwatch ( off | <letter> ) | ( sensorData | robotHealth | motionRequest | linePercept | moduleTimings ) ( off | on ) : Set release options sent by team communication.",pattern,true);
+  list("  st off | on | lockstep [<seed>] : Switch simulation of time on or off. In lockstep mode, the processes of all robots run in parallel, but in lockstep with the simulation. A seed for their random numbers can be given.",pattern,true);
+  list("  test yCbCr : Check whether the vectorized color conversions are bit-exact with their reference. Takes a while.",pattern,true);
   list("  # <text> : Comment.",pattern,true);
   list("Robot commands:",pattern,true);
   list("  bc <red%> <green%> <blue%> : Set the background color of all 3-D views.",pattern,true);
@@ -355,8 +374,9 @@ void ConsoleRoboCupCtrl::help(InConfigMemory& stream)
   list("  get ? [<pattern>] | <key> [?]: Show debug data or show its specification.",pattern,true);
   list("  jc hide | show | ( motion | [press | release] <button> ) <command> : Set joystick motion (use $1 .. $6) or button command.",pattern,true);
   list("  js <axis> <speed> <threshold> : Set axis maximum speed and ignore threshold for command \"jc motion\".",pattern,true);
-  list("  log start | stop | clear | save <file> | full | jpeg : Record log file and (de)activate image compression.",pattern,true);
+  list("  log start | stop | clear | save <file> [<keyframes>] | full | jpeg : Record log file and (de)activate image compression. Indexed log files (*.ilog) are delta compressed if a keyframe interval is given.",pattern,true);
   list("  log saveImages (raw) <file> : Save images from log.",pattern,true);
+  list("  log index <file> [<keyframes>] : Convert log file into an indexed log file (*.ilog) that is played without loading it. It is delta compressed if a keyframe interval is given.",pattern,true);
   list("  log ? | load <file> | ( keep | remove ) <message> {<message>} : Load, filter, and display information about log file.",pattern,true);
   list("  log start | pause | stop | forward | backward | repeat | goto <number> | cycle | once : Replay log file.",pattern,true);
   list("  mof : Recompile motion net and send it to the robot. ",pattern,true);
@@ -519,6 +539,13 @@ bool ConsoleRoboCupCtrl::setReleaseOptions(InConfigMemory& stream)
       releaseOptions.linePercept = false;
     else
       return false;
+  else if(option == "moduleTimings")
+    if(state == "on" || state == "")
+      releaseOptions.moduleTimings = true;
+    else if (state == "off")
+      releaseOptions.moduleTimings = false;
+    else
+      return false;
   else
     return false;
 
@@ -587,6 +614,8 @@ void ConsoleRoboCupCtrl::createCompletion()
     "js",
     "st off",
     "st on",
+    "st lockstep",
+    "test yCbCr",
     "dt off",
     "dt on",
     "ci off",
@@ -596,6 +625,7 @@ void ConsoleRoboCupCtrl::createCompletion()
     "log save",
     "log saveImages",
     "log saveImages raw",
+    "log index",
     "log clear",
     "log full",
     "log jpeg",
@@ -632,6 +662,8 @@ void ConsoleRoboCupCtrl::createCompletion()
     "ro motionRequest on",
     "ro linePercept off",
     "ro linePercept on",
+    "ro moduleTimings off",
+    "ro moduleTimings on",
     "robot all",
     "v3 image jpeg",
     "vf",
@@ -681,6 +713,8 @@ void ConsoleRoboCupCtrl::createCompletion()
   }
 
   addCompletionFiles("log load ", std::string(File::getGTDir()) + "\\Config\\Logs\\*.log");
+  addCompletionFiles("log load ", std::string(File::getGTDir()) + "\\Config\\Logs\\*.ilog");
+  addCompletionFiles("log index ", std::string(File::getGTDir()) + "\\Config\\Logs\\*.log");
   addCompletionFiles("log save ", std::string(File::getGTDir()) + "\\Config\\Logs\\*.log");
   addCompletionFiles("call ", "*.con");
   addCompletionFiles("ct load ", std::string(File::getGTDir()) + "\\Config\\" + settings.expandLocationFilename("*.c64"));
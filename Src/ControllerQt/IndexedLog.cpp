@@ -0,0 +1,416 @@
+/**
+* @file ControllerQt/IndexedLog.cpp
+*
+* Implementation of classes for reading and writing log files with a frame index.
+*/
+
+#include "IndexedLog.h"
+#include "Tools/Streams/InStreams.h"
+#include "Platform/GTAssert.h"
+#include "Tools/CRC.h"
+#include <string.h>
+
+/**
+* The function writes a 64 bit offset as two 32 bit values.
+* @param stream The stream to write on.
+* @param offset The offset.
+*/
+static void writeOffset(Out& stream, unsigned long long offset)
+{
+  stream << (unsigned) offset << (unsigned) (offset >> 32);
+}
+
+/**
+* The function reads a 64 bit offset that was written by writeOffset().
+* @param stream The stream from which is read.
+* @return The offset.
+*/
+static unsigned long long readOffset(In& stream)
+{
+  unsigned low, 
+           high;
+  stream >> low >> high;
+  return (unsigned long long) high << 32 | low;
+}
+
+/**
+* The function appends an unsigned number to a buffer using 7 bits per byte.
+* The highest bit of each byte signals that more bytes follow.
+* @param buffer The buffer.
+* @param value The number.
+*/
+static void writeVarint(std::vector<char>& buffer, unsigned value)
+{
+  while(value >= 0x80)
+  {
+    buffer.push_back((char) (value | 0x80));
+    value >>= 7;
+  }
+  buffer.push_back((char) value);
+}
+
+/**
+* The function reads a number that was written by writeVarint().
+* @param p The current position. It is advanced behind the number.
+* @param end The end of the data.
+* @param value The number is returned here.
+* @return Was the number complete?
+*/
+static bool readVarint(const unsigned char*& p, const unsigned char* end, unsigned& value)
+{
+  value = 0;
+  for(int shift = 0; p < end && shift < 32; shift += 7)
+  {
+    value |= (unsigned) (*p & 0x7f) << shift;
+    if(!(*p++ & 0x80))
+      return true;
+  }
+  return false;
+}
+
+/**
+* The function returns a byte of the previous message. The previous message is
+* continued by zeros, so messages can grow.
+* @param previous The previous message.
+* @param index The index of the byte.
+* @return The byte.
+*/
+inline char getPrevious(const std::vector<char>& previous, size_t index)
+{
+  return index < previous.size() ? previous[index] : 0;
+}
+
+/**
+* The function encodes a message as a delta to the previous message with the same id.
+* The encoding is stopped as soon as the delta is not smaller than the message.
+* @param data The message.
+* @param size The size of the message.
+* @param previous The previous message.
+* @param delta The delta is returned here.
+*/
+static void encodeDelta(const char* data, int size, const std::vector<char>& previous, std::vector<char>& delta)
+{
+  delta.clear();
+  writeVarint(delta, size);
+  for(int i = 0; i < size && (int) delta.size() < size;)
+  {
+    int firstChanged = i;
+    while(firstChanged < size && data[firstChanged] == getPrevious(previous, firstChanged))
+      ++firstChanged;
+    int firstUnchanged = firstChanged;
+    while(firstUnchanged < size && data[firstUnchanged] != getPrevious(previous, firstUnchanged))
+      ++firstUnchanged;
+    writeVarint(delta, firstChanged - i);
+    writeVarint(delta, firstUnchanged - firstChanged);
+    for(int j = firstChanged; j < firstUnchanged; ++j)
+      delta.push_back(data[j] ^ getPrevious(previous, j));
+    i = firstUnchanged;
+  }
+}
+
+/**
+* The function decodes a delta written by encodeDelta().
+* @param data The delta.
+* @param size The size of the delta.
+* @param previous The previous message.
+* @param message The decoded message is returned here.
+* @return Was the delta intact?
+*/
+static bool decodeDelta(const char* data, int size, const std::vector<char>& previous, std::vector<char>& message)
+{
+  const unsigned char* p = (const unsigned char*) data,
+                     * end = p + size;
+  unsigned messageSize;
+  if(!readVarint(p, end, messageSize) || messageSize >= 0x1000000)
+    return false;
+  message.resize(messageSize);
+  for(unsigned i = 0; i < messageSize;)
+  {
+    unsigned numOfUnchanged,
+             numOfChanged;
+    if(!readVarint(p, end, numOfUnchanged) || !readVarint(p, end, numOfChanged) ||
+       numOfUnchanged > messageSize - i || numOfChanged > messageSize - i - numOfUnchanged ||
+       numOfChanged > (unsigned) (end - p))
+      return false;
+    for(const unsigned last = i + numOfUnchanged; i < last; ++i)
+      message[i] = getPrevious(previous, i);
+    for(const unsigned last = i + numOfChanged; i < last; ++i)
+      message[i] = (char) (*p++ ^ getPrevious(previous, i));
+  }
+  return p == end;
+}
+
+IndexedLog::IndexedLog() :
+  numberOfMessages(0),
+  keyframeInterval(0),
+  nextFrame(-1),
+  window(0),
+  windowBegin(0),
+  windowEnd(0) 
+{
+}
+
+bool IndexedLog::open(const std::string& fileName)
+{
+  close();
+  if(!file.open(fileName))
+    return false;
+
+  const unsigned headerSize = 8,
+                 trailerSize = 12;
+  unsigned long long footerBegin = 0;
+  unsigned header[2] = {0, 0};
+  if(file.getSize() >= headerSize + trailerSize)
+  {
+    const char* p = getRange(0, headerSize);
+    if(p)
+      memcpy(header, p, headerSize);
+    const char* trailer = getRange(file.getSize() - trailerSize, file.getSize());
+    if(trailer && header[0] == magic && header[1] >= 1 && header[1] <= version && ((const unsigned*) trailer)[2] == magic)
+    {
+      InBinaryMemory stream(trailer, trailerSize);
+      footerBegin = readOffset(stream);
+    }
+  }
+
+  const char* footer = footerBegin >= headerSize && footerBegin < file.getSize() - trailerSize 
+                       ? getRange(footerBegin, file.getSize() - trailerSize) : 0;
+  if(!footer)
+  {
+    close();
+    return false;
+  }
+
+  InBinaryMemory stream(footer, (unsigned) (file.getSize() - trailerSize - footerBegin));
+  int numberOfFrames,
+      numOfIDs;
+  stream >> numberOfMessages >> numberOfFrames;
+  frameOffsets.resize(numberOfFrames + 1);
+  for(std::vector<unsigned long long>::iterator i = frameOffsets.begin(); i != frameOffsets.end(); ++i)
+    *i = readOffset(stream);
+  if(header[1] >= 2)
+  {
+    frameChecksums.resize(numberOfFrames);
+    for(std::vector<unsigned>::iterator i = frameChecksums.begin(); i != frameChecksums.end(); ++i)
+      stream >> *i;
+  }
+  if(header[1] >= 3)
+    stream >> keyframeInterval;
+  stream >> numOfIDs;
+  frequencies.resize(numOfIDs);
+  for(std::vector<int>::iterator i = frequencies.begin(); i != frequencies.end(); ++i)
+    stream >> *i;
+  return true;
+}
+
+void IndexedLog::close()
+{
+  file.close();
+  frameOffsets.clear();
+  frameChecksums.clear();
+  frequencies.clear();
+  numberOfMessages = 0;
+  keyframeInterval = 0;
+  nextFrame = -1;
+  window = 0;
+  windowBegin = windowEnd = 0;
+}
+
+void IndexedLog::statistics(int frequency[numOfDataMessageIDs]) const
+{
+  for(int i = 0; i < numOfDataMessageIDs; ++i)
+    frequency[i] = i < (int) frequencies.size() ? frequencies[i] : 0;
+}
+
+bool IndexedLog::copyFrame(int frame, MessageQueue& queue)
+{
+  ASSERT(frame >= 0 && frame < getNumberOfFrames());
+  // Deltas refer to the previous messages, so the frames since the last keyframe are decoded first.
+  if(keyframeInterval && frame != nextFrame)
+    for(int i = frame - frame % keyframeInterval; i < frame; ++i)
+      if(!readFrame(i, 0))
+        return false;
+  return readFrame(frame, &queue);
+}
+
+bool IndexedLog::readFrame(int frame, MessageQueue* queue)
+{
+  nextFrame = -1;
+  const char* p = getRange(frameOffsets[frame], frameOffsets[frame + 1]);
+  const size_t size = (size_t) (frameOffsets[frame + 1] - frameOffsets[frame]);
+  if(!p || (!frameChecksums.empty() && CRC::calcCRC32(p, size) != frameChecksums[frame]))
+    return false;
+
+  // Nothing of a frame is added to the queue if any of its messages cannot be decoded.
+  const int numOfMessages = queue ? queue->getNumberOfMessages() : 0;
+  for(const char* end = p + size; p < end;)
+  {
+    int size = 0;
+    if(end - p >= 4)
+      memcpy(&size, p + 1, 3);
+    const unsigned char id = (unsigned char) *p;
+    const char* data = p + 4;
+    p += 4 + size;
+    const unsigned char originalId = (unsigned char) (id & ~deltaFlag);
+    if(p > end || originalId >= numOfDataMessageIDs ||
+       ((id & deltaFlag) && !decodeDelta(data, size, previousMessages[originalId], decoded)))
+    {
+      if(queue)
+        while(queue->getNumberOfMessages() > numOfMessages)
+          queue->removeLastMessage();
+      return false;
+    }
+    if(id & deltaFlag)
+    {
+      previousMessages[originalId].swap(decoded);
+      if(queue)
+      {
+        const std::vector<char>& message = previousMessages[originalId];
+        if(!message.empty())
+          queue->out.bin.write(&message[0], (int) message.size());
+        queue->out.finishMessage(MessageID(originalId));
+      }
+    }
+    else
+    {
+      if(keyframeInterval)
+        previousMessages[id].assign(data, data + size);
+      if(queue)
+      {
+        queue->out.bin.write(data, size);
+        queue->out.finishMessage(MessageID(id));
+      }
+    }
+  }
+  nextFrame = frame + 1;
+  return true;
+}
+
+const char* IndexedLog::getRange(unsigned long long begin, unsigned long long end)
+{
+  if(!window || begin < windowBegin || end > windowEnd)
+  {
+    // Map at least windowSize bytes, so that the following frames can be accessed without mapping again.
+    windowBegin = begin;
+    windowEnd = end;
+    if(windowEnd < windowBegin + windowSize)
+      windowEnd = windowBegin + windowSize;
+    if(windowEnd > file.getSize())
+      windowEnd = file.getSize();
+    window = file.map(windowBegin, (size_t) (windowEnd - windowBegin));
+    if(!window)
+      return 0;
+  }
+  return window + (begin - windowBegin);
+}
+
+bool IndexedLog::convert(const std::string& logFileName, const std::string& indexedLogFileName, int keyframeInterval)
+{
+  InBinaryFile in(logFileName);
+  if(!in.exists())
+    return false;
+  IndexedLogWriter out(indexedLogFileName, keyframeInterval);
+  if(!out.exists())
+    return false;
+
+  int usedSize,
+      numberOfMessages;
+  in >> usedSize >> numberOfMessages;
+  std::vector<char> buffer;
+  for(int i = 0; (numberOfMessages == -1 && !in.eof()) || i < numberOfMessages; ++i)
+  {
+    unsigned char id = 0;
+    int size = 0;
+    in >> id;
+    in.read(&size, 3);
+    if(size > (int) buffer.size())
+      buffer.resize(size);
+    if(size)
+      in.read(&buffer[0], size);
+    if(id < numOfDataMessageIDs)
+      out.write(MessageID(id), size ? &buffer[0] : 0, size);
+  }
+  out.finish();
+  return true;
+}
+
+IndexedLogWriter::IndexedLogWriter(const std::string& fileName, int keyframeInterval) :
+  stream(fileName),
+  position(0),
+  frameChecksum(0),
+  numberOfMessages(0),
+  keyframeInterval(keyframeInterval)
+{
+  ASSERT(numOfDataMessageIDs <= IndexedLog::deltaFlag);
+  ASSERT(keyframeInterval >= 0);
+  for(int i = 0; i < numOfDataMessageIDs; ++i)
+  {
+    frequencies[i] = 0;
+    hasPrevious[i] = false;
+  }
+  if(stream.exists())
+  {
+    stream << (unsigned) IndexedLog::magic << (unsigned) IndexedLog::version;
+    position = 8;
+    frameOffsets.push_back(position);
+  }
+}
+
+void IndexedLogWriter::write(MessageID id, const char* data, int size)
+{
+  ASSERT(id < numOfDataMessageIDs);
+  char header[4];
+  header[0] = (char) id;
+  const char* stored = data;
+  int storedSize = size;
+  if(keyframeInterval)
+  {
+    std::vector<char>& previous = previousMessages[id];
+    if(hasPrevious[id])
+    {
+      encodeDelta(data, size, previous, delta);
+      if((int) delta.size() < size)
+      {
+        header[0] |= IndexedLog::deltaFlag;
+        stored = &delta[0];
+        storedSize = (int) delta.size();
+      }
+    }
+    previous.assign(data, data + size);
+    hasPrevious[id] = true;
+  }
+  memcpy(header + 1, &storedSize, 3);
+  stream.write(header, 4);
+  stream.write(stored, storedSize);
+  frameChecksum = CRC::calcCRC32(stored, storedSize, CRC::calcCRC32(header, 4, frameChecksum));
+  position += 4 + storedSize;
+  ++numberOfMessages;
+  ++frequencies[id];
+  if(id == idProcessFinished)
+  {
+    frameOffsets.push_back(position);
+    frameChecksums.push_back(frameChecksum);
+    frameChecksum = 0;
+
+    // The next frame is a keyframe, i.e. it is stored without deltas.
+    if(keyframeInterval && (frameOffsets.size() - 1) % keyframeInterval == 0)
+      for(int i = 0; i < numOfDataMessageIDs; ++i)
+        hasPrevious[i] = false;
+  }
+}
+
+void IndexedLogWriter::finish()
+{
+  // Messages behind the last idProcessFinished are kept, but they do not belong to a frame.
+  const unsigned long long footerBegin = position;
+  stream << numberOfMessages << (int) frameOffsets.size() - 1;
+  for(std::vector<unsigned long long>::const_iterator i = frameOffsets.begin(); i != frameOffsets.end(); ++i)
+    writeOffset(stream, *i);
+  for(std::vector<unsigned>::const_iterator i = frameChecksums.begin(); i != frameChecksums.end(); ++i)
+    stream << *i;
+  stream << keyframeInterval << (int) numOfDataMessageIDs;
+  for(int i = 0; i < numOfDataMessageIDs; ++i)
+    stream << frequencies[i];
+  writeOffset(stream, footerBegin);
+  stream << (unsigned) IndexedLog::magic;
+}
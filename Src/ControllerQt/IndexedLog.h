@@ -0,0 +1,188 @@
+/**
+* @file ControllerQt/IndexedLog.h
+*
+* Declaration of classes for reading and writing log files with a frame index.
+*/
+
+#ifndef IndexedLog_h_
+#define IndexedLog_h_
+
+#include "Platform/MappedFile.h"
+#include "Tools/MessageQueue/MessageQueue.h"
+#include "Tools/Streams/OutStreams.h"
+#include <vector>
+
+/**
+* @class IndexedLog
+*
+* A log file that is accessed frame by frame through memory mapping instead of being
+* read completely. The file starts with a magic number and a version, followed by
+* the messages in the same layout as in a MessageQueue. A footer contains the number
+* of messages, the offset of the first message of each frame, a CRC32 checksum of each
+* frame, and a histogram of the message ids. The last bytes of the file contain the offset of the footer and the
+* magic number again. Therefore, opening a file only requires to read the footer, and
+* any frame can be accessed in constant time. Only a window of the file is mapped at
+* a time, so the memory required does not depend on the length of the log file.
+* Frames are checked against their checksums when they are read. Files of version 1
+* do not contain checksums.
+* Since version 3, messages can be stored as deltas to the previous message with the
+* same id. Such messages have the bit deltaFlag set in their id. Their data is the
+* original size as a varint, followed by pairs of varints that specify a number of
+* bytes unchanged and a number of bytes changed, each of the latter followed by the
+* changed bytes XORed with the previous message. A delta is only stored if it is
+* smaller than the message itself. Every keyframeInterval frames, all messages are
+* stored completely, so a frame can be decoded by reading the frames since the last
+* keyframe. The interval is stored in the footer, 0 means that there are no deltas.
+*/
+class IndexedLog
+{
+public:
+  enum
+  {
+    magic = 0x4c494842, /**< "BHIL" */
+    version = 3, /**< The version of the file format. */
+    deltaFlag = 0x80, /**< The bit set in the ids of messages stored as deltas. */
+    windowSize = 0x1000000 /**< The minimum size of the range of the file mapped (16 MB). */
+  };
+
+  /** Constructor. */
+  IndexedLog();
+
+  /**
+  * The method opens a log file.
+  * @param fileName The name of the file.
+  * @return Was the file opened and is it an indexed log file?
+  */
+  bool open(const std::string& fileName);
+
+  /** The method closes the log file. */
+  void close();
+
+  /**
+  * The method returns whether a log file is open.
+  * @return Is a log file open?
+  */
+  bool isOpen() const {return file.isOpen();}
+
+  /**
+  * The method returns the number of complete frames in the log file.
+  * @return The number of frames.
+  */
+  int getNumberOfFrames() const {return (int) frameOffsets.size() - 1;}
+
+  /**
+  * The method returns the number of messages in the log file.
+  * @return The number of messages.
+  */
+  int getNumberOfMessages() const {return numberOfMessages;}
+
+  /**
+  * The method returns the histogram of the message ids contained in the log file.
+  * @param frequency An array that is filled with the frequency of message ids.
+  */
+  void statistics(int frequency[numOfDataMessageIDs]) const;
+
+  /**
+  * The method copies all messages of a frame to a message queue. Messages stored as
+  * deltas are decoded. If the frame does not follow the one copied before, the frames
+  * since the last keyframe are decoded first.
+  * @param frame The number of the frame.
+  * @param queue The queue the messages are appended to.
+  * @return Could the frame be read and was it intact?
+  */
+  bool copyFrame(int frame, MessageQueue& queue);
+
+  /**
+  * The method converts a log file in the format written by MessageQueue into an indexed
+  * log file. The messages are processed one by one, so the log file is never read completely.
+  * @param logFileName The name of the log file that is converted.
+  * @param indexedLogFileName The name of the indexed log file that is written.
+  * @param keyframeInterval The number of frames after which all messages are stored
+  *                         completely again. 0 disables the delta compression.
+  * @return Was the conversion successful?
+  */
+  static bool convert(const std::string& logFileName, const std::string& indexedLogFileName, int keyframeInterval = 0);
+
+private:
+  MappedFile file; /**< The log file. */
+  std::vector<unsigned long long> frameOffsets; /**< The offsets of the first message of each frame plus the end of the last frame. */
+  std::vector<unsigned> frameChecksums; /**< The CRC32 checksums of all frames. Empty for files of version 1. */
+  std::vector<int> frequencies; /**< The number of messages per message id. */
+  int numberOfMessages; /**< The number of messages in the log file. */
+  int keyframeInterval; /**< The number of frames between two keyframes. 0 if the file contains no deltas. */
+  int nextFrame; /**< The frame that can be decoded without reading its predecessors. -1 if there is none. */
+  std::vector<char> previousMessages[numOfDataMessageIDs]; /**< The last message decoded per message id. */
+  std::vector<char> decoded; /**< A buffer for decoding a delta. */
+  const char* window; /**< The address of the range of the file that is mapped. */
+  unsigned long long windowBegin, /**< The offset of the first byte mapped. */
+                     windowEnd; /**< The offset of the byte after the range mapped. */
+
+  /**
+  * The method returns the address of a range of the file. If the range is not
+  * part of the current window, a new window is mapped.
+  * @param begin The offset of the first byte of the range.
+  * @param end The offset of the byte after the range.
+  * @return The address of the first byte of the range or 0 if it cannot be accessed.
+  */
+  const char* getRange(unsigned long long begin, unsigned long long end);
+
+  /**
+  * The method reads all messages of a frame and decodes the deltas among them.
+  * @param frame The number of the frame.
+  * @param queue The queue the messages are appended to. If 0, the frame is only
+  *              decoded to update the previous messages.
+  * @return Could the frame be read and was it intact?
+  */
+  bool readFrame(int frame, MessageQueue* queue);
+};
+
+/**
+* @class IndexedLogWriter
+*
+* The class writes an indexed log file message by message.
+*/
+class IndexedLogWriter
+{
+public:
+  /**
+  * Constructor.
+  * @param fileName The name of the file that is written.
+  * @param keyframeInterval The number of frames after which all messages are stored
+  *                         completely again. 0 disables the delta compression.
+  */
+  IndexedLogWriter(const std::string& fileName, int keyframeInterval = 0);
+
+  /**
+  * The method returns whether the file could be created.
+  * @return Can the file be written?
+  */
+  bool exists() const {return stream.exists();}
+
+  /**
+  * The method writes a message. A frame ends with each message of the type idProcessFinished.
+  * @param id The type of the message.
+  * @param data The address of the message data.
+  * @param size The size of the message data in bytes.
+  */
+  void write(MessageID id, const char* data, int size);
+
+  /**
+  * The method writes the frame index. It must be called after all messages were written.
+  */
+  void finish();
+
+private:
+  OutBinaryFile stream; /**< The file that is written. */
+  unsigned long long position; /**< The current offset in the file. */
+  std::vector<unsigned long long> frameOffsets; /**< The offsets of the first message of each frame written. */
+  std::vector<unsigned> frameChecksums; /**< The CRC32 checksums of all complete frames written. */
+  unsigned frameChecksum; /**< The CRC32 checksum of the messages of the current frame written so far. */
+  int frequencies[numOfDataMessageIDs]; /**< The number of messages per message id. */
+  int numberOfMessages; /**< The number of messages written. */
+  int keyframeInterval; /**< The number of frames between two keyframes. 0 if no deltas are written. */
+  std::vector<char> previousMessages[numOfDataMessageIDs]; /**< The last message written per message id. */
+  bool hasPrevious[numOfDataMessageIDs]; /**< Was a message of this id written since the last keyframe? */
+  std::vector<char> delta; /**< A buffer for encoding a delta. */
+};
+
+#endif //IndexedLog_h_
@@ -19,16 +19,27 @@ targetQueue(targetQueue)
 
 void LogPlayer::init()
 {
+  indexedLog.close();
   clear();
   stop();
   numberOfFrames = 0;
   numberOfMessagesWithinCompleteFrames = 0;
   state = initial;
+  corruptFrame = -1;
   loop = true; //default: loop enabled
 }
 
 bool LogPlayer::open(const char* fileName)
 {
+  if(indexedLog.open(fileName))
+  {
+    clear();
+    stop();
+    numberOfFrames = indexedLog.getNumberOfFrames();
+    numberOfMessagesWithinCompleteFrames = 0;
+    return true;
+  }
+
   InBinaryFile file(fileName);
   if(file.exists())
   {
@@ -60,7 +71,7 @@ void LogPlayer::stop()
 
 void LogPlayer::pause()
 {
-  if(getNumberOfMessages() == 0)
+  if(getNumberOfMessages() == 0 && !indexedLog.isOpen())
     state = initial;
   else
     state = paused;
@@ -71,9 +82,10 @@ void LogPlayer::stepBackward()
   pause();
   if(state == paused && currentFrameNumber > 0)
   {
-    do
-      queue.setSelectedMessageForReading(--currentMessageNumber);
-    while(currentMessageNumber > 0 && queue.getMessageID() != idProcessFinished);
+    if(!indexedLog.isOpen())
+      do
+        queue.setSelectedMessageForReading(--currentMessageNumber);
+      while(currentMessageNumber > 0 && queue.getMessageID() != idProcessFinished);
     --currentFrameNumber;
     stepRepeat();
   }
@@ -83,12 +95,7 @@ void LogPlayer::stepForward()
 {
   pause();
   if(state == paused && currentFrameNumber < numberOfFrames - 1)
-  {
-    do
-      copyMessage(++currentMessageNumber, targetQueue);
-    while(queue.getMessageID() != idProcessFinished);
-    ++currentFrameNumber;
-  }
+    nextFrame();
 }
 
 void LogPlayer::stepRepeat()
@@ -96,9 +103,10 @@ void LogPlayer::stepRepeat()
   pause();
   if(state == paused && currentFrameNumber >= 0)
   {
-    do
-      queue.setSelectedMessageForReading(--currentMessageNumber);
-    while(currentMessageNumber > 0 && queue.getMessageID() != idProcessFinished);
+    if(!indexedLog.isOpen())
+      do
+        queue.setSelectedMessageForReading(--currentMessageNumber);
+      while(currentMessageNumber > 0 && queue.getMessageID() != idProcessFinished);
     --currentFrameNumber;
     stepForward();
   }
@@ -111,24 +119,43 @@ void LogPlayer::gotoFrame(int frame)
   {
     currentFrameNumber = -1;
     currentMessageNumber = -1; 
-    while(++currentMessageNumber < getNumberOfMessages() && frame > currentFrameNumber + 1)
-    {
-      queue.setSelectedMessageForReading(currentMessageNumber);
-      if(queue.getMessageID() == idProcessFinished)
-        ++currentFrameNumber;
-    }
+    if(indexedLog.isOpen())
+      currentFrameNumber = frame - 1;
+    else
+      while(++currentMessageNumber < getNumberOfMessages() && frame > currentFrameNumber + 1)
+      {
+        queue.setSelectedMessageForReading(currentMessageNumber);
+        if(queue.getMessageID() == idProcessFinished)
+          ++currentFrameNumber;
+      }
     stepForward();
   }
 }
 
-bool LogPlayer::save(const char* fileName)
+bool LogPlayer::save(const char* fileName, int keyframeInterval)
 {
   if(state == recording)
     recordStop();
+  loadIndexedLog();
 
   if(!getNumberOfMessages())
     return false;
 
+  const size_t length = strlen(fileName);
+  if(length > 5 && !strcmp(fileName + length - 5, ".ilog"))
+  {
+    IndexedLogWriter writer(fileName, keyframeInterval);
+    if(!writer.exists())
+      return false;
+    for(int i = 0; i < getNumberOfMessages(); ++i)
+    {
+      queue.setSelectedMessageForReading(i);
+      writer.write(queue.getMessageID(), queue.getData(), queue.getMessageSize());
+    }
+    writer.finish();
+    return true;
+  }
+
   OutBinaryFile file(fileName);
   if(file.exists())
   {
@@ -150,6 +177,8 @@ bool LogPlayer::saveImages(const bool raw, const char* fileName)
     unsigned long z2,z3,z4,z5;
   } bmpHeader;
   
+  loadIndexedLog();
+
   char name[512];
   char fname[512];
   strcpy(name,fileName);
@@ -241,6 +270,7 @@ bool LogPlayer::saveImages(const bool raw, const char* fileName)
 
 void LogPlayer::recordStart()
 {
+  loadIndexedLog();
   state = recording;
 }
 
@@ -278,10 +308,8 @@ bool LogPlayer::replay()
   {
     if(currentFrameNumber < numberOfFrames - 1)
     {
-      do
-        copyMessage(++currentMessageNumber, targetQueue);
-      while(queue.getMessageID() != idProcessFinished);
-      ++currentFrameNumber;
+      if(!nextFrame())
+        return false;
       if(currentFrameNumber == numberOfFrames - 1)
       {
         if (loop) //restart in loop mode
@@ -310,6 +338,7 @@ bool LogPlayer::replay()
 
 void LogPlayer::keep(MessageID* messageIDs)
 {
+  loadIndexedLog();
   LogPlayer temp((MessageQueue&) *this);
   moveAllMessages(temp);
   for(temp.currentMessageNumber = 0; temp.currentMessageNumber < temp.getNumberOfMessages(); ++temp.currentMessageNumber)
@@ -332,6 +361,7 @@ void LogPlayer::keep(MessageID* messageIDs)
 
 void LogPlayer::remove(MessageID* messageIDs)
 {
+  loadIndexedLog();
   LogPlayer temp((MessageQueue&) *this);
   moveAllMessages(temp);
   for(temp.currentMessageNumber = 0; temp.currentMessageNumber < temp.getNumberOfMessages(); ++temp.currentMessageNumber)
@@ -353,6 +383,12 @@ void LogPlayer::remove(MessageID* messageIDs)
 
 void LogPlayer::statistics(int frequency[numOfDataMessageIDs])
 {
+  if(indexedLog.isOpen())
+  {
+    indexedLog.statistics(frequency);
+    return;
+  }
+
   for(int i = 0; i < numOfDataMessageIDs; ++i)
     frequency[i] = 0;
 
@@ -379,3 +415,43 @@ void LogPlayer::countFrames()
     }
   }
 }
+
+bool LogPlayer::nextFrame()
+{
+  if(indexedLog.isOpen())
+  {
+    if(!indexedLog.copyFrame(currentFrameNumber + 1, targetQueue))
+    {
+      corruptFrame = currentFrameNumber + 1;
+      stop();
+      return false;
+    }
+  }
+  else
+    do
+      copyMessage(++currentMessageNumber, targetQueue);
+    while(queue.getMessageID() != idProcessFinished);
+  ++currentFrameNumber;
+  return true;
+}
+
+void LogPlayer::loadIndexedLog()
+{
+  if(indexedLog.isOpen())
+  {
+    clear();
+    for(int i = 0; i < indexedLog.getNumberOfFrames(); ++i)
+    {
+      if(!indexedLog.copyFrame(i, *this))
+      {
+        corruptFrame = i;
+        stop();
+        break;
+      }
+      if(i == currentFrameNumber) // continue at the same position
+        currentMessageNumber = getNumberOfMessages() - 1;
+    }
+    indexedLog.close();
+    countFrames();
+  }
+}
@@ -10,12 +10,15 @@
 #define LogPlayer_h_
 
 #include "Tools/MessageQueue/MessageQueue.h"
+#include "IndexedLog.h"
 
 /**
 * @class LogPlayer
 *
 * A message queue that can record and play logfiles.
 * The messages are played in the same time sequence as they were recorded.
+* Indexed log files are not read into the queue, but are played directly
+* from the file. They are only loaded completely if they are modified or saved.
 *
 * @author Martin Ltzsch
 */
@@ -33,11 +36,19 @@ public:
 
   /** 
   * Opens a log file and reads all messages into the queue.
+  * Indexed log files are only opened for playing.
   * @param fileName the name of the file to open
   * @return if the reading was successful
   */
   bool open(const char* fileName);
 
+  /**
+  * Reads all messages of an opened indexed log file into the queue.
+  * Afterwards, the log file is closed. If a frame is corrupt, it and
+  * all frames following it are not read.
+  */
+  void loadIndexedLog();
+
   /** 
   * Playes the queue. 
   * Note that you have to call replay() regularely if you want to use that function
@@ -75,10 +86,12 @@ public:
 
   /**
   * Writes all messages in the log player queue to a log file.
+  * If the name ends with ".ilog", an indexed log file is written.
   * @param fileName the name of the file to write
+  * @param keyframeInterval the number of frames between two keyframes of an indexed log file, 0 for no delta compression
   * @return if the writing was successful
   */
-  bool save(const char* fileName);
+  bool save(const char* fileName, int keyframeInterval = 0);
 
   /**
   * Writes all images in the log player queue to a bunch of files (*.bmp or *.jpg).
@@ -130,17 +143,26 @@ public:
   LogPlayerState state; /**< The state of the log player. */
   int currentFrameNumber; /**< The number of the current frame. */
   int numberOfFrames; /**< The overall number of frames available. */
+  int corruptFrame; /**< The number of a frame that could not be read from an indexed log file or -1. Reset after it was reported. */
 
 private:
   MessageQueue& targetQueue; /**< The queue into that messages from played logfiles shall be stored. */
   int currentMessageNumber; /**< The current message number in the message queue. */
   int numberOfMessagesWithinCompleteFrames; /**< The number of messages within complete frames. Messages behind that number will be skipped. */
   bool loop;
+  IndexedLog indexedLog; /**< The indexed log file played. Only open if such a file was opened. */
 
   /**
   * The method counts the number of frames.
   */
   void countFrames();
+
+  /**
+  * The method copies the messages of the next frame to the target queue.
+  * If the frame cannot be read from an indexed log file, the replay is stopped.
+  * @return Was the frame copied?
+  */
+  bool nextFrame();
 };
 
 #endif //LogPlayer_h_
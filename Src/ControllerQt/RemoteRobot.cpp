@@ -27,7 +27,7 @@ timeStamp(0)
 
 void RemoteRobot::connect()
 {
-  TcpConnection::connect(*ip ? ip : 0, 0xA1BD, TcpConnection::sender);
+  TcpConnection::connect(*ip ? ip : 0, 0xA1BD, TcpConnection::sender, 0, 0, true);
 }
 
 void RemoteRobot::run()
@@ -19,6 +19,7 @@ TimeInfo::TimeInfo()
 void TimeInfo::reset()
 {
   infos.clear();
+  providerInfos.clear();
   timeStamp = 0;
 }
 
@@ -44,6 +45,21 @@ bool TimeInfo::handleMessage(InMessage& message)
     timeStamp = info.lastReceived = SystemCall::getCurrentSystemTime();
     return true;
   }
+  else if(message.getMessageID() == idModuleTimings)
+  {
+    unsigned short numOfEntries;
+    message.bin >> numOfEntries;
+    timeStamp = SystemCall::getCurrentSystemTime();
+    for(int i = 0; i < numOfEntries; ++i)
+    {
+      ModuleTimings::Entry entry;
+      message.bin >> entry;
+      ProviderInfo& info = providerInfos[entry.representation];
+      info.entry = entry;
+      info.lastReceived = timeStamp;
+    }
+    return true;
+  }
   else
     return false;
 }
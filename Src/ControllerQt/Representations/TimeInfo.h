@@ -10,6 +10,7 @@
 #define __TimeInfo_h_
 
 #include "Tools/RingBuffer.h"
+#include "Tools/Module/ModuleTimings.h"
 #include "Platform/hash_map.h"
 #include <string>
 
@@ -49,6 +50,17 @@ public:
 
   typedef stdext::hash_map<std::string, Info> Infos;
   Infos infos;
+
+  class ProviderInfo
+  {
+  public:
+    ModuleTimings::Entry entry; /**< The statistics of the provider. */
+    unsigned lastReceived; /**< When were the statistics received? */
+    ProviderInfo() : lastReceived(0) {}
+  };
+
+  typedef stdext::hash_map<std::string, ProviderInfo> ProviderInfos;
+  ProviderInfos providerInfos; /**< The statistics of all providers measured automatically. */
   unsigned int timeStamp; /**< The time stamp of the last change. */
 
   /**
@@ -57,9 +69,9 @@ public:
   TimeInfo();
 
   /**
-  * The function handles a stop watch message.
+  * The function handles a stop watch message or a message with module timings.
   * @param message The message.
-  * @return Was it a stop watch message?
+  * @return Was it a stop watch message or a message with module timings?
   */
   bool handleMessage(InMessage& message);
 
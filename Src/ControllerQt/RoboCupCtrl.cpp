@@ -18,7 +18,7 @@ RoboCupCtrl* RoboCupCtrl::controller = 0;
 
 std::string RoboCupCtrl::robotName;
 
-RoboCupCtrl::RoboCupCtrl() : simTime(false), dragTime(true), lastTime(0), joystickID(0)
+RoboCupCtrl::RoboCupCtrl() : simTime(false), dragTime(true), lockstep(false), seed(0), seedGeneration(0), lastTime(0), joystickID(0)
 {
   controller = this;
   time = 10000 - SystemCall::getRealSystemTime();
@@ -38,6 +38,15 @@ RoboCupCtrl::RoboCupCtrl() : simTime(false), dragTime(true), lastTime(0), joysti
     ball = 0;
   
   setGUIUpdateDelay(100);
+
+  // Without GUI, the simulation runs as fast as possible in simulation time that always starts at the same value.
+  if(isHeadless())
+  {
+    simTime = true;
+    dragTime = false;
+    lockstep = true;
+    time = 10000;
+  }
 }
 
 void RoboCupCtrl::start()
@@ -51,6 +60,7 @@ void RoboCupCtrl::start()
 
 void RoboCupCtrl::stop()
 {
+  setLockstep(false);
   for(std::list<Robot*>::iterator i = robots.begin(); i != robots.end(); ++i)
     (*i)->announceStop();
   if(!robots.empty())
@@ -77,19 +87,64 @@ void RoboCupCtrl::execute()
   }
 
   statusText = "";
+  // first, all robots announce their images, so they are rendered together
+  for(std::list<Robot*>::iterator i = robots.begin(); i != robots.end(); ++i)
+    (*i)->prepareUpdate();
   for(std::list<Robot*>::iterator i = robots.begin(); i != robots.end(); ++i)
     (*i)->update();
+
+  if(lockstep)
+  {
+    for(std::list<Robot*>::iterator i = robots.begin(); i != robots.end(); ++i)
+      (*i)->startTick();
+    for(std::list<Robot*>::iterator i = robots.begin(); i != robots.end(); ++i)
+      (*i)->waitForTick();
+    for(std::list<Robot*>::iterator i = robots.begin(); i != robots.end(); ++i)
+    {
+      std::list<std::string> packages;
+      (*i)->takeBroadcastPackages(packages);
+      for(std::list<std::string>::const_iterator j = packages.begin(); j != packages.end(); ++j)
+        deliverBroadcastPackage(j->data(), (unsigned) j->size());
+    }
+  }
+
   if(simTime)
     time += 20;
 }
 
-const char* RoboCupCtrl::getRobotName() const
+void RoboCupCtrl::setLockstep(bool lockstep)
+{
+  if(this->lockstep && !lockstep)
+  {
+    this->lockstep = false;
+    for(std::list<Robot*>::iterator i = robots.begin(); i != robots.end(); ++i)
+      (*i)->releaseProcesses();
+  }
+  else
+    this->lockstep = lockstep;
+}
+
+void RoboCupCtrl::setRandomSeed(unsigned seed)
+{
+  this->seed = seed;
+  ++seedGeneration;
+}
+
+Robot* RoboCupCtrl::getCurrentRobot() const
 {
   unsigned threadId = Thread<ProcessBase>::getCurrentId();
   for(std::list<Robot*>::const_iterator i = robots.begin(); i != robots.end(); ++i)
     for(ProcessList::const_iterator j = (*i)->begin(); j != (*i)->end(); ++j)
       if((*j)->getId() == threadId)
-        return (*i)->getName();
+        return *i;
+  return 0;
+}
+
+const char* RoboCupCtrl::getRobotName() const
+{
+  const Robot* robot = getCurrentRobot();
+  if(robot)
+    return robot->getName();
   return obj ? obj->getName().c_str() : "Robot1";
 }
 
@@ -107,6 +162,15 @@ unsigned RoboCupCtrl::getTime() const
 }
 
 void RoboCupCtrl::broadcastPackage(const char* package, unsigned size)
+{
+  Robot* robot = lockstep ? getCurrentRobot() : 0;
+  if(robot)
+    robot->queueBroadcastPackage(package, size);
+  else
+    deliverBroadcastPackage(package, size);
+}
+
+void RoboCupCtrl::deliverBroadcastPackage(const char* package, unsigned size)
 {
   for(std::list<Robot*>::const_iterator i = robots.begin(); i != robots.end(); ++i)
     if((*i)->listensForBroadcastPackages())
@@ -29,6 +29,9 @@ protected:
   SimObject* obj; /**< The current robot constructed. */
   bool simTime; /**< Switches between simulation time mode and real time mode. */
   bool dragTime; /**< Drag simulation to avoid running faster then realtime. */
+  bool lockstep; /**< Do the processes of all robots execute their frames in lockstep with the simulation? */
+  unsigned seed; /**< The seed that is mixed into the random number generators of all processes. */
+  unsigned seedGeneration; /**< Counts how often the seed was set. */
   int time; /**< The simulation time. */
   unsigned lastTime; /**< The last time execute was called. */
   std::string statusText; /**< The text to be printed in the status bar. */
@@ -44,6 +47,30 @@ protected:
   */
   void stop();
 
+  /**
+  * The function switches the lockstep mode on or off. In lockstep mode, each
+  * simulation step is a tick in which the processes of all robots check for
+  * events and execute their frames. The robots run in parallel, but the
+  * simulation only continues when all of them finished the tick. Broadcast
+  * packages are delivered in the order of the robots after each tick.
+  * Together with the simulation time, this makes the simulation deterministic.
+  * @param lockstep Switch the mode on?
+  */
+  void setLockstep(bool lockstep);
+
+  /**
+  * The function returns the robot the current thread belongs to.
+  * @return The robot or 0 if the thread is not a process of a robot.
+  */
+  Robot* getCurrentRobot() const;
+
+  /**
+  * The method delivers a package to all robots that listen for broadcasts.
+  * @param package The package. It will not be freed.
+  * @param size The size of the package.
+  */
+  void deliverBroadcastPackage(const char* package, unsigned size);
+
 public:
   /**
   * Constructor.
@@ -85,8 +112,34 @@ public:
   */
   unsigned getTime() const;
 
+  /**
+  * The function returns whether the processes run in lockstep with the simulation.
+  * @return Is the lockstep mode active?
+  */
+  bool isLockstep() const {return lockstep;}
+
+  /**
+  * The function sets the seed of the random number generators of all processes.
+  * The processes are seeded again at the beginning of the next tick in lockstep mode.
+  * @param seed The seed.
+  */
+  void setRandomSeed(unsigned seed);
+
+  /**
+  * The function returns the seed of the random number generators of all processes.
+  * @return The seed.
+  */
+  unsigned getRandomSeed() const {return seed;}
+
+  /**
+  * The function returns how often the seed was set.
+  * @return The number of calls of setRandomSeed().
+  */
+  unsigned getSeedGeneration() const {return seedGeneration;}
+
   /**
   * The method broadcasts a package to all robots.
+  * In lockstep mode, it is delivered after the current tick.
   * @param package The package. It will not be freed.
   * @param size The size of the package.
   */
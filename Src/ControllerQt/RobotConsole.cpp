@@ -62,6 +62,7 @@ RobotConsole::RobotConsole(MessageQueue& in, MessageQueue& out)
   updateCompletion(false),
   directMode(false),
   logImagesAsJPEGs(false),
+  jpegEncoder(4),
   joystickTrace(false),
   joystickLastTime(0),
   joystickID(-1),
@@ -185,7 +186,7 @@ bool RobotConsole::handleMessage(InMessage& message)
       Image image;
       message.bin >> image;
       MessageQueue queue;
-      queue.out.bin << JPEGImage(image);
+      queue.out.bin << JPEGImage(image, jpegEncoder);
       queue.out.finishMessage(idJPEGImage);
       logPlayer.handleMessage(queue.in);
     }
@@ -225,7 +226,7 @@ bool RobotConsole::handleMessage(InMessage& message)
         incompleteImages["raw image"].image = new Image;
       JPEGImage jpi;
       message.bin >> jpi;
-      jpi.toImage(*incompleteImages["raw image"].image);
+      jpi.toImage(*incompleteImages["raw image"].image, jpegDecoder);
       return true;
     }
     case idDebugImage:
@@ -246,7 +247,7 @@ bool RobotConsole::handleMessage(InMessage& message)
         incompleteImages[id].image = new Image;
       JPEGImage jpi;
       message.bin >> jpi;
-      jpi.toImage(*incompleteImages[id].image);
+      jpi.toImage(*incompleteImages[id].image, jpegDecoder);
       incompleteImages[id].image->timeStamp = SystemCall::getCurrentSystemTime();
       break;
     }
@@ -479,6 +480,7 @@ bool RobotConsole::handleMessage(InMessage& message)
         return xabslInfo.handleMessage(message);
       }
     case idStopwatch:
+    case idModuleTimings:
       return timeInfo.handleMessage(message);
     case idDebugResponse:
       {
@@ -563,15 +565,23 @@ bool RobotConsole::handleMessage(InMessage& message)
       logAcknowledged = true;
       return true;
     case idTeamMateRobotPose:
-      message.bin >> robotPose;
+    {
+      RobotPoseCompressed robotPoseCompressed;
+      message.bin >> robotPoseCompressed;
+      robotPose = robotPoseCompressed;
       robotPoseReceived = SystemCall::getCurrentSystemTime();
       return true;
+    }
     case idTeamMateBallModel:
-      message.bin >> ballModel;
+    {
+      BallModelCompressed ballModelCompressed;
+      message.bin >> ballModelCompressed;
+      ballModel = ballModelCompressed;
       if(ballModel.timeWhenLastSeen)
         ballModel.timeWhenLastSeen = ctrl->ntp.getTeamMateTimeInOwnTime(ballModel.timeWhenLastSeen, ((TeamRobot*) this)->getNumber());
       ballModelReceived = SystemCall::getCurrentSystemTime();
       return true;
+    }
     case idTeamMateGoalPercept:
       message.bin >> goalPercept;
       if(goalPercept.timeWhenOppGoalLastSeen)
@@ -651,6 +661,17 @@ void RobotConsole::update()
 
   pollForDirectMode();
 
+  {
+    SYNC;
+    if(logPlayer.corruptFrame != -1)
+    {
+      char buf[33];
+      ctrl->printLn(std::string("Error: frame ") + itoa_s(logPlayer.corruptFrame, buf, sizeof(buf), 10) +
+                    " of the log file is corrupt. Replay stopped.");
+      logPlayer.corruptFrame = -1;
+    }
+  }
+
   if(updateCompletion)
   {
     SYNC;
@@ -1043,7 +1064,10 @@ bool RobotConsole::calcImage(InConfigMemory& stream)
   }
   else if(state == "on")
   {
-    calculateImage = true;
+    if(ctrl->isHeadless())
+      ctrl->printLn("Images cannot be calculated without GUI.");
+    else
+      calculateImage = true;
     return true;
   }
   return false;
@@ -1392,9 +1416,11 @@ bool RobotConsole::log(InConfigMemory& stream)
   }
   else if(command == "save")
   {
-    std::string name;
-    stream >> name;
-    if(name.size() == 0)
+    std::string name,
+                interval;
+    stream >> name >> interval;
+    const int keyframeInterval = atoi(interval.c_str());
+    if(name.size() == 0 || keyframeInterval < 0)
       return false;
     else 
     {
@@ -1402,7 +1428,24 @@ bool RobotConsole::log(InConfigMemory& stream)
         name = name + ".log";
       if(name[0] != '/' && name[0] != '\\' && (name.size() < 2 || name[1] != ':'))
         name = std::string("Logs\\") + name;
-      return logPlayer.save(name.c_str());
+      return logPlayer.save(name.c_str(), keyframeInterval);
+    }
+  }
+  else if(command == "index")
+  {
+    std::string name,
+                interval;
+    stream >> name >> interval;
+    const int keyframeInterval = atoi(interval.c_str());
+    if(name.size() == 0 || keyframeInterval < 0)
+      return false;
+    else 
+    {
+      if((int) name.rfind('.') <= (int) name.find_last_of("\\/"))
+        name = name + ".log";
+      if(name[0] != '/' && name[0] != '\\' && (name.size() < 2 || name[1] != ':'))
+        name = std::string("Logs\\") + name;
+      return IndexedLog::convert(name, name.substr(0, name.rfind('.')) + ".ilog", keyframeInterval);
     }
   }
   else if(command == "saveImages")
@@ -1462,10 +1505,14 @@ bool RobotConsole::log(InConfigMemory& stream)
     int frequency[numOfMessageIDs];
     logPlayer.statistics(frequency);
     char buf[20];
+    int total = 0;
     for(int i = 0; i < numOfDataMessageIDs; ++i)
       if(frequency[i])
+      {
         ctrl->printLn(std::string(itoa_s(frequency[i], buf, sizeof(buf), 10)) + "\t" + getMessageIDName(MessageID(i)));
-    ctrl->printLn(std::string(itoa_s(logPlayer.getNumberOfMessages(), buf, sizeof(buf), 10)) + "\ttotal");
+        total += frequency[i];
+      }
+    ctrl->printLn(std::string(itoa_s(total, buf, sizeof(buf), 10)) + "\ttotal");
     return true;
   }
   else if(logFile != "")
@@ -1478,10 +1525,11 @@ bool RobotConsole::log(InConfigMemory& stream)
         return false;
       else 
       {
-        if((int) name.rfind('.') <= (int) name.find_last_of("\\/"))
-          name = name + ".log";
+        bool hasExtension = (int) name.rfind('.') > (int) name.find_last_of("\\/");
         if(name[0] != '/' && name[0] != '\\' && (name.size() < 2 || name[1] != ':'))
           name = std::string("Logs\\") + name;
+        if(!hasExtension) // prefer the indexed version of a log file
+          name = name + (InBinaryFile(name + ".ilog").exists() ? ".ilog" : ".log");
         logFile = name;
         LogPlayer::LogPlayerState state = logPlayer.state;
         bool result = logPlayer.open(name.c_str());
@@ -1535,6 +1583,7 @@ bool RobotConsole::log(InConfigMemory& stream)
       MessageQueue temp;
       Converter converter(temp);
       logPlayer.stop();
+      logPlayer.loadIndexedLog();
       logPlayer.handleAllMessages(converter);
       logPlayer.clear();
       temp.moveAllMessages(logPlayer);
@@ -30,6 +30,7 @@
 #include "Representations/Configuration/ColorTable64.h"
 #include "LogPlayer.h"
 #include "Tools/Debugging/DebugImages.h"
+#include "Tools/ImageProcessing/JPEGCodec.h"
 #include "Tools/Debugging/DebugDrawings3D.h"
 #include "Visualization/DebugDrawing.h"
 #include "Visualization/DebugDrawing3D.h"
@@ -238,6 +239,8 @@ private:
   bool updateCompletion, /**< Determines whether the tab-completion table has to be updated. */
        directMode, /**< Console is in direct mode, not replaying a script. */
        logImagesAsJPEGs; /**< Compress images before they are stored in a log file. */
+  JPEGEncoder jpegEncoder; /**< The encoder used to compress images that are logged. It uses several threads. */
+  JPEGDecoder jpegDecoder; /**< The decoder used to uncompress images received. */
 
   //Joystick
   static const int joystickAxisNumber = 6; /**< Max number of supported axis. */
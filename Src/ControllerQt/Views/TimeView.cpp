@@ -52,6 +52,7 @@ public:
     paintRectField4 = QRect(headerView->sectionViewportPosition(4) + textOffset, 0, headerView->sectionSize(4) - textOffset * 2, lineSpacing);
     paintRectField5 = QRect(headerView->sectionViewportPosition(5) + textOffset, 0, headerView->sectionSize(5) - textOffset * 2, lineSpacing);
     paintRectField6 = QRect(headerView->sectionViewportPosition(6) + textOffset, 0, headerView->sectionSize(6) - textOffset * 2, lineSpacing);
+    paintRectField7 = QRect(headerView->sectionViewportPosition(7) + textOffset, 0, headerView->sectionSize(7) - textOffset * 2, lineSpacing);
     {
       SYNC_WITH(console);
       
@@ -67,10 +68,24 @@ public:
           sprintf(fminDelta, "%.02f", minDelta);
           sprintf(fmaxDelta, "%.02f", maxDelta);
           sprintf(favgFreq, "%.02f", avgFreq);
-          print(i->first.c_str(), fminTime, fmaxTime, favgTime, fminDelta, fmaxDelta, favgFreq);
+          print(i->first.c_str(), fminTime, fmaxTime, favgTime, fminDelta, fmaxDelta, favgFreq, "");
           newBlock();
         }
       }
+
+      // the statistics of all providers that were measured automatically
+      for(TimeInfo::ProviderInfos::const_iterator i = info.providerInfos.begin(), end = info.providerInfos.end(); i != end; ++i)
+        if(SystemCall::getTimeSince(i->second.lastReceived) < 3000)
+        {
+          const ModuleTimings::Entry& entry = i->second.entry;
+          char fminTime[100], fmaxTime[100], favgTime[100], fp99Time[100];
+          sprintf(fminTime, "%.02f", entry.minTime / 1000.);
+          sprintf(fmaxTime, "%.02f", entry.maxTime / 1000.);
+          sprintf(favgTime, "%.02f", entry.avgTime / 1000.);
+          sprintf(fp99Time, "%.02f", entry.p99Time / 1000.);
+          print(entry.representation.c_str(), fminTime, fmaxTime, favgTime, "", "", "", fp99Time);
+          newBlock();
+        }
     }
     painter.end();
     setMinimumHeight(paintRectField1.top());
@@ -99,8 +114,9 @@ private:
   QRect paintRectField4;
   QRect paintRectField5;
   QRect paintRectField6;
+  QRect paintRectField7;
 
-  void print(const char* name, const char* value1, const char* value2, const char* value3, const char* value4, const char* value5, const char* value6)
+  void print(const char* name, const char* value1, const char* value2, const char* value3, const char* value4, const char* value5, const char* value6, const char* value7)
   {
     if(fillBackground)
     {
@@ -115,6 +131,7 @@ private:
     painter.drawText(paintRectField4, Qt::TextSingleLine | Qt::AlignVCenter, value4);
     painter.drawText(paintRectField5, Qt::TextSingleLine | Qt::AlignVCenter, value5);
     painter.drawText(paintRectField6, Qt::TextSingleLine | Qt::AlignVCenter, value6);
+    painter.drawText(paintRectField7, Qt::TextSingleLine | Qt::AlignVCenter, value7);
     paintRectField0.moveTop(paintRectField0.top() + lineSpacing);
     paintRectField1.moveTop(paintRectField1.top() + lineSpacing);
     paintRectField2.moveTop(paintRectField2.top() + lineSpacing);
@@ -122,6 +139,7 @@ private:
     paintRectField4.moveTop(paintRectField4.top() + lineSpacing);
     paintRectField5.moveTop(paintRectField5.top() + lineSpacing);
     paintRectField6.moveTop(paintRectField6.top() + lineSpacing);
+    paintRectField7.moveTop(paintRectField7.top() + lineSpacing);
   }
   
   void newBlock()
@@ -138,8 +156,8 @@ QWidget* TimeView::createWidget()
 {
   HeaderedWidget* widget = new HeaderedWidget();
   QStringList headerLabels;
-  headerLabels << "Module" << "Min" << "Max" << "Avg" << "MinDelta" << "MaxDelta" << "AvgFreq";
-  widget->setHeaderLabels(headerLabels, "lrrrrrr");
+  headerLabels << "Module" << "Min" << "Max" << "Avg" << "MinDelta" << "MaxDelta" << "AvgFreq" << "P99";
+  widget->setHeaderLabels(headerLabels, "lrrrrrrr");
   QHeaderView* headerView = widget->getHeaderView();
   timeWidget = new TimeWidget(console, info, headerView, widget);
   widget->setWidget(timeWidget);  
@@ -151,6 +169,7 @@ QWidget* TimeView::createWidget()
   headerView->resizeSection(4, 50);
   headerView->resizeSection(5, 50);
   headerView->resizeSection(6, 50);
+  headerView->resizeSection(7, 50);
   return widget; 
 }
 
@@ -117,7 +117,7 @@ double MathSymbols::getCos()
 
 double MathSymbols::getRandom()
 {
-  return ((double) rand() / (RAND_MAX+1.0));
+  return ((double) randomInt() / (RAND_MAX+1.0));
 }
 
 double MathSymbols::getNormalize()
@@ -17,6 +17,7 @@
 #include "Infrastructure/SoundControl.h"
 #include "Perception/CameraMatrixProvider.h"
 #include "Perception/CoordinateSystemProvider.h"
+#include "Perception/ColorClassPlaneProvider.h"
 #include "Perception/Regionizer.h"
 #include "Perception/RegionAnalyzer.h"
 #include "Perception/BallPerceptor.h"
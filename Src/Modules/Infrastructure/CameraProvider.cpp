@@ -37,7 +37,7 @@ void CameraProvider::update(Image& image)
     camera->setSettings(theCameraSettings);
   }
 #endif
-  DEBUG_RESPONSE("representation:JPEGImage", OUTPUT(idJPEGImage, bin, JPEGImage(image)); );
+  DEBUG_RESPONSE("representation:JPEGImage", OUTPUT(idJPEGImage, bin, JPEGImage(image, jpegEncoder)); );
 }
 
 void CameraProvider::update(FrameInfo& frameInfo)
@@ -11,6 +11,7 @@
 #include "Representations/Configuration/CameraSettings.h"
 #include "Representations/Infrastructure/Image.h"
 #include "Representations/Infrastructure/FrameInfo.h"
+#include "Tools/ImageProcessing/JPEGCodec.h"
 
 class Camera;
 
@@ -29,6 +30,7 @@ private:
   PROCESS_WIDE_STORAGE_STATIC CameraProvider* theInstance; /**< Points to the only instance of this class in this process or is 0 if there is none. */
 
   Camera* camera;
+  JPEGEncoder jpegEncoder; /**< The encoder used to send JPEG images. */
 
   void update(Image& image);
   void update(CameraInfo& cameraInfo) {} // nothing to do here
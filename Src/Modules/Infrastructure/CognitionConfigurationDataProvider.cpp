@@ -15,7 +15,8 @@ theColorTable64(0),
 theCameraSettings(0),
 theCameraCalibration(0),
 theRobotDimensions(0),
-theBehaviorConfiguration(0){
+theBehaviorConfiguration(0),
+changedColorTable64(0){
   theInstance = this;
 
   readFieldDimensions();
@@ -61,6 +62,16 @@ void CognitionConfigurationDataProvider::update(ColorTable64& colorTable64)
     colorTable64 = *theColorTable64;
     delete theColorTable64;
     theColorTable64 = 0;
+    changedColorTable64 = &colorTable64;
+  }
+}
+
+void CognitionConfigurationDataProvider::update(CompactColorTable64& compactColorTable64)
+{
+  if(changedColorTable64)
+  {
+    compactColorTable64.fromColorTable(*changedColorTable64);
+    changedColorTable64 = 0;
   }
 }
 
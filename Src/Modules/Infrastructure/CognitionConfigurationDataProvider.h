@@ -12,6 +12,7 @@
 #include "Representations/Configuration/RobotName.h"
 #include "Representations/Configuration/FieldDimensions.h"
 #include "Representations/Configuration/ColorTable64.h"
+#include "Representations/Configuration/CompactColorTable64.h"
 #include "Representations/Configuration/CameraSettings.h"
 #include "Representations/Configuration/CameraCalibration.h"
 #include "Representations/Configuration/RobotDimensions.h"
@@ -21,6 +22,8 @@ MODULE(CognitionConfigurationDataProvider)
   REQUIRES(RobotName)
   PROVIDES_WITH_DRAW(FieldDimensions)
   PROVIDES_WITH_OUTPUT(ColorTable64)
+  REQUIRES(ColorTable64)
+  PROVIDES(CompactColorTable64)
   PROVIDES_WITH_MODIFY(CameraSettings)
   PROVIDES_WITH_MODIFY(CameraCalibration)
   PROVIDES_WITH_MODIFY(RobotDimensions)
@@ -44,9 +47,11 @@ private:
        loadedCameraCalibration,
        loadedRobotDimensions,
        loadedBehaviorConfiguration;
+  const ColorTable64* changedColorTable64; /**< The color table in the blackboard if it was changed in this frame, otherwise 0. */
 
   void update(FieldDimensions& fieldDimensions);
   void update(ColorTable64& colorTable64);
+  void update(CompactColorTable64& compactColorTable64);
   void update(CameraSettings& cameraSettings);
   void update(CameraCalibration& cameraCalibration);
   void update(RobotDimensions& robotDimensions);
@@ -60,7 +60,7 @@ CognitionLogDataProvider::~CognitionLogDataProvider()
 }
 
 UPDATE2(BallModel,
-  TEAM_OUTPUT(idTeamMateBallModel, bin, _BallModel);
+  TEAM_OUTPUT(idTeamMateBallModel, bin, BallModelCompressed(_BallModel));
 )
 UPDATE(BallPercept)
 UPDATE(CameraMatrix)
@@ -75,7 +75,7 @@ UPDATE2(Image,
           distance * _Image.cameraInfo.resolutionWidth / _Image.cameraInfo.focalLength,
           distance * _Image.cameraInfo.resolutionHeight / _Image.cameraInfo.focalLength,
           _Image);
-  DEBUG_RESPONSE("representation:JPEGImage", OUTPUT(idJPEGImage, bin, JPEGImage(_Image)); );
+  DEBUG_RESPONSE("representation:JPEGImage", OUTPUT(idJPEGImage, bin, JPEGImage(_Image, jpegEncoder)); );
 )
 UPDATE2(ImageCoordinateSystem, 
   DECLARE_DEBUG_DRAWING("loggedHorizon", "drawingOnImage"); // displays the horizon
@@ -118,7 +118,7 @@ UPDATE2(ImageCoordinateSystem,
   );
 )
 UPDATE(LinePercept)
-UPDATE2(RobotPose, TEAM_OUTPUT(idTeamMateRobotPose, bin, _RobotPose); )
+UPDATE2(RobotPose, TEAM_OUTPUT(idTeamMateRobotPose, bin, RobotPoseCompressed(_RobotPose)); )
 
 
 bool CognitionLogDataProvider::handleMessage(InMessage& message)
@@ -168,7 +168,7 @@ bool CognitionLogDataProvider::handleMessage2(InMessage& message)
     {
       JPEGImage jpegImage;
       message.bin >> jpegImage;
-      jpegImage.toImage((Image&) *representationBuffer[idImage]);
+      jpegImage.toImage((Image&) *representationBuffer[idImage], jpegDecoder);
     }
     ALLOC(FrameInfo)
     ((FrameInfo&) *representationBuffer[idFrameInfo]).time = ((Image&) *representationBuffer[idImage]).timeStamp;
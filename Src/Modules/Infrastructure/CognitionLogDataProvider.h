@@ -19,6 +19,7 @@
 #include "Representations/Modeling/BallModel.h"
 #include "Tools/MessageQueue/InMessage.h"
 #include "Tools/Debugging/DebugImages.h"
+#include "Tools/ImageProcessing/JPEGCodec.h"
 
 MODULE(CognitionLogDataProvider)
   PROVIDES_WITH_OUTPUT(Image)
@@ -42,6 +43,8 @@ private:
   PROCESS_WIDE_STORAGE_STATIC CognitionLogDataProvider* theInstance; /**< Points to the only instance of this class in this process or is 0 if there is none. */
   bool frameDataComplete; /**< Were all messages of the current frame received? */
   Streamable* representationBuffer[numOfDataMessageIDs]; /**< The array of all logable representations. */
+  JPEGEncoder jpegEncoder; /**< The encoder used to send JPEG images. */
+  JPEGDecoder jpegDecoder; /**< The decoder used to replay JPEG images. */
 
   DECLARE_DEBUG_IMAGE(corrected);
   
@@ -7,6 +7,7 @@
 #include "TeamDataProvider.h"
 #include "Tools/Settings.h"
 #include "Tools/Team.h"
+#include "Tools/CRC.h"
 #include "Tools/Debugging/ReleaseOptions.h"
 
 PROCESS_WIDE_STORAGE TeamDataProvider* TeamDataProvider::theInstance = 0;
@@ -50,6 +51,8 @@ void TeamDataProvider::update(TeamMateData& teamMateData)
                              theGroundContactState.contact;
   if(teamMateData.sendThisFrame)
     lastSentTimeStamp = theFrameInfo.time;
+
+  DEBUG_RESPONSE("module:TeamDataProvider:crcBenchmark", CRC::benchmark(););
 }
 
 void TeamDataProvider::update(GroundTruthRobotPose& groundTruthRobotPose)
@@ -100,8 +103,10 @@ bool TeamDataProvider::handleMessage(InMessage& message)
     if(robotNumber != theRobotInfo.number) 
       if(robotNumber >= TeamMateData::firstPlayer && robotNumber < TeamMateData::numOfPlayers)
       {
+        BallModelCompressed ballModelCompressed;
+        message.bin >> ballModelCompressed;
         BallModel& ballModel = theTeamMateData.ballModels[robotNumber];
-        message.bin >> ballModel;
+        ballModel = ballModelCompressed;
 
         if(ballModel.timeWhenLastSeen)
           ballModel.timeWhenLastSeen = ntp.getTeamMateTimeInOwnTime(ballModel.timeWhenLastSeen, robotNumber);
@@ -111,7 +116,11 @@ bool TeamDataProvider::handleMessage(InMessage& message)
   case idTeamMateRobotPose:
     if(robotNumber != theRobotInfo.number) 
       if(robotNumber >= TeamMateData::firstPlayer && robotNumber < TeamMateData::numOfPlayers)
-        message.bin >> theTeamMateData.robotPoses[robotNumber];
+      {
+        RobotPoseCompressed robotPose;
+        message.bin >> robotPose;
+        theTeamMateData.robotPoses[robotNumber] = robotPose;
+      }
     return true;
 
   case idTeamMateBehaviorData:
@@ -74,21 +74,18 @@ void WhiteCorrection::update(CameraSettings& cameraSettings)
 double WhiteCorrection::averageYCbCrDifferenceOfCurrentImage() const
 {
   // We take 19*19 pixels, thus we divide the image in 20x20 areas
-  int colSkip(theImage.cameraInfo.resolutionWidth * 2 / 20);
-  int lineSkip(colSkip*10*theImage.cameraInfo.resolutionHeight/20);
+  const int width(theImage.cameraInfo.resolutionWidth);
+  const int height(theImage.cameraInfo.resolutionHeight);
   int ySum(0), cbSum(0), crSum(0);
-  Image::Pixel* address = &(theImage.image[0][0]);
-  address += lineSkip + colSkip;
-  for(int y=0; y<19; ++y)
+  for(int y=1; y<20; ++y)
   {
-    for(int x=0; x<19; ++x)
+    for(int x=1; x<20; ++x)
     {
-      ySum += address->y;
-      cbSum += address->cb;
-      crSum += address->cr;
-      address += colSkip;
+      const Image::Pixel& pixel = theImage.image[y * height / 20][x * width / 20];
+      ySum += pixel.y;
+      cbSum += pixel.cb;
+      crSum += pixel.cr;
     }
-    address += lineSkip + colSkip;
   }
   double yDiff = fabs(255.0 - (static_cast<double>(ySum) / (19.0*19.0)));
   double cbDiff = fabs(128.0 - (static_cast<double>(cbSum) / (19.0*19.0)));
@@ -99,19 +96,18 @@ double WhiteCorrection::averageYCbCrDifferenceOfCurrentImage() const
 void WhiteCorrection::printColorValues() const
 {
   // We take 19*19 pixels, thus we divide the image in 20x20 areas
-  int colSkip(theImage.cameraInfo.resolutionWidth * 2 / 20);
-  int lineSkip(colSkip*10*theImage.cameraInfo.resolutionHeight/20);
+  const int width(theImage.cameraInfo.resolutionWidth);
+  const int height(theImage.cameraInfo.resolutionHeight);
   int rSum(0), gSum(0), bSum(0);
   int ySum(0), cbSum(0), crSum(0);
-  Image::Pixel* address = &(theImage.image[0][0]);
-  address += lineSkip + colSkip;
-  for(int y=0; y<19; ++y)
+  for(int y=1; y<20; ++y)
   { 
-    for(int x=0; x<19; ++x)
+    for(int x=1; x<20; ++x)
     { 
-      unsigned char Y = address->y;
-      unsigned char cb = address->cb;
-      unsigned char cr = address->cr;
+      const Image::Pixel& pixel = theImage.image[y * height / 20][x * width / 20];
+      unsigned char Y = pixel.y;
+      unsigned char cb = pixel.cb;
+      unsigned char cr = pixel.cr;
       int r = Y + ((1436 * (cr - 128)) >> 10),
           g = Y - ((354 * (cb - 128) + 732 * (cr - 128)) >> 10),
           b = Y + ((1814 * (cb - 128)) >> 10);
@@ -124,9 +120,7 @@ void WhiteCorrection::printColorValues() const
       rSum += r;
       gSum += g;
       bSum += b;
-      address += colSkip;
     }
-    address += lineSkip + colSkip;
   }
   double RGDiff = fabs(static_cast<double>(rSum) - static_cast<double>(gSum)) / (19.0*19.0);
   double RBDiff = fabs(static_cast<double>(rSum) - static_cast<double>(bSum)) / (19.0*19.0);
@@ -46,7 +46,7 @@ void SSLVision::update(RobotPose& robotPose)
 {
   update((GroundTruthRobotPose&) robotPose);
 
-  TEAM_OUTPUT(idTeamMateRobotPose, bin, robotPose);
+  TEAM_OUTPUT(idTeamMateRobotPose, bin, RobotPoseCompressed(robotPose));
 }
 
 
@@ -16,13 +16,18 @@
 
 
 ObstacleModelProvider::ObstacleModelProvider():
+cosRotation(1),
+sinRotation(0),
 lastTimePenalized(0),
 lastLeftMeasurement(parameters.maxValidUSDist),
 lastRightMeasurement(parameters.maxValidUSDist),
 lastLeftMeasurementTime(0),
 lastRightMeasurementTime(0),
+sectorsWidth(0),
+sectorsHeight(0),
 polygonsComputed(false)
 {
+  activeCells.reserve(CELLS_X*CELLS_Y);
   InConfigFile stream(Global::getSettings().expandLocationFilename("obstacleModel.cfg"));
   if(stream.exists())
   {
@@ -32,16 +37,20 @@ polygonsComputed(false)
 
 void ObstacleModelProvider::init()
 {
-  lastOdometry = theOdometryData;
+  origin = Vector2<int>(static_cast<int>(floor(theOdometryData.translation.x / CELL_SIZE)) - CELLS_X / 2,
+                        static_cast<int>(floor(theOdometryData.translation.y / CELL_SIZE)) - CELLS_Y / 2);
   for(int i=0; i<CELLS_X*CELLS_Y; ++i)
   {
-    cells[i].state = Cell::FREE;
+    cells[i] = Cell();
   }
+  activeCells.clear();
 }
 
 void ObstacleModelProvider::update(ObstacleModel& obstacleModel)
 {
   MODIFY("parameters:ObstacleModelProvider", parameters);
+  cosRotation = cos(theOdometryData.rotation);
+  sinRotation = sin(theOdometryData.rotation);
   ageCellState();
   if((theRobotInfo.penalty == PENALTY_NONE) &&
      (theMotionRequest.motion != MotionRequest::specialAction) && 
@@ -62,7 +71,6 @@ void ObstacleModelProvider::update(ObstacleModel& obstacleModel)
 
 void ObstacleModelProvider::computeModel(ObstacleModel& obstacleModel)
 {
-  const int numOfCells(CELLS_X*CELLS_Y);
   if(!polygonsComputed)
   {
     leftPoly[0]  = Vector2<double>(0,100);
@@ -91,72 +99,104 @@ void ObstacleModelProvider::computeModel(ObstacleModel& obstacleModel)
     centerRightPoly[3] = Vector2<double>(obstacleModel.maxValidDist,0);
     centerRightPoly[3].rotate(obstacleModel.centerRightAngle);
     centerRightPoly[3] += centerRightPoly[0];
+    computeSectors();
     polygonsComputed = true;
   }
-  obstacleModel.distanceToCenterLeftObstacle = obstacleModel.maxValidDist + 1;
-  obstacleModel.distanceToCenterRightObstacle = obstacleModel.maxValidDist + 1;
-  obstacleModel.distanceToLeftObstacle = obstacleModel.maxValidDist + 1;
-  obstacleModel.distanceToRightObstacle = obstacleModel.maxValidDist + 1;
-  
-  for(int i=0; i<numOfCells; ++i)
+
+  // The distances are compared squared. Only the minima are converted.
+  const double maxDist(obstacleModel.maxValidDist + 1);
+  const Vector2<double> sectorBases[numOfSectors] = 
+    {Vector2<double>(), leftPoly[0], rightPoly[0], Vector2<double>(), Vector2<double>()};
+  double minSquaredDists[numOfSectors];
+  for(int i=0; i<numOfSectors; ++i)
+    minSquaredDists[i] = maxDist * maxDist;
+
+  for(std::vector<int>::const_iterator i = activeCells.begin(); i != activeCells.end(); ++i)
   {
-    if(cells[i].state >= parameters.cellOccupiedThreshold)
+    if(cells[*i].state >= parameters.cellOccupiedThreshold)
     {
-      Vector2<int> p = gridToWorld(Vector2<int>(i % CELLS_Y, i / CELLS_Y));
+      const Vector2<double> p = gridToWorld(Vector2<int>(((*i % CELLS_X) - origin.x) & (CELLS_X - 1), 
+                                                         ((*i / CELLS_X) - origin.y) & (CELLS_Y - 1)));
       CIRCLE("module:ObstacleModelProvider:backprojection",p.x,p.y,50,10,
         Drawings::ps_solid, ColorRGBA(255,0,0), Drawings::bs_null, ColorRGBA(255,0,0));
-      Vector2<double> pDouble(p.x,p.y);
-      
-      if(Geometry::isPointInsideConvexPolygon(leftPoly, 3, pDouble))
+      const Sector sector = getSector(p);
+      if(sector != NO_SECTOR)
       {
-        const double dist = (pDouble - leftPoly[0]).abs();
-        if(dist < obstacleModel.distanceToLeftObstacle)
-          obstacleModel.distanceToLeftObstacle = dist;
-      }
-      else if(Geometry::isPointInsideConvexPolygon(rightPoly, 3, pDouble))
-      {
-        const double dist = (pDouble - rightPoly[0]).abs();
-        if(dist < obstacleModel.distanceToRightObstacle)
-          obstacleModel.distanceToRightObstacle = dist;
-      }
-      else if(Geometry::isPointInsideConvexPolygon(centerLeftPoly, 4, pDouble))
-      {
-        const double dist = pDouble.abs();
-        if(dist < obstacleModel.distanceToCenterLeftObstacle)
-          obstacleModel.distanceToCenterLeftObstacle = dist;
-      }
-      else if(Geometry::isPointInsideConvexPolygon(centerRightPoly, 4, pDouble))
-      {
-        const double dist = pDouble.abs();
-        if(dist < obstacleModel.distanceToCenterRightObstacle)
-          obstacleModel.distanceToCenterRightObstacle = dist;
+        const double squaredDist = (p - sectorBases[sector]).squareAbs();
+        if(squaredDist < minSquaredDists[sector])
+          minSquaredDists[sector] = squaredDist;
       }
     }
   }
+
+  obstacleModel.distanceToLeftObstacle = minSquaredDists[LEFT] < maxDist * maxDist ? sqrt(minSquaredDists[LEFT]) : maxDist;
+  obstacleModel.distanceToRightObstacle = minSquaredDists[RIGHT] < maxDist * maxDist ? sqrt(minSquaredDists[RIGHT]) : maxDist;
+  obstacleModel.distanceToCenterLeftObstacle = minSquaredDists[CENTER_LEFT] < maxDist * maxDist ? sqrt(minSquaredDists[CENTER_LEFT]) : maxDist;
+  obstacleModel.distanceToCenterRightObstacle = minSquaredDists[CENTER_RIGHT] < maxDist * maxDist ? sqrt(minSquaredDists[CENTER_RIGHT]) : maxDist;
+}
+
+void ObstacleModelProvider::computeSectors()
+{
+  // Bounding box of all polygons:
+  const Vector2<double>* polygons[4] = {leftPoly, rightPoly, centerLeftPoly, centerRightPoly};
+  const int numOfPoints[4] = {3, 3, 4, 4};
+  Vector2<double> minPoint(leftPoly[0]), maxPoint(leftPoly[0]);
+  for(int i=0; i<4; ++i)
+    for(int j=0; j<numOfPoints[i]; ++j)
+    {
+      minPoint.x = std::min(minPoint.x, polygons[i][j].x);
+      minPoint.y = std::min(minPoint.y, polygons[i][j].y);
+      maxPoint.x = std::max(maxPoint.x, polygons[i][j].x);
+      maxPoint.y = std::max(maxPoint.y, polygons[i][j].y);
+    }
+  sectorsOrigin = Vector2<int>(static_cast<int>(floor(minPoint.x / SECTOR_CELL_SIZE)), 
+                               static_cast<int>(floor(minPoint.y / SECTOR_CELL_SIZE)));
+  sectorsWidth = static_cast<int>(floor(maxPoint.x / SECTOR_CELL_SIZE)) - sectorsOrigin.x + 1;
+  sectorsHeight = static_cast<int>(floor(maxPoint.y / SECTOR_CELL_SIZE)) - sectorsOrigin.y + 1;
+
+  // Classify the center of each cell, testing the polygons in the same order as before:
+  sectors.resize(sectorsWidth * sectorsHeight);
+  for(int y=0; y<sectorsHeight; ++y)
+    for(int x=0; x<sectorsWidth; ++x)
+    {
+      const Vector2<double> p((sectorsOrigin.x + x + 0.5) * SECTOR_CELL_SIZE, 
+                              (sectorsOrigin.y + y + 0.5) * SECTOR_CELL_SIZE);
+      Sector sector = NO_SECTOR;
+      if(Geometry::isPointInsideConvexPolygon(leftPoly, 3, p))
+        sector = LEFT;
+      else if(Geometry::isPointInsideConvexPolygon(rightPoly, 3, p))
+        sector = RIGHT;
+      else if(Geometry::isPointInsideConvexPolygon(centerLeftPoly, 4, p))
+        sector = CENTER_LEFT;
+      else if(Geometry::isPointInsideConvexPolygon(centerRightPoly, 4, p))
+        sector = CENTER_RIGHT;
+      sectors[y * sectorsWidth + x] = static_cast<unsigned char>(sector);
+    }
+}
+
+inline ObstacleModelProvider::Sector ObstacleModelProvider::getSector(const Vector2<double>& p) const
+{
+  const int x = static_cast<int>(floor(p.x / SECTOR_CELL_SIZE)) - sectorsOrigin.x,
+            y = static_cast<int>(floor(p.y / SECTOR_CELL_SIZE)) - sectorsOrigin.y;
+  if(x < 0 || x >= sectorsWidth || y < 0 || y >= sectorsHeight)
+    return NO_SECTOR;
+  else
+    return static_cast<Sector>(sectors[y * sectorsWidth + x]);
 }
 
 inline Vector2<int> ObstacleModelProvider::worldToGrid(const Vector2<int>& p) const
 {
-  Pose2D odoRotation(theOdometryData.rotation, 0.0, 0.0);
-  Vector2<double> pDouble(p.x, p.y);
-  pDouble = odoRotation*pDouble;
-  pDouble /= CELL_SIZE;
-  double moveX(CELLS_X/2);
-  double moveY(CELLS_Y/2);
-  pDouble += Vector2<double>(moveX, moveY);
-  return Vector2<int>(static_cast<int>(pDouble.x), static_cast<int>(pDouble.y));
+  const double x = theOdometryData.translation.x + p.x * cosRotation - p.y * sinRotation,
+               y = theOdometryData.translation.y + p.x * sinRotation + p.y * cosRotation;
+  return Vector2<int>(static_cast<int>(floor(x / CELL_SIZE)) - origin.x, 
+                      static_cast<int>(floor(y / CELL_SIZE)) - origin.y);
 }
 
-inline Vector2<int> ObstacleModelProvider::gridToWorld(const Vector2<int>& p) const
+inline Vector2<double> ObstacleModelProvider::gridToWorld(const Vector2<int>& p) const
 {
-  Vector2<double> pDouble(p.x,p.y);
-  double moveX(CELLS_X/2);
-  double moveY(CELLS_Y/2);
-  pDouble -= Vector2<double>(moveX, moveY);
-  pDouble *= CELL_SIZE;
-  Pose2D odoRotation(-theOdometryData.rotation, 0.0, 0.0);
-  pDouble = odoRotation*pDouble;
-  return Vector2<int>(static_cast<int>(pDouble.x), static_cast<int>(pDouble.y));
+  const double x = (origin.x + p.x + 0.5) * CELL_SIZE - theOdometryData.translation.x,
+               y = (origin.y + p.y + 0.5) * CELL_SIZE - theOdometryData.translation.y;
+  return Vector2<double>(x * cosRotation + y * sinRotation, y * cosRotation - x * sinRotation);
 }
 
 void ObstacleModelProvider::occupyCells()
@@ -279,9 +319,9 @@ void ObstacleModelProvider::occupyCells()
 
 void ObstacleModelProvider::ageCellState()
 {
-  for(int i=0; i<CELLS_X*CELLS_Y; ++i)
+  for(int i=0; i<(int) activeCells.size();)
   {
-    Cell& c = cells[i];
+    Cell& c = cells[activeCells[i]];
     if(c.state)
     {
       if(theFrameInfo.getTimeSince(c.lastUpdate) > parameters.cellFreeInterval)
@@ -290,59 +330,63 @@ void ObstacleModelProvider::ageCellState()
         c.lastUpdate = theFrameInfo.time;
       }
     }
+    if(c.state)
+      ++i;
+    else
+    { // cell is free -> replace it by the last one
+      c.active = false;
+      activeCells[i] = activeCells.back();
+      activeCells.pop_back();
+    }
   }
 }
 
-void ObstacleModelProvider::moveGrid()
+void ObstacleModelProvider::occupyCell(int x, int y)
 {
-  accumulatedOdometry += theOdometryData - lastOdometry;
-  lastOdometry = theOdometryData;
-  // Move grid backwards in x direction (robot moves forward):
-  if(accumulatedOdometry.translation.x >= CELL_SIZE)
+  if(x >= 0 && x < CELLS_X && y >= 0 && y < CELLS_Y)
   {
-    accumulatedOdometry.translation.x -= CELL_SIZE;
-    for(int y=0; y<CELLS_Y; ++y)
+    const int index = getIndex(x, y);
+    Cell& c = cells[index];
+    if(c.state < Cell::MAX_VALUE)
+      c.state++;
+    c.lastUpdate = theFrameInfo.time;
+    if(!c.active)
     {
-      Cell* cStartNew = &cells[y*CELLS_X];
-      Cell* cStartOld = cStartNew + 1;
-      memmove(cStartNew, cStartOld, sizeof(Cell)*(CELLS_X-1));
-      cStartNew[CELLS_X-1] = Cell();
+      c.active = true;
+      activeCells.push_back(index);
     }
   }
-  // Move grid forward in x direction (robot moves backwards):
-  else if(accumulatedOdometry.translation.x <= -CELL_SIZE)
-  {
-    accumulatedOdometry.translation.x += CELL_SIZE;
-    for(int y=0; y<CELLS_Y; ++y)
-    {
-      Cell* cStartOld = &cells[y*CELLS_X];
-      Cell* cStartNew = cStartOld + 1;
-      memmove(cStartNew, cStartOld, sizeof(Cell)*(CELLS_X-1));
-      cStartOld[0] = Cell();
-    }
-  }
-  // Move grid backwards in y direction (robot moves to the left):
-  if(accumulatedOdometry.translation.y >= CELL_SIZE)
+}
+
+void ObstacleModelProvider::moveGrid()
+{
+  // The grid stays aligned to odometry. Only its origin moves, so that the robot remains in its center.
+  const Vector2<int> newOrigin(static_cast<int>(floor(theOdometryData.translation.x / CELL_SIZE)) - CELLS_X / 2,
+                               static_cast<int>(floor(theOdometryData.translation.y / CELL_SIZE)) - CELLS_Y / 2);
+  // Clear the columns entering the grid:
+  const int dx(newOrigin.x - origin.x);
+  if(dx)
   {
-    accumulatedOdometry.translation.y -= CELL_SIZE;
-    Cell* cStartOld = &cells[CELLS_X];
-    Cell* cStartNew = &cells[0];
-    memmove(cStartNew, cStartOld, sizeof(Cell)*CELLS_X*(CELLS_Y-1));
-    Cell* c = &cells[(CELLS_Y-1)*CELLS_X];
-    for(int x=0; x<CELLS_X; ++x)
-      c[x] = Cell();
+    const int firstX(dx > 0 ? origin.x + CELLS_X : newOrigin.x);
+    const int numOfColumns(std::min(abs(dx), (int) CELLS_X));
+    for(int x=firstX; x<firstX+numOfColumns; ++x)
+      for(Cell* c = &cells[x & (CELLS_X-1)]; c < &cells[CELLS_X*CELLS_Y]; c += CELLS_X)
+        c->state = Cell::FREE;
   }
-  // Move grid forward in y direction (robot moves to the right):
-  else if(accumulatedOdometry.translation.y <= -CELL_SIZE)
+  // Clear the rows entering the grid:
+  const int dy(newOrigin.y - origin.y);
+  if(dy)
   {
-    accumulatedOdometry.translation.y += CELL_SIZE;
-    Cell* cStartNew = &cells[CELLS_X];
-    Cell* cStartOld = &cells[0];
-    memmove(cStartNew, cStartOld, sizeof(Cell)*CELLS_X*(CELLS_Y-1));
-    Cell* c = &cells[0];
-    for(int x=0; x<CELLS_X; ++x)
-      c[x] = Cell();
+    const int firstY(dy > 0 ? origin.y + CELLS_Y : newOrigin.y);
+    const int numOfRows(std::min(abs(dy), (int) CELLS_Y));
+    for(int y=firstY; y<firstY+numOfRows; ++y)
+    {
+      Cell* c = &cells[(y & (CELLS_Y-1))*CELLS_X];
+      for(int x=0; x<CELLS_X; ++x)
+        c[x].state = Cell::FREE;
+    }
   }
+  origin = newOrigin;
 }
 
 void ObstacleModelProvider::clipPointP2(const Vector2<int>& p1, Point& p2) const
@@ -373,7 +417,7 @@ void ObstacleModelProvider::clipPointP2(const Vector2<int>& p1, Point& p2) const
 void ObstacleModelProvider::fillScanBoundary()
 {
   // generate boundary of polygon
-  std::list<Line> lines;
+  lines.clear();
   int j;
   for(j = 1; j < (int) polyPoints.size() - 1; ++j)
   {
@@ -384,13 +428,13 @@ void ObstacleModelProvider::fillScanBoundary()
   lines.push_back(Line(polyPoints[j - 1], polyPoints[j]));
   
   // sort the lines by their y coordinates
-  lines.sort();
+  std::sort(lines.begin(), lines.end());
 
   // run through lines in increasing y order
   for(int y = (int) lines.front().a.y; !lines.empty(); ++y)
   {
     inter.clear();
-    for(std::list<Line>::iterator it = lines.begin(); it != lines.end() && (*it).a.y <= y;)
+    for(std::vector<Line>::iterator it = lines.begin(); it != lines.end() && (*it).a.y <= y;)
       if((*it).b.y > y || ((*it).peak && (*it).b.y == y))
       { // line is not finished yet
         inter.push_back(int((*it).a.x));
@@ -403,17 +447,9 @@ void ObstacleModelProvider::fillScanBoundary()
         inter.push_back(int((*it).b.x));
         ++it;
       }
-      else if(it != lines.begin())
-      { // line is finished -> remove it
-        std::list<Line>::iterator it_help = it;
-        --it;
-        lines.erase(it_help);
-        ++it;
-      }
       else
-      { // special case: remove begin of list
-        lines.erase(it);
-        it = lines.begin();
+      { // line is finished -> remove it
+        it = lines.erase(it);
       }
 
     // fill the line on an even/odd basis
@@ -433,13 +469,12 @@ void ObstacleModelProvider::fillScanBoundary()
           if(startX == goalX)
             ++startX;
           goalX = *iIt;
-          Cell* cell = &cells[y*CELLS_X+startX];
           for(int x = startX; x <= goalX; ++x)
           {
-            if((*cell).state > 0) 
-              (*cell).state--;
-            (*cell).lastUpdate = theFrameInfo.time;
-            ++cell;
+            Cell& cell = cells[getIndex(x, y)];
+            if(cell.state > 0) 
+              cell.state--;
+            cell.lastUpdate = theFrameInfo.time;
           }
         }
       }
@@ -449,23 +484,21 @@ void ObstacleModelProvider::fillScanBoundary()
 void ObstacleModelProvider::line(Vector2<int>& start, Vector2<int>& end) 
 {
   Vector2<int> diff = end - start,
-               inc(diff.x > 0 ? 1 : -1, (diff.y > 0 ? 1 : -1) * (&cells[CELLS_X] - &cells[0])),
+               inc(diff.x > 0 ? 1 : -1, diff.y > 0 ? 1 : -1),
                absDiff(abs(diff.x), abs(diff.y));
-  Cell* p = &cells[start.y*CELLS_X + start.x];
+  Vector2<int> p(start);
 
   if(absDiff.y < absDiff.x)
   {
     int error = -absDiff.x;
     for(int i = 0; i <= absDiff.x; ++i)
     {
-      if(p->state < Cell::MAX_VALUE)
-        p->state++;
-      p->lastUpdate = theFrameInfo.time;
-      p += inc.x;
+      occupyCell(p.x, p.y);
+      p.x += inc.x;
       error += 2 * absDiff.y;
       if(error > 0)
       {
-        p += inc.y;
+        p.y += inc.y;
         error -= 2 * absDiff.x;
       }
     }
@@ -475,14 +508,12 @@ void ObstacleModelProvider::line(Vector2<int>& start, Vector2<int>& end)
     int error = -absDiff.y;
     for(int i = 0; i <= absDiff.y; ++i)
     {
-      if(p->state < Cell::MAX_VALUE)
-        p->state++;
-      p->lastUpdate = theFrameInfo.time;
-      p += inc.y;
+      occupyCell(p.x, p.y);
+      p.y += inc.y;
       error += 2 * absDiff.x;
       if(error > 0)
       {
-        p += inc.x;
+        p.x += inc.x;
         error -= 2 * absDiff.y;
       }
     }
@@ -500,10 +531,10 @@ void ObstacleModelProvider::draw() const
   COMPLEX_DRAWING("module:ObstacleModelProvider:grid",
     unsigned char colorOccupiedStep(255/Cell::MAX_VALUE);
     ColorRGBA baseColor(200,200,255);
-    const int numOfCells(CELLS_X*CELLS_Y);
     unsigned char cellsForDrawing[CELLS_Y*CELLS_X];
-    for(int i=0; i<numOfCells; ++i)
-      cellsForDrawing[i] = colorOccupiedStep*cells[i].state;
+    for(int y=0; y<CELLS_Y; ++y)
+      for(int x=0; x<CELLS_X; ++x)
+        cellsForDrawing[y*CELLS_X+x] = colorOccupiedStep*cells[getIndex(x, y)].state;
     GRID_MONO("module:ObstacleModelProvider:grid", CELL_SIZE*2, CELLS_X, CELLS_Y, baseColor, cellsForDrawing);
     int gridWidth(CELLS_X*CELL_SIZE*2);
     int gridHeight(CELLS_Y*CELL_SIZE*2);
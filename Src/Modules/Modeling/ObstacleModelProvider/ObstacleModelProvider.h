@@ -104,12 +104,16 @@ private:
     int lastUpdate;                           /** The point of time of the last change of the state*/
     enum State {FREE = 0, MAX_VALUE = 3};     /** Minimum and maximum value of state */
     int state;                                /** The state of the cell, i.e. the number of positive measurements within the last few frames*/
+    bool active;                              /** Is the cell in the list of active cells? */
 
     /** Constructor */
-    Cell():lastUpdate(0),state(FREE)
+    Cell():lastUpdate(0),state(FREE),active(false)
     {}
   };
 
+  /** The sectors of the obstacle model a point can be located in */
+  enum Sector {NO_SECTOR, LEFT, RIGHT, CENTER_LEFT, CENTER_RIGHT, numOfSectors};
+
   /**
   * @class Point
   * The class represents a grid point together with clipping information.
@@ -201,17 +205,20 @@ public:
   ObstacleModelProvider();
 
 private:
-  /** Dimensions of the grid */
-  enum {CELL_SIZE = 60,
-        CELLS_X = 40,
-        CELLS_Y = 40};
-
-  Pose2D accumulatedOdometry;                 /**< Storing odometry differences for grid update */
-  Pose2D lastOdometry;                        /**< Odometry value at last execution */
+  /** Dimensions of the grid. The numbers of cells must be powers of two. */
+  enum {CELL_SIZE = 50,
+        CELLS_X = 64,
+        CELLS_Y = 64,
+        SECTOR_CELL_SIZE = 20};
+
+  Vector2<int> origin;                        /**< The position of the grid in odometry coordinates (in cells). The robot is in its center. */
+  double cosRotation, sinRotation;            /**< The cosine and sine of the odometry rotation in the current frame */
   unsigned lastTimePenalized;                 /**< Last point of time the robot was penalized */
   Parameters parameters;                      /**< The parameters of this module */
-  Cell cells[CELLS_Y*CELLS_X];                /**< The grid */
+  Cell cells[CELLS_Y*CELLS_X];                /**< The grid. Cell (x, y) of the grid is stored at ((origin + (x, y)) mod size). */
+  std::vector<int> activeCells;               /**< The indices of all cells that may have a state above FREE */
   std::vector<Point> polyPoints;              /**< Vector of obstacle points to become processed. Clipped and filtered. */
+  std::vector<Line> lines;                    /**< The boundary of the polygon that is filled. */
   std::vector<int> inter;                     /**< The intersections per line. */
   int lastLeftMeasurement, lastRightMeasurement; /**< Last Measurements for left and right Sensors */
   int lastLeftMeasurementTime, lastRightMeasurementTime; /**< Last time the last[Left|Right]Measurement values have been updated */
@@ -219,6 +226,9 @@ private:
   Vector2<double> rightPoly[3];               /**< Polygon for right output value */
   Vector2<double> centerLeftPoly[4];          /**< Polygon for center/left output value */
   Vector2<double> centerRightPoly[4];         /**< Polygon for center/right output value */
+  std::vector<unsigned char> sectors;         /**< The sector for each cell of a grid in robot coordinates */
+  Vector2<int> sectorsOrigin;                 /**< The position of the lower left cell of the sectors grid (in cells) */
+  int sectorsWidth, sectorsHeight;            /**< The dimensions of the sectors grid */
   bool polygonsComputed;                      /**< Flag to assure that polygons are only computed once */
 
   /** Executes this module
@@ -232,9 +242,22 @@ private:
   /** Enter obstacles to the grid */
   void occupyCells();
 
-  /** Ages all cells, i.e. decreases the obstacle value in each cell */
+  /** Ages all active cells, i.e. decreases the obstacle value in each cell */
   void ageCellState();
 
+  /** Returns the index of a grid cell in the array of cells
+  * @param x The x coordinate of the cell within the grid
+  * @param y The y coordinate of the cell within the grid
+  * @return The index
+  */
+  int getIndex(int x, int y) const {return ((origin.y + y) & (CELLS_Y - 1)) * CELLS_X + ((origin.x + x) & (CELLS_X - 1));}
+
+  /** Increases the obstacle value of a cell
+  * @param x The x coordinate of the cell within the grid. Cells outside the grid are ignored.
+  * @param y The y coordinate of the cell within the grid
+  */
+  void occupyCell(int x, int y);
+
   /** Called by occupyCells, frees the space between the sensor and the obstacle */
   void fillScanBoundary();
 
@@ -252,9 +275,18 @@ private:
 
   /** Converts coordinates in grid coordinates to the local coordinate system
   * @param p The position within the grid
-  * @return A position in local robot coordinates
+  * @return The position of the center of the cell in local robot coordinates
+  */
+  Vector2<double> gridToWorld(const Vector2<int>& p) const;
+
+  /** Computes the sector of each cell of a grid in robot coordinates from the polygons */
+  void computeSectors();
+
+  /** Determines the sector a point is located in
+  * @param p The point in local robot coordinates
+  * @return The sector
   */
-  Vector2<int> gridToWorld(const Vector2<int>& p) const;
+  Sector getSector(const Vector2<double>& p) const;
 
   /** Enters an obstacle line to the grid
   * @param start The start of the line
@@ -267,7 +299,7 @@ private:
   */
   void computeModel(ObstacleModel& obstacleModel);
 
-  /** Moves the grid cells according to the odometry differences*/
+  /** Moves the origin of the grid according to the odometry and clears the cells entering the grid */
   void moveGrid();
 
   /** Do debug drawings*/
@@ -17,7 +17,7 @@ ParticleFilterBallLocator::ParticleFilterBallLocator()
    gaussianAngles(3200, 320, static_cast<int> (parameters.angleStandardDeviation),
    static_cast<int> (parameters.angleStandardDeviation), 1),newSamplesNumberForDrawing(0)
 {
-  ballSamples = new BallSampleSet(40); //40 samples
+  ballSamples = new BallSampleSet(parameters.maxNumberOfSamples);
   for(int i = 0; i < ballSamples->size(); ++i)
   {
     Pose2D pose(theFieldDimensions.randomPoseOnField());
@@ -59,12 +59,14 @@ void ParticleFilterBallLocator::update(BallModel& ballModel)
   {
     sensorUpdate();
     resampling();
+    if(parameters.adaptiveNumberOfSamples)
+      adaptNumberOfSamples();
   }
   modelGeneration(ballModel);
   postExecution(ballModel);
 
   //Send BallModel to TeamMate
-  TEAM_OUTPUT(idTeamMateBallModel, bin, ballModel);	
+  TEAM_OUTPUT(idTeamMateBallModel, bin, BallModelCompressed(ballModel));	
 
   DECLARE_DEBUG_DRAWING("module:ParticleFilterBallLocator:ball samples", "drawingOnField"); // Draws the internal representations of the ball locator
   COMPLEX_DRAWING("module:ParticleFilterBallLocator:ball samples", drawSamples());
@@ -284,6 +286,43 @@ void ParticleFilterBallLocator::resampling()
 }
 
 
+void ParticleFilterBallLocator::adaptNumberOfSamples()
+{
+  enum {numberOfGridCells = 32}; // per axis, centered at the robot
+  const int numberOfSamples(ballSamples->size());
+  const int offset = numberOfGridCells / 2 * parameters.kldCellSize;
+
+  // sort the samples into bins of position and state
+  kldSampling.clear(numberOfGridCells * numberOfGridCells * 2);
+  for(int i = 0; i < numberOfSamples; ++i)
+  {
+    const BallSample& s(ballSamples->at(i));
+    const int x = std::max(0, std::min(numberOfGridCells - 1, (s.pos.x + offset) / parameters.kldCellSize)),
+              y = std::max(0, std::min(numberOfGridCells - 1, (s.pos.y + offset) / parameters.kldCellSize));
+    kldSampling.add((y * numberOfGridCells + x) * 2 + (s.state == BallSample::ROLLING ? 1 : 0));
+  }
+  const int newNumberOfSamples = std::min(ballSamples->getCapacity(), std::max(parameters.minNumberOfSamples,
+                                          kldSampling.getNumberOfSamples(parameters.kldEpsilon, parameters.kldQuantile)));
+
+  if(newNumberOfSamples < numberOfSamples)
+  {
+    // the resampled set is ordered, so keep samples evenly spread over it
+    for(int i = 0; i < newNumberOfSamples; ++i)
+      ballSamples->at(i) = ballSamples->at(i * numberOfSamples / newNumberOfSamples);
+    ballSamples->resize(newNumberOfSamples);
+  }
+  else if(newNumberOfSamples > numberOfSamples)
+  {
+    // duplicate random samples, the motion update will spread them
+    ballSamples->resize(newNumberOfSamples);
+    for(int i = numberOfSamples; i < newNumberOfSamples; ++i)
+      ballSamples->at(i) = ballSamples->at(random(numberOfSamples));
+  }
+  // scale the number of generated samples, so it is still equal to the number of samples only if all were generated
+  numberOfGeneratedSamples = numberOfGeneratedSamples * newNumberOfSamples / numberOfSamples;
+  newSamplesNumberForDrawing = numberOfGeneratedSamples;
+}
+
 BallSample ParticleFilterBallLocator::generateNewSample()
 {
   BallSample newSample;
@@ -10,6 +10,7 @@
 
 #include "Tools/Math/GaussianDistribution2D.h"
 #include "Tools/Math/GaussianTable.h"
+#include "Tools/Math/KLDSampling.h"
 #include "Tools/Module/Module.h"
 #include "Tools/SampleSet.h"
 #include "Representations/Infrastructure/CameraInfo.h"
@@ -72,6 +73,12 @@ private:
       STREAM(robotBoxSizeX);
       STREAM(robotBoxSizeY);
       STREAM(ballCollisionCheckSquareDistance);
+      STREAM(adaptiveNumberOfSamples);
+      STREAM(minNumberOfSamples);
+      STREAM(maxNumberOfSamples);
+      STREAM(kldEpsilon);
+      STREAM(kldQuantile);
+      STREAM(kldCellSize);
     STREAM_REGISTER_FINISH();
   }
 
@@ -86,7 +93,10 @@ public:
                                          templateSpeedDecreaseFactor(5.0), ballMotionProbability(0.2),
                                          speedPercentageAfterOneSecond(70),
                                          maxVelocity(2000), minOdoTranslation(10), minOdoRotation(fromDegrees(5)),
-                                         robotBoxSizeX(80), robotBoxSizeY(100)
+                                         robotBoxSizeX(80), robotBoxSizeY(100),
+                                         adaptiveNumberOfSamples(true), minNumberOfSamples(10),
+                                         maxNumberOfSamples(40), kldEpsilon(0.15), kldQuantile(2.33),
+                                         kldCellSize(250)
   {
   }
 
@@ -109,6 +119,12 @@ public:
   int robotBoxSizeX;
   int robotBoxSizeY;
   int ballCollisionCheckSquareDistance; //computed at runtime
+  bool adaptiveNumberOfSamples; /**< Adapt the number of samples using KLD-sampling? */
+  int minNumberOfSamples; /**< The minimum number of samples in adaptive mode. */
+  int maxNumberOfSamples; /**< The maximum number of samples. Only used at construction. */
+  double kldEpsilon; /**< The maximum Kullback-Leibler distance between the samples and the posterior. */
+  double kldQuantile; /**< The upper quantile of the standard normal distribution for the confidence of the bound. */
+  int kldCellSize; /**< The size of the grid cells for binning the ball positions (in mm). */
 };
 
 
@@ -155,6 +171,9 @@ private:
   /** resampling step of particle filter localization*/
   void resampling();
 
+  /** Adapts the number of samples to the spread of the samples after resampling (KLD-sampling) */
+  void adaptNumberOfSamples();
+
   /** Computes a new sample
   * @return The sample
   */
@@ -198,6 +217,7 @@ private:
   ParticleFilterBallLocatorParameters parameters;            /** some parameters */
   GaussianTable gaussian;                                    /** precomputed gaussian values for distances*/  
   GaussianTable gaussianAngles;                              /** precomputed gaussian values for angles*/  
+  KLDSampling kldSampling;                                   /** determines the number of samples in adaptive mode*/
   int newSamplesNumberForDrawing;
 
   class BufferedPercept
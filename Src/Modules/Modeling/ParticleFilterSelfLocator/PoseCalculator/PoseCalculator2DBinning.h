@@ -60,26 +60,12 @@ public:
 
       if(sample.weighting)
       {
-        //  x,y: Index on the translation axes. similar to the rotation, the 0 position
-        //       is at 0.5*numberOfGridCells.  	
-        int x = (sample.translation.x * numberOfGridCells + (numberOfGridCells >> 1)*width) / width;
-        int y = (sample.translation.y * numberOfGridCells + (numberOfGridCells >> 1)*height)/ height;
-
-        // translation axes are non-cyclic, so we set [x|y] < 0 to 0 and 
-        // [x|y] >= numberOfGridCells to numberOfGridCells-1
-        if(x < 0) 
-          x = 0;
-        else if(x >= numberOfGridCells) 
-          x = numberOfGridCells - 1;
+        int x, y;
+        getCell(sample.translation, width, height, x, y);
         if(x < xSquareMin)
           xSquareMin = x;
         if(x > xSquareMax)
           xSquareMax = x;
-
-        if(y < 0) 
-          y = 0;
-        else if(y >= numberOfGridCells) 
-          y = numberOfGridCells - 1;
         if(y < ySquareMin)
           ySquareMin = y;
         if(y > ySquareMax)
@@ -164,6 +150,33 @@ public:
       }
   }
 
+  /**
+  * The method determines the cell of the grid a position belongs to.
+  * @param translation The position on the field.
+  * @param width The size of the field along the x axis.
+  * @param height The size of the field along the y axis.
+  * @param x The index of the cell along the x axis is returned here.
+  * @param y The index of the cell along the y axis is returned here.
+  */
+  static void getCell(const Vector2<int>& translation, int width, int height, int& x, int& y)
+  {
+    //  x,y: Index on the translation axes. similar to the rotation, the 0 position
+    //       is at 0.5*numberOfGridCells.  	
+    x = (translation.x * numberOfGridCells + (numberOfGridCells >> 1)*width) / width;
+    y = (translation.y * numberOfGridCells + (numberOfGridCells >> 1)*height)/ height;
+
+    // translation axes are non-cyclic, so we set [x|y] < 0 to 0 and 
+    // [x|y] >= numberOfGridCells to numberOfGridCells-1
+    if(x < 0) 
+      x = 0;
+    else if(x >= numberOfGridCells) 
+      x = numberOfGridCells - 1;
+    if(y < 0) 
+      y = 0;
+    else if(y >= numberOfGridCells) 
+      y = numberOfGridCells - 1;
+  }
+
   void draw()
   {
     const int fieldLength = int(theFieldDimensions.x.getSize()),
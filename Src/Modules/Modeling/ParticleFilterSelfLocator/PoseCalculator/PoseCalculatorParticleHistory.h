@@ -42,10 +42,10 @@ public:
     maxClusterIdx(0), lastClusterIdx(0), clusterSwitchPercentage(50),
     mergingStrategy(PARTICLE_BLEEDING)
   {
-    clusterCount.resize(samples.size() * 2);
+    clusterCount.resize(samples.getCapacity() * 2);
     clusterCount.assign(clusterCount.size(), 0);
     clusters.reserve(clusterCount.size());
-    freeClusterIndizes.reserve(samples.size());
+    freeClusterIndizes.reserve(samples.getCapacity());
   }
 
   void calcPose(RobotPose& robotPose)
@@ -153,8 +153,12 @@ public:
       Sample& sample = this->samples.at(i);
       sample.cluster = i;
       clusterCount[i] = 1;
-      clusterCount[i + this->samples.size()] = -1;
-      freeClusterIndizes.push_back(i + this->samples.size());
+    }
+    // The sample set might grow up to its capacity, so all other indices are free
+    for(int i = this->samples.size(); i < (int) clusterCount.size(); ++i)
+    {
+      clusterCount[i] = -1;
+      freeClusterIndizes.push_back(i);
     }
   }
 
@@ -143,20 +143,20 @@ SampleTemplate SampleTemplateGenerator::getNewTemplate()
   // Current solution: Prefer to construct templates from full goals only:
   if(fullGoals.getNumberOfEntries())
   {
-    FullGoal& goal = fullGoals[rand() % fullGoals.getNumberOfEntries()];
+    FullGoal& goal = fullGoals[randomInt() % fullGoals.getNumberOfEntries()];
     newTemplate = generateTemplateFromFullGoal(goal);
   }
   else if(knownGoalposts.getNumberOfEntries())
   {
-    KnownGoalpost& goalPost = knownGoalposts[rand() % knownGoalposts.getNumberOfEntries()];
+    KnownGoalpost& goalPost = knownGoalposts[randomInt() % knownGoalposts.getNumberOfEntries()];
     newTemplate = generateTemplateFromPosition(goalPost.seenPosition, 
       goalPost.realPosition, goalPost.odometry);
   }
   else if(unknownGoalposts.getNumberOfEntries())
   {
-    UnknownGoalpost& goalPost = unknownGoalposts[rand() % unknownGoalposts.getNumberOfEntries()];
+    UnknownGoalpost& goalPost = unknownGoalposts[randomInt() % unknownGoalposts.getNumberOfEntries()];
     newTemplate = generateTemplateFromPosition(goalPost.seenPosition, 
-      goalPost.realPositions[rand() % 2], goalPost.odometry);
+      goalPost.realPositions[randomInt() % 2], goalPost.odometry);
   }
   if(newTemplate.timestamp == 0) // In some cases, no proper sample is generated, return a random sample
   {
@@ -91,7 +91,7 @@ void SelfLocator::init()
     theLinePercept, theFrameInfo, theFieldDimensions, theCameraMatrix, *perceptValidityChecker,
     fieldModel));
 
-  setNumberOfSamples(parameter->numberOfSamples);
+  setNumberOfSamples(parameter->adaptiveNumberOfSamples ? parameter->maxNumberOfSamples : parameter->numberOfSamples);
   sampleTemplateGenerator.init();
   std::vector<Pose2D> poses;    
   std::vector<Pose2D> standardDeviations;
@@ -148,6 +148,7 @@ void SelfLocator::update(SelfLocatorSampleSet& sampleSet)
     update(dummyPose);
   }
   sampleSet.weightingsSum = totalWeighting;
+  sampleSet.numberOfSamples = samples->size();
   samples->link(sampleSet.sampleSetProxy);
 }
 
@@ -156,7 +157,8 @@ void SelfLocator::update(RobotPose& robotPose)
   MODIFY("module:SelfLocator:parameter", *parameter);
 
   // recreate sampleset if number of samples was changed
-  if (parameter->numberOfSamples != samples->size())
+  const int capacity = parameter->adaptiveNumberOfSamples ? parameter->maxNumberOfSamples : parameter->numberOfSamples;
+  if(capacity != samples->getCapacity() || (!parameter->adaptiveNumberOfSamples && capacity != samples->size()))
     init();
 
   // Maybe pose has already been computed by call to other update function (for clusters)
@@ -192,7 +194,10 @@ void SelfLocator::update(RobotPose& robotPose)
     {
       adaptWeightings();
       resampling();
+      if(parameter->adaptiveNumberOfSamples)
+        adaptNumberOfSamples();
     }
+    PLOT("module:SelfLocator:numberOfSamples", samples->size());
     poseCalculator->calcPose(robotPose);
   }
 
@@ -200,7 +205,7 @@ void SelfLocator::update(RobotPose& robotPose)
   lastPoseComputationTimeStamp = theFrameInfo.time;
 
   // send own position to the team mates
-  TEAM_OUTPUT(idTeamMateRobotPose, bin, robotPose);	
+  TEAM_OUTPUT(idTeamMateRobotPose, bin, RobotPoseCompressed(robotPose));	
 
   // drawings
   DECLARE_DEBUG_DRAWING("module:SelfLocator:poseCalculator", "drawingOnField"); // Draws the internal representations for pose computation
@@ -424,8 +429,8 @@ void SelfLocator::motionUpdate(bool noise)
     Sample& s(samples->at(i));
 
     // the translational error vector
-    const Vector2<int> transOffset((((transX - transXError) << 10) + 512 + ((transXError << 1) + 1) * (rand() & 0x3ff)) >> 10,
-                                   (((transY - transYError) << 10) + 512 + ((transYError << 1) + 1) * (rand() & 0x3ff)) >> 10);
+    const Vector2<int> transOffset((((transX - transXError) << 10) + 512 + ((transXError << 1) + 1) * (randomInt() & 0x3ff)) >> 10,
+                                   (((transY - transYError) << 10) + 512 + ((transYError << 1) + 1) * (randomInt() & 0x3ff)) >> 10);
 
     // update the sample
     s.translation = Vector2<int>(((s.translation.x << 10) + transOffset.x * s.rotation.x - transOffset.y * s.rotation.y + 512) >> 10,
@@ -480,11 +485,12 @@ bool SelfLocator::applySensorModels()
   // select observations
   while((int) selectedObservations.size() < parameter->numberOfObservations)
     if(observations.empty())
-      selectedObservations.push_back(selectedObservations[rand() % selectedObservations.size()]);
+      selectedObservations.push_back(selectedObservations[randomInt() % selectedObservations.size()]);
     else
-      selectedObservations.push_back(observations[rand() % observations.size()]);
+      selectedObservations.push_back(observations[randomInt() % observations.size()]);
 
   // apply sensor models
+  sampleArrays.fill(*samples);
   bool sensorModelApplied(false);
   std::vector<SensorModel*>::iterator sensorModel = sensorModels.begin();
   for(; sensorModel != sensorModels.end(); ++sensorModel)
@@ -498,7 +504,7 @@ bool SelfLocator::applySensorModels()
     if(selectedIndices.empty())
       result = SensorModel::NO_SENSOR_UPDATE;
     else
-      result = (*sensorModel)->computeWeightings(*samples, selectedIndices, sensorModelWeightings);
+      result = (*sensorModel)->computeWeightings(sampleArrays, selectedIndices, sensorModelWeightings);
     if(result == SensorModel::FULL_SENSOR_UPDATE)
     {
       for(int i = 0; i < samples->size(); ++i)
@@ -512,7 +518,7 @@ bool SelfLocator::applySensorModels()
       // Compute average of all valid weightings, use this average for all invalid ones
       double sum(0.0);
       int numOfValidSamples(0);
-      for(unsigned int i=0; i<sensorModelWeightings.size(); ++i)
+      for(int i = 0; i < samples->size(); ++i)
       {
         if(sensorModelWeightings[i] != -1)
         {
@@ -526,7 +532,7 @@ bool SelfLocator::applySensorModels()
         continue;
       }
       const double averageWeighting(sum / numOfValidSamples);
-      for(unsigned int i=0; i<sensorModelWeightings.size(); ++i)
+      for(int i = 0; i < samples->size(); ++i)
       {
         if(sensorModelWeightings[i] != -1)
           samples->at(i).weighting *= sensorModelWeightings[i];
@@ -570,7 +576,7 @@ void SelfLocator::resampling()
       generateTemplate(samples->at(j));
   else if(j) // in rare cases, a sample is missing, so add one (or more...)
     for(; j < numberOfSamples; ++j)
-      samples->at(j) = samples->at(rand() % j);
+      samples->at(j) = samples->at(randomInt() % j);
   else // resampling was not possible (for unknown reasons), so create a new sample set (fail safe)
 #ifdef NDEBUG
   {
@@ -588,6 +594,44 @@ void SelfLocator::resampling()
 #endif
 }
 
+void SelfLocator::adaptNumberOfSamples()
+{
+  typedef PoseCalculator2DBinning< Sample, SampleSet<Sample>, 10 > Binning;
+  const int numberOfGridCells = 10,
+            numberOfRotationSectors = 8;
+  const int width = int(theFieldDimensions.x.getSize()),
+            height = int(theFieldDimensions.y.getSize());
+  const int numberOfSamples(samples->size());
+
+  // sort the samples into bins
+  kldSampling.clear(numberOfGridCells * numberOfGridCells * numberOfRotationSectors);
+  for(int i = 0; i < numberOfSamples; ++i)
+  {
+    const Sample& s(samples->at(i));
+    int x, y;
+    Binning::getCell(s.translation, width, height, x, y);
+    const int sector = int((s.angle + pi) * (numberOfRotationSectors / pi2)) % numberOfRotationSectors;
+    kldSampling.add((y * numberOfGridCells + x) * numberOfRotationSectors + sector);
+  }
+  const int newNumberOfSamples = std::min(samples->getCapacity(), std::max(parameter->minNumberOfSamples,
+                                          kldSampling.getNumberOfSamples(parameter->kldEpsilon, parameter->kldQuantile)));
+
+  if(newNumberOfSamples < numberOfSamples)
+  {
+    // the resampled set is ordered, so keep samples evenly spread over it
+    for(int i = 0; i < newNumberOfSamples; ++i)
+      samples->at(i) = samples->at(i * numberOfSamples / newNumberOfSamples);
+    samples->resize(newNumberOfSamples);
+  }
+  else if(newNumberOfSamples > numberOfSamples)
+  {
+    // duplicate random samples, the motion update will spread them
+    samples->resize(newNumberOfSamples);
+    for(int i = numberOfSamples; i < newNumberOfSamples; ++i)
+      samples->at(i) = samples->at(randomInt() % numberOfSamples);
+  }
+}
+
 void SelfLocator::adaptWeightings()
 {
   totalWeighting = 0;
@@ -30,6 +30,7 @@
 #include "Representations/Modeling/SelfLocatorSampleSet.h"
 #include "Tools/RingBuffer.h"
 #include "Tools/Math/GaussianTable.h"
+#include "Tools/Math/KLDSampling.h"
 #include "SampleTemplateGenerator.h"
 #include "SensorModels/PerceptValidityChecker.h"
 #include "SensorModels/SensorModel.h"
@@ -102,6 +103,8 @@ private:
   SelfLocatorParameter* parameter; /**< All tweaking values. */
   FieldModel fieldModel; /**< The model of proximity to features on the field. */
   SampleSet<Sample>* samples; /**< Container for all samples. */
+  SelfLocatorSampleArrays sampleArrays; /**< The poses of all samples as processed by the sensor models. */
+  KLDSampling kldSampling; /**< Determines the number of samples in adaptive mode. */
   double totalWeighting; /**< The current weighting sum of all samples. */
   double slowWeighting; /**< This value follows the average weighting slowly. */
   double fastWeighting; /**< This value follows the average weighting more quickly. */
@@ -163,6 +166,13 @@ private:
   */
   void resampling();
 
+  /**
+  * The method adapts the number of samples to the spread of the samples
+  * after resampling (KLD-sampling). The samples are binned using the grid
+  * of PoseCalculator2DBinning and a number of rotation sectors.
+  */
+  void adaptNumberOfSamples();
+
   /**
   * Adapts the weightings for resampling percentage
   */
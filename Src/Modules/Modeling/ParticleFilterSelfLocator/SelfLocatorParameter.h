@@ -47,6 +47,11 @@ private:
     STREAM(clipTemplateGeneration);
     STREAM(clipTemplateGenerationRangeX);
     STREAM(clipTemplateGenerationRangeY);
+    STREAM(adaptiveNumberOfSamples);
+    STREAM(minNumberOfSamples);
+    STREAM(maxNumberOfSamples);
+    STREAM(kldEpsilon);
+    STREAM(kldQuantile);
     STREAM_REGISTER_FINISH();
   }
 
@@ -83,6 +88,11 @@ public:
   bool clipTemplateGeneration;
   Range<double> clipTemplateGenerationRangeX;
   Range<double> clipTemplateGenerationRangeY;
+  bool adaptiveNumberOfSamples; /**< Adapt the number of samples using KLD-sampling instead of using numberOfSamples? */
+  int minNumberOfSamples; /**< The minimum number of samples in adaptive mode. */
+  int maxNumberOfSamples; /**< The maximum number of samples in adaptive mode. */
+  double kldEpsilon; /**< The maximum Kullback-Leibler distance between the samples and the posterior. */
+  double kldQuantile; /**< The upper quantile of the standard normal distribution for the confidence of the bound. */
 };
 
 
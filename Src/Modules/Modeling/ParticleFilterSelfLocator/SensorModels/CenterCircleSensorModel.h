@@ -18,6 +18,7 @@ class CenterCircleSensorModel: public SensorModel
 private:
   /** Reference to line percept which contains center circle information */
   const LinePercept& theLinePercept;
+  std::vector<unsigned char> inGoalNet; /**< For each sample: Might the circle have been confused with the goal net? */
 
 public:
   /** Constructor. */
@@ -30,17 +31,15 @@ public:
     theLinePercept(linePercept) {}
 
   /** Function for computing weightings for a sample set.
-  * @param samples The samples (not changed by this function
+  * @param samples The poses of the samples
   * @param selectedIndices The indices of the selected observations.
   * @param weightings List of weightings. -1 means: no update
   * @return An overall result of the computation
   */
-  SensorModelResult computeWeightings(const SampleSet<SelfLocatorSample>& samples,
+  SensorModelResult computeWeightings(const SelfLocatorSampleArrays& samples,
     const std::vector<int>& selectedIndices, std::vector<double>& weightings)
   {
-    SensorModelResult result = FULL_SENSOR_UPDATE;
     // Precompute some stuff:
-    result = FULL_SENSOR_UPDATE;
     const short distanceObserved = static_cast<short>(theLinePercept.circle.pos.abs());
     const double angleObserved = theLinePercept.circle.pos.angle();
     const double& camZ = theCameraMatrix.translation.z;
@@ -48,25 +47,25 @@ public:
     const double bestPossibleAngleWeighting    = gaussianProbability(0.0, theSelfLocatorParameter.standardDeviationCenterCircleAngle);
     const double bestPossibleDistanceWeighting = gaussianProbability(0.0, theSelfLocatorParameter.standardDeviationCenterCircleDistance);
     const Vector2<double> centerCirclePosition(0,0);
+    // Check, if circle might have been confused with goal net:
+    inGoalNet.assign(samples.size(), 0);
+    const bool partial = thePerceptValidityChecker.markPointsProbablyInGoalNet(samples, 
+      distanceObserved, angleObserved, inGoalNet);
     // Iterate over all samples and compute weightings:
     for(int i = 0; i < samples.size(); ++i)
     {
-      const SelfLocatorSample& s(samples.at(i));
-      const Pose2D sPose(s.angle, s.translation.x, s.translation.y);
-      // Check, if circle might have been confused with goal net:
-      if(thePerceptValidityChecker.pointIsProbablyInGoalNet(sPose, distanceObserved, angleObserved))
+      if(inGoalNet[i])
       {
         weightings[i] = -1;
-        result = PARTIAL_SENSOR_UPDATE;
         continue;
       }
       // Compute weighting:
-      weightings[i] = computeAngleWeighting(angleObserved, centerCirclePosition, sPose, 
+      weightings[i] = computeAngleWeighting(angleObserved, centerCirclePosition, samples, i, 
         theSelfLocatorParameter.standardDeviationCenterCircleAngle, bestPossibleAngleWeighting);
       weightings[i] *= computeDistanceWeighting(distanceAsAngleObserved, centerCirclePosition, 
-        sPose, camZ, theSelfLocatorParameter.standardDeviationCenterCircleDistance, bestPossibleDistanceWeighting);
+        samples, i, camZ, theSelfLocatorParameter.standardDeviationCenterCircleDistance, bestPossibleDistanceWeighting);
     }
-    return result;
+    return partial ? PARTIAL_SENSOR_UPDATE : FULL_SENSOR_UPDATE;
   }
 };
 
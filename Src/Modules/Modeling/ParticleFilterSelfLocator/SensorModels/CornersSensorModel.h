@@ -31,10 +31,16 @@ private:
   };
 
   const LinePercept& theLinePercept; /**< Reference to points percept */
-  std::vector<short> selectedIndices;    /**< The indices of the points in the points percept that were selected for the sensor update. */
   std::vector<SelectedIndex> selectedIndicesPositions; /**< Precomputed information (distance+angle) about selected points */
   GaussianTable gaussian; /**< A table of Gaussians for assessing bearing measurements to corners. */
   const FieldModel& fieldModel; /**< The model of proximity to features on the field. */
+  std::vector<unsigned char> inGoalNet; /**< For each sample: Might any of the corners have been confused with the goal net? */
+  std::vector<int> camRotationX, /**< For each sample: The cosinus of the rotation of the camera on the field multiplied by 1024. */
+                   camRotationY, /**< For each sample: The sinus of the rotation of the camera on the field multiplied by 1024. */
+                   pObsX, /**< For each sample: The x coordinate of the observed corner on the field. */
+                   pObsY, /**< For each sample: The y coordinate of the observed corner on the field. */
+                   pModelX, /**< For each sample: The x coordinate of the closest corner in the field model. */
+                   pModelY; /**< For each sample: The y coordinate of the closest corner in the field model. */
 
 public:
   /** Constructor. */
@@ -49,12 +55,12 @@ public:
   {}
 
   /** Function for computing weightings for a sample set.
-  * @param samples The samples (not changed by this function
+  * @param samples The poses of the samples
   * @param selectedIndices The indices of the selected observations.
   * @param weightings List of weightings. -1 means: no update
   * @return An overall result of the computation
   */
-  SensorModelResult computeWeightings(const SampleSet<SelfLocatorSample>& samples,
+  SensorModelResult computeWeightings(const SelfLocatorSampleArrays& samples,
     const std::vector<int>& selectedIndices, std::vector<double>& weightings)
   {
     // Precompute some values
@@ -77,49 +83,68 @@ public:
                                     theLinePercept.intersections[selectedIndices[j]].dir2).angle() - pi_4;
       selectedIndicesPositions[j] = SelectedIndex(distance, bearing, direction);
     }
-    SensorModelResult result = FULL_SENSOR_UPDATE;
-    for(int i = 0; i < samples.size(); ++i)
-    {
-NEXT_SAMPLE:
-      const SelfLocatorSample& s(samples.at(i));
-      const Vector2<int> origin(int(s.translation.x), int(s.translation.y)),
-                         camRotation((rotCos * s.rotation.x - rotSin * s.rotation.y) >> 10,
-                                     (rotCos * s.rotation.y + rotSin * s.rotation.x) >> 10);
 
+    const int numberOfSamples = samples.size();
+    const int* x = &samples.x[0];
+    const int* y = &samples.y[0];
+    const int* sampleCos = &samples.cosAngle[0];
+    const int* sampleSin = &samples.sinAngle[0];
+    inGoalNet.assign(numberOfSamples, 0);
+    camRotationX.resize(numberOfSamples);
+    camRotationY.resize(numberOfSamples);
+    pObsX.resize(numberOfSamples);
+    pObsY.resize(numberOfSamples);
+    pModelX.resize(numberOfSamples);
+    pModelY.resize(numberOfSamples);
+    for(int i = 0; i < numberOfSamples; ++i)
+    {
+      camRotationX[i] = (rotCos * sampleCos[i] - rotSin * sampleSin[i]) >> 10;
+      camRotationY[i] = (rotCos * sampleSin[i] + rotSin * sampleCos[i]) >> 10;
       weightings[i] = 1.0;
-      for(int j = 0; j < (int) selectedIndices.size(); ++j)
+    }
+
+    bool partial = false;
+    for(int j = 0; j < (int) selectedIndices.size(); ++j)
+    {
+      if(thePerceptValidityChecker.markPointsProbablyInGoalNet(samples, 
+        selectedIndicesPositions[j].distance, selectedIndicesPositions[j].bearing, inGoalNet))
+        partial = true;
+
+      // Map the observation to the field for all samples
+      const LinePercept::Intersection& pp = theLinePercept.intersections[selectedIndices[j]];
+      for(int i = 0; i < numberOfSamples; ++i)
       {
-        if(thePerceptValidityChecker.pointIsProbablyInGoalNet(s.toPose(), 
-          selectedIndicesPositions[j].distance, selectedIndicesPositions[j].bearing))
-        {
-          weightings[i] = -1;
-          result = PARTIAL_SENSOR_UPDATE;
-          ++i;
-          if(i<samples.size())
-            goto NEXT_SAMPLE;
-          else 
-            goto FINISHED;
-        }
-        const LinePercept::Intersection& pp = theLinePercept.intersections[selectedIndices[j]];
-        const Vector2<int> pObs(origin.x + ((pp.pos.x * s.rotation.x - pp.pos.y * s.rotation.y) >> 10),
-                                origin.y + ((pp.pos.x * s.rotation.y + pp.pos.y * s.rotation.x) >> 10)),
-                           pModel = fieldModel.getClosestCorner(pObs, pp.type, s.angle + selectedIndicesPositions[j].direction),
-                           diffOnField = pModel - pObs,
-                           diffFromCamera((diffOnField.x * camRotation.x + diffOnField.y * camRotation.y) >> 10,
-                                          (diffOnField.y * camRotation.x - diffOnField.x * camRotation.y) >> 10),
-                           ppWithoutOffset(pp.pos.x - xOrigin, pp.pos.y - yOrigin),
-                           ppFromCamera((ppWithoutOffset.x * rotCos + ppWithoutOffset.y * rotSin) >> 10,
-                                        (ppWithoutOffset.y * rotCos - ppWithoutOffset.x * rotSin) >> 10);
+        pObsX[i] = x[i] + ((pp.pos.x * sampleCos[i] - pp.pos.y * sampleSin[i]) >> 10);
+        pObsY[i] = y[i] + ((pp.pos.x * sampleSin[i] + pp.pos.y * sampleCos[i]) >> 10);
+      }
+      fieldModel.getClosestCorners(numberOfSamples, &pObsX[0], &pObsY[0], pp.type, &samples.angle[0],
+                                   selectedIndicesPositions[j].direction, &pModelX[0], &pModelY[0]);
+
+      // The position relative to the camera is the same for all samples
+      const Vector2<int> ppWithoutOffset(pp.pos.x - xOrigin, pp.pos.y - yOrigin),
+                         ppFromCamera((ppWithoutOffset.x * rotCos + ppWithoutOffset.y * rotSin) >> 10,
+                                      (ppWithoutOffset.y * rotCos - ppWithoutOffset.x * rotSin) >> 10);
+      const int distanceDivisor = std::abs(ppFromCamera.x) + 450;
+      for(int i = 0; i < numberOfSamples; ++i)
+      {
+        const Vector2<int> diffOnField(pModelX[i] - pObsX[i], pModelY[i] - pObsY[i]),
+                           diffFromCamera((diffOnField.x * camRotationX[i] + diffOnField.y * camRotationY[i]) >> 10,
+                                          (diffOnField.y * camRotationX[i] - diffOnField.x * camRotationY[i]) >> 10);
         weightings[i] *= gaussian.value(
-          std::abs(1024 * diffFromCamera.x / (std::abs(ppFromCamera.x) + 450)),
+          std::abs(1024 * diffFromCamera.x / distanceDivisor),
           theSelfLocatorParameter.standardDeviationCorners);
         weightings[i] *= gaussian.value(
           ppFromCamera.x != 0 ? std::abs(1024 * diffFromCamera.y / ppFromCamera.x) : 0,
           theSelfLocatorParameter.standardDeviationCorners);
       }
     }
-FINISHED:
-    return result;
+
+    // Samples for which any corner might be a part of the goal net are not updated
+    if(partial)
+      for(int i = 0; i < numberOfSamples; ++i)
+        if(inGoalNet[i])
+          weightings[i] = -1;
+    return partial ? PARTIAL_SENSOR_UPDATE : FULL_SENSOR_UPDATE;
   }
 };
 
@@ -7,67 +7,213 @@
 
 #include "FieldModel.h"
 #include "Tools/Debugging/Modify.h"
-#include "Tools/Streams/InStreams.h"
+#include "Tools/Streams/OutStreams.h"
+#include "Platform/File.h"
+#include <cstdio>
 
-FieldModel::FieldModel() :
-fieldDimensions(0),
-maxCrossingLength(0)
+/**
+* The function adds a value to a FNV-1a hash.
+* @param hash The hash that is updated.
+* @param value The value added.
+*/
+static void addToHash(unsigned& hash, int value)
+{
+  for(int i = 0; i < 4; ++i)
+    hash = (hash ^ ((value >> (i * 8)) & 0xff)) * 16777619u;
+}
+
+/**
+* The function appends a number of bytes to a block of data.
+* @param data The data the bytes are appended to.
+* @param p The start of the bytes.
+* @param size The number of bytes.
+*/
+static void appendBytes(std::vector<char>& data, const void* p, size_t size)
+{
+  data.insert(data.end(), (const char*) p, (const char*) p + size);
+}
+
+/**
+* The function replaces a file by writing a temporary file first that is then renamed.
+* So other processes that still map the old file are not affected. Their mappings
+* remain valid and they never see a partially written file.
+* @param name The name of the file relative to the configuration directory.
+* @param data The new contents of the file.
+* @return Was the file replaced?
+*/
+static bool replaceFile(const std::string& name, const std::vector<char>& data)
 {
-  InBinaryFile stream(Global::getSettings().expandLocationFilename("fieldModel.tab"));
-  if(stream.exists())
+  const std::string fullName(std::string(File::getGTDir()) + "/Config/" + name);
+  char suffix[32];
+  sprintf(suffix, ".%p.%x", (const void*) &data, SystemCall::getRealSystemTime());
+  const std::string tempName(fullName + suffix);
   {
-    for(int i = 0; i < 2; ++i)
-      for(int j = 0; j < 2; ++j)
-        linePointsTables[i][j].read(stream);
-    for(int i = 0; i < 4; ++i)
-      tCornersTables[i].read(stream);
-    for(int i = 0; i < 4; ++i)
-      lCornersTables[i].read(stream);
+    OutBinaryFile stream(tempName);
+    if(!stream.exists())
+      return false;
+    stream.write(&data[0], (int) data.size());
   }
+#ifdef WIN32
+  // Windows cannot rename a file to an existing one. It cannot remove a mapped file either.
+  remove(fullName.c_str());
+#endif
+  if(rename(tempName.c_str(), fullName.c_str()))
+  {
+    remove(tempName.c_str());
+    return false;
+  }
+  return true;
+}
+
+FieldModel::FieldModel() :
+fieldDimensions(0),
+maxCrossingLength(0),
+key(0)
+{
 }
 
 void FieldModel::init(const FieldDimensions& fieldDimensions, const int& maxCrossingLength)
 {
   this->fieldDimensions = &fieldDimensions;
   this->maxCrossingLength = &maxCrossingLength;
+  if(key != computeKey() && !load())
+  {
+    OUTPUT(idText, text, "ERROR: fieldModel.tab does not exist or contains different field dimensions and parameters than"
+      << " the current version of the software. Computing new tables.");
+    create();
+  }
 }
 
-void FieldModel::create()
+unsigned FieldModel::computeKey() const
 {
-  OutBinaryFile stream(Global::getSettings().expandLocationFilename("fieldModel.tab"));
-  for(int i = 0; i < 2; ++i)
-    for(int j = 0; j < 2; ++j)
+  unsigned hash = 2166136261u;
+  addToHash(hash, magic);
+  addToHash(hash, 310); // the layout of the tables
+  addToHash(hash, 225);
+  addToHash(hash, 24);
+  addToHash(hash, *maxCrossingLength);
+  const std::vector<FieldDimensions::LinesTable::Line>& lines = fieldDimensions->fieldLines.lines;
+  for(std::vector<FieldDimensions::LinesTable::Line>::const_iterator i = lines.begin(); i != lines.end(); ++i)
+  {
+    addToHash(hash, int(i->corner.translation.x));
+    addToHash(hash, int(i->corner.translation.y));
+    addToHash(hash, int(i->corner.rotation * 1000));
+    addToHash(hash, int(i->length));
+  }
+  for(int i = FieldDimensions::tCorner0; i < FieldDimensions::lCorner0 + 4; ++i)
+  {
+    const FieldDimensions::CornersTable& corners = fieldDimensions->corners[i];
+    addToHash(hash, (int) corners.size());
+    for(FieldDimensions::CornersTable::const_iterator j = corners.begin(); j != corners.end(); ++j)
     {
-      linePointsTables[i][j].create(fieldDimensions->fieldLines, (1 - j) * pi_2, 2, i * *maxCrossingLength);
-      linePointsTables[i][j].write(stream);
+      addToHash(hash, j->x);
+      addToHash(hash, j->y);
     }
-  for(int i = 0; i < 4; ++i)
+  }
+  return hash ? hash : 1;
+}
+
+bool FieldModel::load()
+{
+  key = 0;
+  buffer.clear();
+  if(!file.open(Global::getSettings().expandLocationFilename("fieldModel.tab")))
+    return false;
+  const char* data = file.map(0, (size_t) file.getSize());
+  const unsigned currentKey = computeKey();
+  if(!data || !use(data, data + file.getSize(), currentKey))
   {
-    tCornersTables[i].create(fieldDimensions->corners[i + FieldDimensions::tCorner0]);
-    tCornersTables[i].write(stream);
+    file.close();
+    return false;
   }
+  key = currentKey;
+  return true;
+}
+
+bool FieldModel::use(const char* data, const char* end, unsigned key)
+{
+  if(end - data < (int) (2 * sizeof(unsigned)) ||
+     ((const unsigned*) data)[0] != (unsigned) magic || ((const unsigned*) data)[1] != key)
+    return false;
+  data += 2 * sizeof(unsigned);
+  for(int i = 0; i < 2; ++i)
+    for(int j = 0; j < 2; ++j)
+      if(!linePointsTables[i][j].use(data, end))
+        return false;
+  for(int i = 0; i < 4; ++i)
+    if(!tCornersTables[i].use(data, end))
+      return false;
   for(int i = 0; i < 4; ++i)
+    if(!lCornersTables[i].use(data, end))
+      return false;
+  return true;
+}
+
+void FieldModel::create()
+{
+  const unsigned header[2] = {magic, computeKey()};
+  std::vector<char> data;
+  appendBytes(data, header, sizeof(header));
+  for(int i = 0; i < 2; ++i)
+    for(int j = 0; j < 2; ++j)
+      ClosestPointsTable<310, 225, 24>::create(data, fieldDimensions->fieldLines, (1 - j) * pi_2, 2, i * *maxCrossingLength);
+  for(int i = 0; i < 4; ++i)
+    ClosestPointsTable<310, 225, 24>::create(data, fieldDimensions->corners[i + FieldDimensions::tCorner0]);
+  for(int i = 0; i < 4; ++i)
+    ClosestPointsTable<310, 225, 24>::create(data, fieldDimensions->corners[i + FieldDimensions::lCorner0]);
+
+  // like File, fall back to the default location if the file cannot be written in the current one
+  file.close();
+  if((!replaceFile(Global::getSettings().expandLocationFilename("fieldModel.tab"), data) &&
+      !replaceFile("Locations/Default/fieldModel.tab", data)) || !load())
   {
-    lCornersTables[i].create(fieldDimensions->corners[i + FieldDimensions::lCorner0]);
-    lCornersTables[i].write(stream);
+    OUTPUT(idText, text, "ERROR: fieldModel.tab cannot be written. Using the tables from memory.");
+    buffer.swap(data);
+    VERIFY(use(&buffer[0], &buffer[0] + buffer.size(), header[1]));
+    key = header[1];
   }
 }
 
-const Vector2<int> FieldModel::getClosestLinePoint(const Vector2<int>& point, const Vector2<int>& neighbor, int length2) const
+void FieldModel::getClosestLinePoints(int numberOfPoints, const int* x, const int* y, 
+                                      const int* neighborX, const int* neighborY, int length2,
+                                      int* closestX, int* closestY) const
 {
-  Vector2<int> diff = neighbor - point;
-  return linePointsTables[length2 > *maxCrossingLength * *maxCrossingLength ? 1 : 0]
-                         [std::abs(diff.y) > std::abs(diff.x) ? 1 : 0].getClosestPoint(point);
+  // the length is the same for all points, so only the orientation is determined per point
+  const ClosestPointsTable<310, 225, 24>* tables = linePointsTables[length2 > *maxCrossingLength * *maxCrossingLength ? 1 : 0];
+  for(int i = 0; i < numberOfPoints; ++i)
+  {
+    const Vector2<int> point(x[i], y[i]),
+                       closest = tables[std::abs(neighborY[i] - y[i]) > std::abs(neighborX[i] - x[i]) ? 1 : 0].getClosestPoint(point);
+    closestX[i] = closest.x;
+    closestY[i] = closest.y;
+  }
 }
 
-const Vector2<int> FieldModel::getClosestCorner(const Vector2<int>& point, LinePercept::Intersection::IntersectionType type, double dir) const
+void FieldModel::getClosestCorners(int numberOfPoints, const int* x, const int* y, 
+                                   LinePercept::Intersection::IntersectionType type,
+                                   const double* angle, double dir,
+                                   int* closestX, int* closestY) const
 {
   if(type == LinePercept::Intersection::X)
-    return fieldDimensions->corners[FieldDimensions::xCorner].getClosest(point);
+  {
+    const FieldDimensions::CornersTable& xCorners = fieldDimensions->corners[FieldDimensions::xCorner];
+    for(int i = 0; i < numberOfPoints; ++i)
+    {
+      const Vector2<int>& closest = xCorners.getClosest(Vector2<int>(x[i], y[i]));
+      closestX[i] = closest.x;
+      closestY[i] = closest.y;
+    }
+  }
   else
   {
-    int index = (int) floor(dir / pi_2 + 0.5) & 3;
-    return (type == LinePercept::Intersection::T ? tCornersTables[index] : lCornersTables[index]).getClosestPoint(point);
+    const ClosestPointsTable<310, 225, 24>* tables = type == LinePercept::Intersection::T ? tCornersTables : lCornersTables;
+    for(int i = 0; i < numberOfPoints; ++i)
+    {
+      const int index = (int) floor((angle[i] + dir) / pi_2 + 0.5) & 3;
+      const Vector2<int> closest = tables[index].getClosestPoint(Vector2<int>(x[i], y[i]));
+      closestX[i] = closest.x;
+      closestY[i] = closest.y;
+    }
   }
 }
 
@@ -88,11 +234,13 @@ void FieldModel::draw()
 
 template<int xSize,int ySize, int cellSize> 
 void FieldModel::ClosestPointsTable<xSize, ySize, cellSize>::create(
+  std::vector<char>& data,
   const FieldDimensions::LinesTable& table,
   double orientation,
   int numberOfOrientations,
   double minLength)
 {
+  short (*points)[xSize][2] = new short[ySize][xSize][2];
   for(int y = 0; y < ySize; ++y)
     for(int x = 0; x < xSize; ++x)
     {
@@ -102,12 +250,16 @@ void FieldModel::ClosestPointsTable<xSize, ySize, cellSize>::create(
       points[y][x][0] = static_cast<short>(p.x);
       points[y][x][1] = static_cast<short>(p.y);
     }
+  appendBytes(data, points, ySize * xSize * 2 * sizeof(short));
+  delete [] points;
 }
 
 template<int xSize,int ySize, int cellSize> 
 void FieldModel::ClosestPointsTable<xSize, ySize, cellSize>::create(
+  std::vector<char>& data,
   const FieldDimensions::CornersTable& table)
 {
+  short (*points)[xSize][2] = new short[ySize][xSize][2];
   for(int y = 0; y < ySize; ++y)
     for(int x = 0; x < xSize; ++x)
     {
@@ -116,4 +268,17 @@ void FieldModel::ClosestPointsTable<xSize, ySize, cellSize>::create(
       points[y][x][0] = static_cast<short>(p.x);
       points[y][x][1] = static_cast<short>(p.y);
     }
+  appendBytes(data, points, ySize * xSize * 2 * sizeof(short));
+  delete [] points;
+}
+
+template<int xSize,int ySize, int cellSize> 
+bool FieldModel::ClosestPointsTable<xSize, ySize, cellSize>::use(const char*& data, const char* end)
+{
+  const size_t size = ySize * xSize * 2 * sizeof(short);
+  if((size_t) (end - data) < size)
+    return false;
+  points = (const short (*)[xSize][2]) data;
+  data += size;
+  return true;
 }
@@ -10,41 +10,63 @@
 
 #include "Representations/Configuration/FieldDimensions.h"
 #include "Representations/Perception/LinePercept.h"
+#include "Platform/MappedFile.h"
+#include <vector>
 
 /**
 * @class FieldModel
 * A class representing the tables required for mapping observations of a 
 * certain class to the closest positions in the field model.
+* The tables are cached in the file fieldModel.tab, which is mapped into
+* memory. The file is keyed on the field dimensions and the parameters the
+* tables depend on. If it is missing or does not match, the tables are
+* computed and the file is written again.
 */
 class FieldModel
 {
 private:
   /**
   * The class realizes a table of closest points on the field model.
+  * Each cell contains its closest point, so a lookup only reads a single cell.
   */
   template<int xSize, int ySize, int cellSize> class ClosestPointsTable
   {
   private:
-    short points[ySize][xSize][2]; /**< The table. For each [y][x] position a x- ([0]) and a y-coordinate ([1]). */
+    const short (*points)[xSize][2]; /**< For each [y][x] position the closest point. Each has a x- ([0]) and a y-coordinate ([1]). */
 
   public:
+    /** Constructor. */
+    ClosestPointsTable() : points(0) {}
+
     /**
-    * The method creates the table.
+    * The method creates the table and appends it to a block of data.
+    * @param data The data the table is appended to.
     * @param table The table of lines the closest points will be searched in.
     * @param orientation The orientation of the lines that are considered.
     * @param numberOfOrientations How many different orientations will be distinguished between?
     * @param minLength The minimum length of lines to be considered.
     */
-    void create(const FieldDimensions::LinesTable& table,
-                double orientation,
-                int numberOfOrientations,
-                double minLength);
+    static void create(std::vector<char>& data,
+                       const FieldDimensions::LinesTable& table,
+                       double orientation,
+                       int numberOfOrientations,
+                       double minLength);
 
     /**
-    * The method creates the table.
+    * The method creates the table and appends it to a block of data.
+    * @param data The data the table is appended to.
     * @param table The table of corners the closest points will be searched in.
     */
-    void create(const FieldDimensions::CornersTable& table);
+    static void create(std::vector<char>& data, const FieldDimensions::CornersTable& table);
+
+    /**
+    * The method lets the table use the data at a certain memory location,
+    * e.g. in a mapped file. The data must have been created by create().
+    * @param data The start of the data. It is advanced to the end of the table.
+    * @param end The end of the memory that is available.
+    * @return Was the table complete?
+    */
+    bool use(const char*& data, const char* end);
 
     /**
     * The method returns the closest line point to the given point.
@@ -80,18 +102,6 @@ private:
           LINE("module:SelfLocator:fieldModel", x1, y1, closest.x, closest.y, 1, Drawings::ps_solid, ColorClasses::black);
         }
     }
-
-    /**
-    * The method writes the table to a stream.
-    * @param stream The stream the table is written to.
-    */
-    void write(Out& stream) const {stream.write(points, sizeof(points));}
-
-    /**
-    * The method reads the table from a stream.
-    * @param stream The stream the table is read from.
-    */
-    void read(In& stream) {stream.read(points, sizeof(points));}
   };
 
   ClosestPointsTable<310, 225, 24> linePointsTables[2][2], /**< The tables line points [all, long][along, across]. */
@@ -99,45 +109,91 @@ private:
                                    lCornersTables[4]; /**< The tables for all L-corners. */
   const FieldDimensions* fieldDimensions; /**< The field dimensions. They must be set using method init(). */
   const int* maxCrossingLength; /**< The maximum length of "short" lines. Must be set using method init(). */
+  MappedFile file; /**< The file the tables are mapped from. */
+  std::vector<char> buffer; /**< The tables if they could not be mapped from the file. */
+  unsigned key; /**< The key of the tables currently used. 0 if there are none. */
+
+  enum {magic = 0x334d4621}; /**< The first word of the file. Changes when its format changes. */
+
+  /**
+  * The method computes the key of the tables from the field dimensions, 
+  * the maximum length of "short" lines, and the layout of the tables.
+  * @return The key.
+  */
+  unsigned computeKey() const;
+
+  /**
+  * The method maps the tables from the file.
+  * @return Did the file exist and did it contain the tables for the current key?
+  */
+  bool load();
+
+  /**
+  * The method lets all tables use the data at a certain memory location.
+  * @param data The start of the data, i.e. the contents of the file.
+  * @param end The end of the data.
+  * @param key The key the data must have been created for.
+  * @return Did the data contain all tables for the key?
+  */
+  bool use(const char* data, const char* end, unsigned key);
 
 public:
   /**
-  * Constructor. Loads the field model tables from disk.
+  * Constructor.
   */
   FieldModel();
 
   /**
   * The method must be called before other methods are used for the first time.
+  * It maps the tables from disk. If they do not match the parameters, they are
+  * created first.
   * @param fieldDimensions The field dimensions (from the blackboard).
   * @param maxCrossingLength The selflocator parameter for the maximum length of "short" lines.
   */
   void init(const FieldDimensions& fieldDimensions, const int& maxCrossingLength);
 
   /**
-  * The method creates the field model tables and writes them to disk.
+  * The method creates the field model tables, writes them to disk, and maps them again.
   */
   void create();
 
   /**
-  * The method determines the point in the field line model closest to a given point.
-  * @param point The point the closest point in the field line model is searched for.
-  * @param neighbor A neighbor of the point. It is used to determine the orientation 
-  *                 of the line. Only lines in the field line model are considered
-  *                 that have a similar orientation (along/across field).
-  * @param length2 The squared length of the line the point belongs to. This is used
+  * The method determines the points in the field line model closest to a number of
+  * given points. All points must belong to lines of the same length, i.e. they are
+  * usually the positions of the same observation relative to different samples.
+  * @param numberOfPoints The number of points.
+  * @param x The x coordinates of the points the closest points in the field line model are searched for.
+  * @param y The y coordinates of these points.
+  * @param neighborX The x coordinates of a neighbor of each point. They are used to determine 
+  *                  the orientation of the line. Only lines in the field line model are considered
+  *                  that have a similar orientation (along/across field).
+  * @param neighborY The y coordinates of the neighbors.
+  * @param length2 The squared length of the line the points belong to. This is used
   *                to distinguish between short and long lines in the field line model.
-  * @return The matching point in the field line model.
+  * @param closestX The x coordinates of the matching points in the field line model are returned here.
+  * @param closestY The y coordinates of the matching points are returned here.
   */
-  const Vector2<int> getClosestLinePoint(const Vector2<int>& point, const Vector2<int>& neighbor, int length2) const;
+  void getClosestLinePoints(int numberOfPoints, const int* x, const int* y, 
+                            const int* neighborX, const int* neighborY, int length2,
+                            int* closestX, int* closestY) const;
 
   /**
-  * The method determines the corner in the corner model closest to a given point.
-  * @param point The point the closest corner in the field line model is searched for.
+  * The method determines the corners in the corner model closest to a number of given points.
+  * All points must belong to corners of the same type.
+  * @param numberOfPoints The number of points.
+  * @param x The x coordinates of the points the closest corners in the field line model are searched for.
+  * @param y The y coordinates of these points.
   * @param type What kind of corner is searched for (X, T, L)?
-  * @param dir The direction of the first axis of the corner (ignored for X-corners).
-  * @return The matching corner in the corner model.
+  * @param angle The rotations of the frames of reference the points were mapped from.
+  * @param dir The direction of the first axis of the corner relative to these rotations 
+  *            (ignored for X-corners).
+  * @param closestX The x coordinates of the matching corners in the corner model are returned here.
+  * @param closestY The y coordinates of the matching corners are returned here.
   */
-  const Vector2<int> getClosestCorner(const Vector2<int>& point, LinePercept::Intersection::IntersectionType type, double dir) const;
+  void getClosestCorners(int numberOfPoints, const int* x, const int* y, 
+                         LinePercept::Intersection::IntersectionType type,
+                         const double* angle, double dir,
+                         int* closestX, int* closestY) const;
 
   /**
   * The method draws one of the field model tables. 
@@ -31,12 +31,12 @@ public:
   {}
 
   /** Function for computing weightings for a sample set.
-  * @param samples The samples (not changed by this function
+  * @param samples The poses of the samples
   * @param selectedIndices The indices of the selected observations.
   * @param weightings List of weightings. -1 means: no update
   * @return An overall result of the computation
   */
-  SensorModelResult computeWeightings(const SampleSet<SelfLocatorSample>& samples,
+  SensorModelResult computeWeightings(const SelfLocatorSampleArrays& samples,
     const std::vector<int>& selectedIndices, std::vector<double>& weightings)
   {
     bool updated(false);
@@ -67,18 +67,16 @@ public:
         // Iterate over all samples and compute weightings:
         for(int i = 0; i < samples.size(); ++i)
         {
-          const SelfLocatorSample& s(samples.at(i));
-          const Pose2D sPose(s.angle, s.translation.x, s.translation.y);
           if(updated)
-            weightings[i] *= computeAngleWeighting(angleObserved, uniquePosition, sPose, 
+            weightings[i] *= computeAngleWeighting(angleObserved, uniquePosition, samples, i, 
               theSelfLocatorParameter.standardDeviationGoalpostAngle, bestPossibleAngleWeighting);
           else
-            weightings[i] = computeAngleWeighting(angleObserved, uniquePosition, sPose, 
+            weightings[i] = computeAngleWeighting(angleObserved, uniquePosition, samples, i, 
               theSelfLocatorParameter.standardDeviationGoalpostAngle, bestPossibleAngleWeighting);
           if(post.distanceType != GoalPost::IS_CLOSER)
           {
             weightings[i] *= computeDistanceWeighting(distanceAsAngleObserved, uniquePosition, 
-              sPose, camZ, distanceStdDev, bestPossibleDistanceWeighting);
+              samples, i, camZ, distanceStdDev, bestPossibleDistanceWeighting);
           }
         }
         updated = true;
@@ -112,20 +110,18 @@ public:
         // Iterate over all samples and compute weightings:
         for(int i = 0; i < samples.size(); ++i)
         {
-          const SelfLocatorSample& s(samples.at(i));
-          const Pose2D sPose(s.angle, s.translation.x, s.translation.y);
           double weighting0 = computeAngleWeighting(angleObserved, 
-            uniquePositions[0], sPose, theSelfLocatorParameter.standardDeviationGoalpostAngle, 
+            uniquePositions[0], samples, i, theSelfLocatorParameter.standardDeviationGoalpostAngle, 
             bestPossibleAngleWeighting);
           double weighting1 = computeAngleWeighting(angleObserved, 
-            uniquePositions[1], sPose, theSelfLocatorParameter.standardDeviationGoalpostAngle, 
+            uniquePositions[1], samples, i, theSelfLocatorParameter.standardDeviationGoalpostAngle, 
             bestPossibleAngleWeighting);
           if(post.distanceType != GoalPost::IS_CLOSER)
           {
             weighting0 *= computeDistanceWeighting(distanceAsAngleObserved, uniquePositions[0], 
-              sPose, camZ, distanceStdDev, bestPossibleDistanceWeighting);
+              samples, i, camZ, distanceStdDev, bestPossibleDistanceWeighting);
             weighting1 *= computeDistanceWeighting(distanceAsAngleObserved, uniquePositions[1], 
-              sPose, camZ, distanceStdDev, bestPossibleDistanceWeighting);
+              samples, i, camZ, distanceStdDev, bestPossibleDistanceWeighting);
           }
           if(updated)
             weightings[i] *= std::max(weighting0, weighting1);
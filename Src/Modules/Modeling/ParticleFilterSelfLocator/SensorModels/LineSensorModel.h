@@ -18,10 +18,17 @@ class LineSensorModel: public SensorModel
 {
 private:
   const std::vector<const LinePercept::Line*>& lines; /**< Reference to the lines. */
-  std::vector<short> selectedIndices; /**< The indices of the points in the points percept that were selected for the sensor update. */
-  std::vector< std::pair<short,double> > selectedIndicesPositions; /**< Precomputed information (distance+angle) about selected points */
   GaussianTable gaussian; /**< A table of Gaussians for assessing bearing measurements to points. */
   const FieldModel& fieldModel; /**< The model of proximity to features on the field. */
+  std::vector<unsigned char> inGoalNet; /**< For each sample: Might any of the points have been confused with the goal net? */
+  std::vector<int> camRotationX, /**< For each sample: The cosinus of the rotation of the camera on the field multiplied by 1024. */
+                   camRotationY, /**< For each sample: The sinus of the rotation of the camera on the field multiplied by 1024. */
+                   pObsX, /**< For each sample: The x coordinate of the observed point on the field. */
+                   pObsY, /**< For each sample: The y coordinate of the observed point on the field. */
+                   pOtherX, /**< For each sample: The x coordinate of the other end of the line on the field. */
+                   pOtherY, /**< For each sample: The y coordinate of the other end of the line on the field. */
+                   pModelX, /**< For each sample: The x coordinate of the closest point in the field model. */
+                   pModelY; /**< For each sample: The y coordinate of the closest point in the field model. */
 
 public:
   /** Constructor. */
@@ -36,12 +43,12 @@ public:
   {}
 
   /** Function for computing weightings for a sample set.
-  * @param samples The samples (not changed by this function
+  * @param samples The poses of the samples
   * @param selectedIndices The indices of the selected observations.
   * @param weightings List of weightings. -1 means: no update
   * @return An overall result of the computation
   */
-  SensorModelResult computeWeightings(const SampleSet<SelfLocatorSample>& samples,
+  SensorModelResult computeWeightings(const SelfLocatorSampleArrays& samples,
     const std::vector<int>& selectedIndices, std::vector<double>& weightings)
   {
     // Precompute some values
@@ -51,63 +58,75 @@ public:
     int rotCos  = int(floor(cos(origin.rotation) * (1 << 10) + 0.5));
     int rotSin  = int(floor(sin(origin.rotation) * (1 << 10) + 0.5));
     gaussian.computeTable(1000, 200, theSelfLocatorParameter.standardDeviationFieldLines, theSelfLocatorParameter.standardDeviationFieldLines, 1);
-    selectedIndicesPositions.resize(selectedIndices.size());
-    for(int j = 0; j < (int) selectedIndices.size(); ++j)
+
+    const int numberOfSamples = samples.size();
+    const int* x = &samples.x[0];
+    const int* y = &samples.y[0];
+    const int* sampleCos = &samples.cosAngle[0];
+    const int* sampleSin = &samples.sinAngle[0];
+    inGoalNet.assign(numberOfSamples, 0);
+    camRotationX.resize(numberOfSamples);
+    camRotationY.resize(numberOfSamples);
+    pObsX.resize(numberOfSamples);
+    pObsY.resize(numberOfSamples);
+    pOtherX.resize(numberOfSamples);
+    pOtherY.resize(numberOfSamples);
+    pModelX.resize(numberOfSamples);
+    pModelY.resize(numberOfSamples);
+    for(int i = 0; i < numberOfSamples; ++i)
     {
-      const Vector2<int>& pp = selectedIndices[j] & 1 ? lines[selectedIndices[j] >> 1]->first 
-                                                      : lines[selectedIndices[j] >> 1]->last;
-      const double angle = pp.angle();
-      const short distance = static_cast<short>(pp.abs());
-      selectedIndicesPositions[j] = std::make_pair(distance, angle);
+      camRotationX[i] = (rotCos * sampleCos[i] - rotSin * sampleSin[i]) >> 10;
+      camRotationY[i] = (rotCos * sampleSin[i] + rotSin * sampleCos[i]) >> 10;
+      weightings[i] = 1.0;
     }
-    SensorModelResult result = FULL_SENSOR_UPDATE;
-    for(int i = 0; i < samples.size(); ++i)
+
+    bool partial = false;
+    for(int j = 0; j < (int) selectedIndices.size(); ++j)
     {
-NEXT_SAMPLE:
-      const SelfLocatorSample& s(samples.at(i));
-      const Vector2<int> origin(int(s.translation.x), int(s.translation.y)),
-                         camRotation((rotCos * s.rotation.x - rotSin * s.rotation.y) >> 10,
-                                     (rotCos * s.rotation.y + rotSin * s.rotation.x) >> 10);
+      const Vector2<int>& pp = selectedIndices[j] & 1 ? lines[selectedIndices[j] >> 1]->first 
+                                                      : lines[selectedIndices[j] >> 1]->last,
+                        & other = selectedIndices[j] & 1 ? lines[selectedIndices[j] >> 1]->last 
+                                                         : lines[selectedIndices[j] >> 1]->first;
+      if(thePerceptValidityChecker.markPointsProbablyInGoalNet(samples, 
+        static_cast<short>(pp.abs()), pp.angle(), inGoalNet))
+        partial = true;
 
-      weightings[i] = 1.0;
-      for(int j = 0; j < (int) selectedIndices.size(); ++j)
+      // Map the observation to the field for all samples
+      for(int i = 0; i < numberOfSamples; ++i)
       {
-        if(thePerceptValidityChecker.pointIsProbablyInGoalNet(s.toPose(), 
-          selectedIndicesPositions[j].first, selectedIndicesPositions[j].second))
-        {
-          weightings[i] = -1;
-          result = PARTIAL_SENSOR_UPDATE;
-          ++i;
-          if(i<samples.size())
-            goto NEXT_SAMPLE;
-          else 
-            goto FINISHED;
-        }
-        const Vector2<int>& pp = selectedIndices[j] & 1 ? lines[selectedIndices[j] >> 1]->first 
-                                                      : lines[selectedIndices[j] >> 1]->last,
-                           pObs(origin.x + ((pp.x * s.rotation.x - pp.y * s.rotation.y) >> 10),
-                                origin.y + ((pp.x * s.rotation.y + pp.y * s.rotation.x) >> 10)),
-                         & other = selectedIndices[j] & 1 ? lines[selectedIndices[j] >> 1]->last 
-                                                          : lines[selectedIndices[j] >> 1]->first,
-                           pOther(origin.x + ((other.x * s.rotation.x - other.y * s.rotation.y) >> 10),
-                                  origin.y + ((other.x * s.rotation.y + other.y * s.rotation.x) >> 10)),
-                           pModel = fieldModel.getClosestLinePoint(pObs, pOther, sqr(pp - other)),
-                           diffOnField = pModel - pObs,
-                           diffFromCamera((diffOnField.x * camRotation.x + diffOnField.y * camRotation.y) >> 10,
-                                          (diffOnField.y * camRotation.x - diffOnField.x * camRotation.y) >> 10),
-                           ppWithoutOffset(pp.x - xOrigin, pp.y - yOrigin),
-                           ppFromCamera((ppWithoutOffset.x * rotCos + ppWithoutOffset.y * rotSin) >> 10,
-                                        (ppWithoutOffset.y * rotCos - ppWithoutOffset.x * rotSin) >> 10);
+        pObsX[i] = x[i] + ((pp.x * sampleCos[i] - pp.y * sampleSin[i]) >> 10);
+        pObsY[i] = y[i] + ((pp.x * sampleSin[i] + pp.y * sampleCos[i]) >> 10);
+        pOtherX[i] = x[i] + ((other.x * sampleCos[i] - other.y * sampleSin[i]) >> 10);
+        pOtherY[i] = y[i] + ((other.x * sampleSin[i] + other.y * sampleCos[i]) >> 10);
+      }
+      fieldModel.getClosestLinePoints(numberOfSamples, &pObsX[0], &pObsY[0], &pOtherX[0], &pOtherY[0],
+                                      sqr(pp - other), &pModelX[0], &pModelY[0]);
+
+      // The position relative to the camera is the same for all samples
+      const Vector2<int> ppWithoutOffset(pp.x - xOrigin, pp.y - yOrigin),
+                         ppFromCamera((ppWithoutOffset.x * rotCos + ppWithoutOffset.y * rotSin) >> 10,
+                                      (ppWithoutOffset.y * rotCos - ppWithoutOffset.x * rotSin) >> 10);
+      const int distanceDivisor = std::abs(ppFromCamera.x) + 450;
+      for(int i = 0; i < numberOfSamples; ++i)
+      {
+        const Vector2<int> diffOnField(pModelX[i] - pObsX[i], pModelY[i] - pObsY[i]),
+                           diffFromCamera((diffOnField.x * camRotationX[i] + diffOnField.y * camRotationY[i]) >> 10,
+                                          (diffOnField.y * camRotationX[i] - diffOnField.x * camRotationY[i]) >> 10);
         weightings[i] *= gaussian.value(
-          std::abs(1024 * diffFromCamera.x / (std::abs(ppFromCamera.x) + 450)),
+          std::abs(1024 * diffFromCamera.x / distanceDivisor),
           theSelfLocatorParameter.standardDeviationFieldLines);
         weightings[i] *= gaussian.value(
           ppFromCamera.x != 0 ? std::abs(1024 * diffFromCamera.y / ppFromCamera.x) : 0,
           theSelfLocatorParameter.standardDeviationFieldLines);
       }
     }
-FINISHED:
-    return result;
+
+    // Samples for which any point might be a part of the goal net are not updated
+    if(partial)
+      for(int i = 0; i < numberOfSamples; ++i)
+        if(inGoalNet[i])
+          weightings[i] = -1;
+    return partial ? PARTIAL_SENSOR_UPDATE : FULL_SENSOR_UPDATE;
   }
 };
 
@@ -129,19 +129,28 @@ void PerceptValidityChecker::GoalNetTable::compute()
   }
 }
 
-short PerceptValidityChecker::GoalNetTable::getMaxDistanceForPoseAndAngle(
-  const Pose2D& robotPose, double angle) const
+bool PerceptValidityChecker::GoalNetTable::markSamplesBeyondMaxDistance(
+  const SelfLocatorSampleArrays& samples, short distance, double angle, 
+  std::vector<unsigned char>& inNet) const
 {
   const double sectorSize(pi2 / GOAL_NET_TABLE_RES_ANGLE);
-  const int xIndex = (static_cast<int>(robotPose.translation.x) + halfFieldLength) / GOAL_NET_TABLE_CELL_SIZE;
-  const int yIndex = (static_cast<int>(robotPose.translation.y) + halfFieldWidth) / GOAL_NET_TABLE_CELL_SIZE;
-  double totalAngle(robotPose.rotation + angle);
-  while(totalAngle < 0.0)
-    totalAngle += pi2;
-  while(totalAngle >= pi2)
-    totalAngle -= pi2;
-  int angleIndex = static_cast<int>(totalAngle / sectorSize);
-  return maxValidDistances[xIndex][yIndex][angleIndex];
+  const int numberOfSamples = samples.size();
+  unsigned char marked = 0;
+  for(int i = 0; i < numberOfSamples; ++i)
+  {
+    const int xIndex = (samples.x[i] + halfFieldLength) / GOAL_NET_TABLE_CELL_SIZE;
+    const int yIndex = (samples.y[i] + halfFieldWidth) / GOAL_NET_TABLE_CELL_SIZE;
+    double totalAngle(samples.angle[i] + angle);
+    while(totalAngle < 0.0)
+      totalAngle += pi2;
+    while(totalAngle >= pi2)
+      totalAngle -= pi2;
+    const int angleIndex = static_cast<int>(totalAngle / sectorSize);
+    const unsigned char beyond = distance > maxValidDistances[xIndex][yIndex][angleIndex];
+    inNet[i] |= beyond;
+    marked |= beyond;
+  }
+  return marked != 0;
 }
 
 PerceptValidityChecker::GoalNetTable::GoalNetTable(
@@ -12,6 +12,7 @@
 #define _PerceptValidityChecker_h_
 
 #include "Tools/Math/Pose2D.h"
+#include "Tools/SampleSet.h"
 
 
 /**
@@ -56,12 +57,17 @@ protected:
     /** Draws the table to the field view */
     void draw();
 
-    /** looks up distance for a pose and an angle to a point
-    * @param robotPose The robot's position and translation (aka sample pose)
+    /** Marks all samples for which a perceived point is farther away than the
+    * maximum distance that is not a part of the net
+    * @param samples The samples
+    * @param distance The distance to the perceived point
     * @param angle The angle to the perceived point
-    * @return the maximum distance that is not a part of the net
+    * @param inNet A flag for each sample. It is set for all samples for which the
+    *              point is probably in the goal net. Other flags are not changed.
+    * @return Was any flag set?
     */
-    short getMaxDistanceForPoseAndAngle(const Pose2D& robotPose, double angle) const;
+    bool markSamplesBeyondMaxDistance(const SelfLocatorSampleArrays& samples,
+      short distance, double angle, std::vector<unsigned char>& inNet) const;
 
     /** Constructor 
     * @param halfLength The length of a half field
@@ -88,15 +94,18 @@ public:
         theFieldDimensions.xPosOpponentGoalpost) 
       {}
 
-  /** Checks, if a perceived point is valid, i.e. not confused with the goal net
-  * @param robotPose The robot's position and translation (aka sample pose)
+  /** Checks for all samples, if a perceived point is valid, i.e. not confused with the goal net
+  * @param samples The samples
   * @param distance The distance to the perceived point
   * @param angle The angle to the perceived point
-  * @return true, if point might be a part of the goal net
+  * @param inGoalNet A flag for each sample. It is set for all samples for which the
+  *                  point might be a part of the goal net. Other flags are not changed.
+  * @return true, if the point might be a part of the goal net for any sample
   */
-  bool pointIsProbablyInGoalNet(const Pose2D& robotPose, short distance, double angle) const
+  bool markPointsProbablyInGoalNet(const SelfLocatorSampleArrays& samples, 
+    short distance, double angle, std::vector<unsigned char>& inGoalNet) const
   {
-    return distance > goalNetTable.getMaxDistanceForPoseAndAngle(robotPose, angle);
+    return goalNetTable.markSamplesBeyondMaxDistance(samples, distance, angle, inGoalNet);
   }
 
   /** Wrapper for saving the GoalNetTable data */
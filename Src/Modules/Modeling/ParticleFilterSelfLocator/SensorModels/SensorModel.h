@@ -32,31 +32,33 @@ protected:
   /** Computes a weighting for the angle difference between model and observation
   * @param measuredAngle The measured value
   * @param modelPosition The position of the sensed object in the global frame of reference
-  * @param robotPose The pose of the robot (or the sample)
+  * @param samples The poses of the samples
+  * @param i The index of the sample
   * @param standardDeviation The standard deviation to become applied
   * @param bestPossibleWeighting Used for scaling to [0..1]
   * @return A weighting [0..1]
   */
   double computeAngleWeighting(double measuredAngle, const Vector2<double>& modelPosition,
-    const Pose2D& robotPose, double standardDeviation, double bestPossibleWeighting)
+    const SelfLocatorSampleArrays& samples, int i, double standardDeviation, double bestPossibleWeighting)
   {
-    const double modelAngle = Geometry::angleTo(robotPose, modelPosition);
+    const double modelAngle = normalize(atan2(modelPosition.y - samples.y[i], modelPosition.x - samples.x[i]) - samples.angle[i]);
     return gaussianProbability(fabs(modelAngle-measuredAngle), standardDeviation) / bestPossibleWeighting;
   }
 
   /** Computes a weighting for the distance difference (described as angle) between model and observation
   * @param measuredDistanceAsAngle The angle between the vertical axis through the robot and the ray to the object
   * @param modelPosition The position of the sensed object in the global frame of reference
-  * @param robotPose The pose of the robot (or the sample)
+  * @param samples The poses of the samples
+  * @param i The index of the sample
   * @param cameraZ The height of the camera
   * @param standardDeviation The standard deviation to become applied
   * @param bestPossibleWeighting Used for scaling to [0..1]
   * @return A weighting [0..1]
   */
   double computeDistanceWeighting(double measuredDistanceAsAngle, const Vector2<double>& modelPosition,
-    const Pose2D& robotPose, double cameraZ, double standardDeviation, double bestPossibleWeighting)
+    const SelfLocatorSampleArrays& samples, int i, double cameraZ, double standardDeviation, double bestPossibleWeighting)
   {
-    const double modelDistance = (robotPose.translation - modelPosition).abs();
+    const double modelDistance = Vector2<double>(samples.x[i] - modelPosition.x, samples.y[i] - modelPosition.y).abs();
     const double modelDistanceAsAngle = (pi_2 - atan2(cameraZ,modelDistance));
     return gaussianProbability(fabs(modelDistanceAsAngle-measuredDistanceAsAngle), 
       standardDeviation) / bestPossibleWeighting;
@@ -111,12 +113,13 @@ public:
   virtual ~SensorModel() {}
 
   /** Function for computing weightings for a sample set.
-  * @param samples The samples (not changed by this function
+  * The samples are processed one observation at a time.
+  * @param samples The poses of the samples
   * @param selectedIndices The indices of the selected observations.
   * @param weightings List of weightings. -1 means: no update
   * @return An overall result of the computation
   */
-  virtual SensorModelResult computeWeightings(const SampleSet<SelfLocatorSample>& samples,
+  virtual SensorModelResult computeWeightings(const SelfLocatorSampleArrays& samples,
     const std::vector<int>& selectedIndices, std::vector<double>& weightings) = 0;
 };
 
@@ -604,10 +604,7 @@ bool BallPerceptor::findEndOfBall
     }
     else
     {
-      currentColorClass = (ColorClasses::Color) theColorTable64.colorClasses
-        [theImage.image[destination.y][destination.x].y >> 2]
-        [theImage.image[destination.y][destination.x].cb >> 2]
-        [theImage.image[destination.y][destination.x].cr >> 2];
+      currentColorClass = theColorClassPlane.getColor(destination.x, destination.y, theImage, theColorTable64);
 
       // counting all orange pixels on the scanned horz./vert./diag. lines
       len++;
@@ -914,10 +911,7 @@ void BallPerceptor::checkCurrentBall
       double scanAngle = 0;
       ColorClasses::Color currentColor;
       Geometry::clipPointInsideRectangle(Vector2<int>(0,0), Vector2<int>(theImage.cameraInfo.resolutionWidth - 1, theImage.cameraInfo.resolutionHeight - 1), clippedCenter);
-      currentColor = (ColorClasses::Color) theColorTable64.colorClasses
-        [theImage.image[clippedCenter.y][clippedCenter.x].y >> 2]
-        [theImage.image[clippedCenter.y][clippedCenter.x].cb >> 2]
-        [theImage.image[clippedCenter.y][clippedCenter.x].cr >> 2];
+      currentColor = theColorClassPlane.getColor(clippedCenter.x, clippedCenter.y, theImage, theColorTable64);
       if(currentColor == ColorClasses::orange)
         orangeCount++;
       totalCount++;
@@ -930,10 +924,7 @@ void BallPerceptor::checkCurrentBall
         for (int i=0; i<steps && i<scan.numberOfPixels; i++)
         {
           scan.getNext(current);
-          currentColor = (ColorClasses::Color) theColorTable64.colorClasses
-            [theImage.image[current.y][current.x].y >> 2]
-            [theImage.image[current.y][current.x].cb >> 2]
-            [theImage.image[current.y][current.x].cr >> 2];
+          currentColor = theColorClassPlane.getColor(current.x, current.y, theImage, theColorTable64);
           if(currentColor == ColorClasses::orange)
             orangeCount++;
           totalCount++;
@@ -28,10 +28,12 @@
 #include "Representations/Perception/BallPercept.h"
 #include "Representations/Modeling/RobotPose.h"
 #include "Representations/Perception/BodyContour.h"
+#include "Representations/Perception/ColorClassPlane.h"
 #include "Tools/ImageProcessing/ColorModelConversions.h"
 
 MODULE(BallPerceptor)
   REQUIRES(ColorTable64)
+  REQUIRES(ColorClassPlane)
   REQUIRES(FieldDimensions)
   REQUIRES(Image)
   REQUIRES(CameraMatrix)
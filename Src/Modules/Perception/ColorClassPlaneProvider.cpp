@@ -0,0 +1,129 @@
+/**
+* @file ColorClassPlaneProvider.cpp
+* This file implements a module that classifies the pixels on the scan grid
+* of the image once per frame.
+*/
+
+#include "ColorClassPlaneProvider.h"
+#include "Tools/Streams/InStreams.h"
+#include "Tools/Debugging/Stopwatch.h"
+
+/** Adapter to classify packed pixels with the ColorTable64. */
+class ColorTable64Lookup
+{
+public:
+  const unsigned char (*colorClasses)[64][64]; /**< The color table. */
+
+  ColorTable64Lookup(const ColorTable64& colorTable) : colorClasses(colorTable.colorClasses) {}
+
+  unsigned char getColorClass(unsigned col) const
+  {
+    return colorClasses[col >> 18 & 0x3f][col >> 10 & 0x3f][col >> 26 & 0x3f];
+  }
+};
+
+/** Adapter to classify packed pixels with the CompactColorTable64. */
+class CompactColorTable64Lookup
+{
+public:
+  const CompactColorTable64& colorTable; /**< The color table. */
+
+  CompactColorTable64Lookup(const CompactColorTable64& colorTable) : colorTable(colorTable) {}
+
+  unsigned char getColorClass(unsigned col) const
+  {
+    return (unsigned char) colorTable.getColorClass((unsigned char) (col >> 16), (unsigned char) (col >> 8), (unsigned char) (col >> 24));
+  }
+};
+
+ColorClassPlaneProvider::ColorClassPlaneProvider() : numOfColumns(0)
+{
+  InConfigFile stream("colorClassPlane.cfg", "default");
+  ASSERT(stream.exists());
+  stream >> parameters;
+  layoutParameters.gridStepSize = layoutParameters.exploreStepSize = layoutParameters.rowStepSize = -1;
+}
+
+void ColorClassPlaneProvider::updateLayout(ColorClassPlane& colorClassPlane)
+{
+  const int width = theImage.cameraInfo.resolutionWidth,
+            height = theImage.cameraInfo.resolutionHeight;
+  colorClassPlane.width = width;
+  colorClassPlane.height = height;
+  memset(colorClassPlane.classifiedColumns, 0, sizeof(colorClassPlane.classifiedColumns));
+  memset(colorClassPlane.classifiedRows, 0, sizeof(colorClassPlane.classifiedRows));
+
+  // same grid as in Regionizer::scanVertically, plus the columns explored by PointExplorer::explorePoint
+  if(parameters.gridStepSize > 0)
+    for(int x = parameters.gridStepSize - 1 + (width % parameters.gridStepSize) / 2; x < width; x += parameters.gridStepSize)
+    {
+      colorClassPlane.classifiedColumns[x] = 1;
+      if(parameters.exploreStepSize > 0)
+        for(int xExplore = x - parameters.exploreStepSize; xExplore > std::max(0, x - parameters.gridStepSize); xExplore -= parameters.exploreStepSize)
+          colorClassPlane.classifiedColumns[xExplore] = 1;
+    }
+
+  // same rows as in Regionizer::scanHorizontally
+  if(parameters.rowStepSize > 0)
+    for(int y = 0; y < height; y += parameters.rowStepSize)
+      colorClassPlane.classifiedRows[y] = 1;
+
+  numOfColumns = 0;
+  for(int x = 0; x < width; ++x)
+    if(colorClassPlane.classifiedColumns[x])
+      columns[numOfColumns++] = x;
+
+  layoutParameters = parameters;
+}
+
+void ColorClassPlaneProvider::update(ColorClassPlane& colorClassPlane)
+{
+  MODIFY("parameters:ColorClassPlaneProvider", parameters);
+
+  if(!(layoutParameters == parameters) ||
+     colorClassPlane.width != theImage.cameraInfo.resolutionWidth ||
+     colorClassPlane.height != theImage.cameraInfo.resolutionHeight)
+    updateLayout(colorClassPlane);
+
+  if(parameters.useCompactColorTable)
+    classify(colorClassPlane, CompactColorTable64Lookup(theCompactColorTable64));
+  else
+    classify(colorClassPlane, ColorTable64Lookup(theColorTable64));
+
+  DEBUG_RESPONSE("module:ColorClassPlaneProvider:benchmark", benchmark(););
+}
+
+template<class T> void ColorClassPlaneProvider::classify(ColorClassPlane& colorClassPlane, const T& colorTable)
+{
+  const int width = colorClassPlane.width,
+            height = colorClassPlane.height;
+
+  // traverse the image row by row to access it sequentially
+  for(int y = 0; y < height; ++y)
+  {
+    const Image::Pixel* src = theImage.image[y];
+    if(colorClassPlane.classifiedRows[y])
+    {
+      unsigned char* dest = colorClassPlane.rows[y];
+      for(int x = 0; x < width; ++x)
+        dest[x] = colorTable.getColorClass(src[x].color);
+    }
+    for(const int* x = columns, * xEnd = columns + numOfColumns; x < xEnd; ++x)
+      colorClassPlane.columns[*x][y] = colorTable.getColorClass(src[*x].color);
+  }
+}
+
+void ColorClassPlaneProvider::benchmark()
+{
+  // the stopwatch only has a resolution of a millisecond, so segment the image several times
+  STOP_TIME_ON_REQUEST("ColorClassPlaneProvider:ColorTable64", 
+    for(int i = 0; i < 10; ++i)
+      theColorTable64.generateColorClassImage(theImage, benchmarkImage);
+  );
+  STOP_TIME_ON_REQUEST("ColorClassPlaneProvider:CompactColorTable64", 
+    for(int i = 0; i < 10; ++i)
+      theCompactColorTable64.generateColorClassImage(theImage, benchmarkImage);
+  );
+}
+
+MAKE_MODULE(ColorClassPlaneProvider, Perception)
@@ -0,0 +1,111 @@
+/**
+* @file ColorClassPlaneProvider.h
+* This file declares a module that classifies the pixels on the scan grid
+* of the image once per frame.
+*/
+
+#ifndef __ColorClassPlaneProvider_h_
+#define __ColorClassPlaneProvider_h_
+
+#include "Tools/Module/Module.h"
+#include "Representations/Configuration/ColorTable64.h"
+#include "Representations/Configuration/CompactColorTable64.h"
+#include "Representations/Infrastructure/Image.h"
+#include "Representations/Perception/ColorClassPlane.h"
+#include "Representations/Perception/ColorClassImage.h"
+
+MODULE(ColorClassPlaneProvider)
+  REQUIRES(ColorTable64)
+  REQUIRES(CompactColorTable64)
+  REQUIRES(Image)
+  PROVIDES(ColorClassPlane)
+END_MODULE
+
+/**
+* @class ColorClassPlaneProvider
+*
+* The module fills the ColorClassPlane for the columns and rows that are
+* scanned by the Regionizer and the perceptors. The grid must match the one
+* configured in regionizer.cfg, otherwise the lookups just fall back to the
+* color table. If useCompactColorTable is set, the pixels are classified
+* using the CompactColorTable64, which produces the same results, but
+* needs much less cache.
+*/
+class ColorClassPlaneProvider : public ColorClassPlaneProviderBase
+{
+private:
+  /**
+  * @class Parameters
+  * The parameters for the ColorClassPlaneProvider
+  */
+  class Parameters : public Streamable
+  {
+  private:
+    void serialize(In* in, Out* out)
+    {
+      STREAM_REGISTER_BEGIN();
+      STREAM(gridStepSize);
+      STREAM(exploreStepSize);
+      STREAM(rowStepSize);
+      STREAM(useCompactColorTable);
+      STREAM_REGISTER_FINISH();
+    }
+
+  public:
+    int gridStepSize, /**< The distance in pixels between neighboring vertical scan lines. */
+        exploreStepSize, /**< The distance in pixels between exploring scan lines. 0 to classify only the scan lines. */
+        rowStepSize; /**< The distance in pixels between horizontal scan lines. 0 to classify no rows. */
+    bool useCompactColorTable; /**< Classify using the CompactColorTable64 instead of the ColorTable64? */
+
+    /**
+    * Comparison operator.
+    * @param other The parameters this ones are compared to.
+    * @return Are both sets of parameters identical?
+    */
+    bool operator==(const Parameters& other) const
+    {
+      return gridStepSize == other.gridStepSize &&
+             exploreStepSize == other.exploreStepSize &&
+             rowStepSize == other.rowStepSize;
+    }
+  };
+
+  Parameters parameters; /**< The parameters of this module. */
+  Parameters layoutParameters; /**< The parameters the current layout of the plane was computed with. */
+  int columns[cameraResolutionWidth]; /**< The x coordinates of the classified columns. */
+  int numOfColumns; /**< The number of entries in columns. */
+  ColorClassImage benchmarkImage; /**< The color class image segmented when benchmarking the color tables. */
+
+  /** 
+  * Updates the ColorClassPlane.
+  * @param colorClassPlane The representation updated.
+  */
+  void update(ColorClassPlane& colorClassPlane);
+
+  /**
+  * The method determines which columns and rows are classified.
+  * It is only called if the image size or the parameters change.
+  * @param colorClassPlane The plane whose layout is set.
+  */
+  void updateLayout(ColorClassPlane& colorClassPlane);
+
+  /**
+  * The method classifies the columns and rows of the plane.
+  * @param colorClassPlane The plane that is filled.
+  * @param colorTable The color table used for the classification. It must
+  *                   provide the method getColorClass(col) for a packed pixel.
+  */
+  template<class T> void classify(ColorClassPlane& colorClassPlane, const T& colorTable);
+
+  /**
+  * The method segments the current image with both color tables several
+  * times and measures the time required.
+  */
+  void benchmark();
+
+public:
+  /** Default constructor. */
+  ColorClassPlaneProvider();
+};
+
+#endif //__ColorClassPlaneProvider_h_
@@ -62,7 +62,7 @@ void GoalPerceptor::update(GoalPercept& goalPercept)
   int minSegSize[ColorClasses::numOfColors];
   for(int i=0; i<ColorClasses::numOfColors;i++)
     minSegSize[i] = 0;
-  pointExplorer.initFrame(&theImage, &theColorTable64, 0, 0, 4, minSegSize);
+  pointExplorer.initFrame(&theImage, &theColorTable64, &theColorClassPlane, 0, 0, 4, minSegSize);
   detectGoal(oppColor, oppPolePercepts);
   detectGoal(ownColor, ownPolePercepts);
   updateRepresentation(goalPercept, oppPolePercepts, ownPolePercepts);
@@ -894,8 +894,7 @@ int GoalPerceptor::calculateExpectedPixelWidth(Vector2<int> posImg)
 
 ColorClasses::Color GoalPerceptor::convertColorAt(int x, int y)
 {
-  unsigned color(theImage.image[y][x].color);
-  return (ColorClasses::Color) theColorTable64.colorClasses[color >> 18 & 0x3f][color >> 10 & 0x3f][color >> 26 & 0x3f];
+  return theColorClassPlane.getColor(x, y, theImage, theColorTable64);
 }
 
 MAKE_MODULE(GoalPerceptor, Perception)
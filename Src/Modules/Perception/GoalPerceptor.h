@@ -21,6 +21,7 @@
 #include "Representations/Infrastructure/Image.h"
 #include "Representations/Modeling/RobotPose.h"
 #include "Representations/Configuration/ColorTable64.h"
+#include "Representations/Perception/ColorClassPlane.h"
 #include "Representations/Configuration/FieldDimensions.h"
 #include "Representations/Perception/ImageCoordinateSystem.h"
 #include "Tools/RingBufferWithSum.h"
@@ -36,6 +37,7 @@ MODULE(GoalPerceptor)
   REQUIRES(GroundTruthRobotPose)
   USES(RobotPose)
   REQUIRES(ColorTable64)
+  REQUIRES(ColorClassPlane)
   REQUIRES(FrameInfo)
   REQUIRES(OwnTeamInfo) 
   REQUIRES(ImageCoordinateSystem)
@@ -9,6 +9,7 @@
 #include "Tools/Math/Geometry.h"
 #include "Tools/Team.h"
 #include "Tools/Debugging/ReleaseOptions.h"
+#include <algorithm>
 
 LinePerceptor::LinePerceptor()
 {
@@ -358,44 +359,84 @@ void LinePerceptor::createLineSegments(std::list<LinePercept::LineSegment>& sing
   }
 }
 
+void LinePerceptor::Accumulator::init(const std::vector<LinePercept::LineSegment>& lineSegs, double maxAlphaDiff, double maxDDiff)
+{
+  double maxAbsD = 0;
+  for(std::vector<LinePercept::LineSegment>::const_iterator seg = lineSegs.begin(); seg != lineSegs.end(); seg++)
+    if(fabs(seg->d) > maxAbsD)
+      maxAbsD = fabs(seg->d);
+
+  //the cells must not be smaller than the maximum differences, but there should not be too many of them
+  alphaCellSize = std::max(maxAlphaDiff, pi / maxCells);
+  dCellSize = std::max(std::max(maxDDiff, 2 * maxAbsD / maxCells), 1.0);
+  minD = -maxAbsD; //d range is symmetric, so the opposite representations are covered as well
+  alphaCells = (int) (pi / alphaCellSize) + 1;
+  dCells = (int) (2 * maxAbsD / dCellSize) + 1;
+
+  //counting sort of the segments by their cells, the order of the segments within a cell is kept
+  firstInCell.assign(alphaCells * dCells + 1, 0);
+  segments.resize(lineSegs.size());
+  for(std::vector<LinePercept::LineSegment>::const_iterator seg = lineSegs.begin(); seg != lineSegs.end(); seg++)
+    ++firstInCell[getAlphaCell(seg->alpha) * dCells + getDCell(seg->d) + 1];
+  for(int i = 1; i < (int) firstInCell.size(); ++i)
+    firstInCell[i] += firstInCell[i - 1];
+  for(int i = 0; i < (int) lineSegs.size(); ++i)
+    segments[firstInCell[getAlphaCell(lineSegs[i].alpha) * dCells + getDCell(lineSegs[i].d)]++] = i;
+  for(int i = (int) firstInCell.size() - 1; i > 0; --i)
+    firstInCell[i] = firstInCell[i - 1];
+  firstInCell[0] = 0;
+}
+
 void LinePerceptor::createLines(std::list<LinePercept::Line>& lines, std::list<LinePercept::LineSegment>& singleSegs)
 {
-  //Hough Transformation fuer (ganz) arme....
-  while(lineSegs.size() > 0)
+  //Hough Transformation: the segments are sorted into a grid in (alpha, d) space,
+  //so each segment is only compared to the segments in the neighboring cells.
+  const int numOfSegs = (int) lineSegs.size();
+  accumulator.init(lineSegs, parameters.maxAlphaDiff, parameters.maxDDiff);
+  segUsed.assign(numOfSegs, false);
+  segVisited.assign(numOfSegs, -1);
+
+  for(int i = 0; i < numOfSegs; ++i)
   {
+    if(segUsed[i])
+      continue;
+
     //pick a segment...
-    LinePercept::LineSegment seg = *lineSegs.begin();
-    lineSegs.erase(lineSegs.begin());
+    const LinePercept::LineSegment& seg = lineSegs[i];
+    segUsed[i] = true;
 
     ARROW("module:LinePerceptor:Lines1", seg.p1.x, seg.p1.y, seg.p2.x, seg.p2.y, 15, Drawings::ps_solid, ColorClasses::white);
 
-    //collect supporters...
-    std::vector<std::list<LinePercept::LineSegment>::iterator> supporters;
+    //collect supporters from the cells around the segment and around its opposite representation...
+    supporters.clear();
     int maxSegmentLength = 0;
-    for(std::list<LinePercept::LineSegment>::iterator other = lineSegs.begin(); other != lineSegs.end(); other++)
+    for(int opposite = 0; opposite < 2; ++opposite)
     {
-      if((fabs(other->alpha - seg.alpha) < parameters.maxAlphaDiff &&
-         fabs(other->d - seg.d) < parameters.maxDDiff))
-      {
-        const int sqr_length = (other->p1-other->p2).squareAbs();
-        if(sqr_length > maxSegmentLength)
-          maxSegmentLength = sqr_length;
-        supporters.push_back(other);
-      }
-      else if((fabs(fabs(other->alpha - seg.alpha) - pi) < parameters.maxAlphaDiff &&
-         fabs(other->d + seg.d) < parameters.maxDDiff))
-      {
-        const int sqr_length = (other->p1-other->p2).squareAbs();
-        if(sqr_length > maxSegmentLength)
-          maxSegmentLength = sqr_length;
-        //make supporters all look into the same direction (alpha in [0...pi])
-        if(other->alpha > seg.alpha)
-          other->alpha -= pi;
-        else
-          other->alpha += pi;
-        other->d *= -1;
-        supporters.push_back(other);
-      }
+      const int alphaCell = accumulator.getAlphaCell(opposite ? (seg.alpha < pi_2 ? seg.alpha + pi : seg.alpha - pi) : seg.alpha),
+                dCell = accumulator.getDCell(opposite ? -seg.d : seg.d);
+      for(int a = std::max(alphaCell - 1, 0); a <= std::min(alphaCell + 1, accumulator.alphaCells - 1); ++a)
+        for(int d = std::max(dCell - 1, 0); d <= std::min(dCell + 1, accumulator.dCells - 1); ++d)
+        {
+          const int cell = a * accumulator.dCells + d;
+          for(int j = accumulator.firstInCell[cell]; j < accumulator.firstInCell[cell + 1]; ++j)
+          {
+            const int index = accumulator.segments[j];
+            if(segUsed[index] || segVisited[index] == i)
+              continue;
+            segVisited[index] = i;
+            const LinePercept::LineSegment& other = lineSegs[index];
+            if((fabs(other.alpha - seg.alpha) < parameters.maxAlphaDiff &&
+               fabs(other.d - seg.d) < parameters.maxDDiff) ||
+               (fabs(fabs(other.alpha - seg.alpha) - pi) < parameters.maxAlphaDiff &&
+               fabs(other.d + seg.d) < parameters.maxDDiff))
+            {
+              const int sqr_length = (other.p1-other.p2).squareAbs();
+              if(sqr_length > maxSegmentLength)
+                maxSegmentLength = sqr_length;
+              supporters.push_back(index);
+            }
+          }
+        }
     }
     maxSegmentLength = static_cast<int>(sqrt(static_cast<double>(maxSegmentLength)));
 
@@ -406,24 +447,40 @@ void LinePerceptor::createLines(std::list<LinePercept::Line>& lines, std::list<L
         CROSS("module:LinePerceptor:Lines1", (seg.p1.x+seg.p2.x)/2, (seg.p1.y+seg.p2.y)/2,20, 20, Drawings::ps_solid, ColorClasses::red);
         DRAWTEXT("module:LinePerceptor:Lines1", seg.p1.x+50, seg.p1.y+100, 10, ColorClasses::black, (int)supporters.size());
       );
-      LinePercept::Line l;
+
+      //keep the original sequence of the segments
+      std::sort(supporters.begin(), supporters.end());
+
+      lines.push_back(LinePercept::Line());
+      LinePercept::Line& l = lines.back();
       double d = seg.d, alpha = seg.alpha;
       l.dead = false;
       l.midLine = false;
+      l.segments.reserve(supporters.size() + 1);
       l.segments.push_back(seg);
-      for(std::vector<std::list<LinePercept::LineSegment>::iterator>::const_iterator sup = supporters.begin(); sup != supporters.end(); sup++)
+      for(std::vector<int>::const_iterator sup = supporters.begin(); sup != supporters.end(); sup++)
       {
-        ARROW("module:LinePerceptor:Lines1", (*sup)->p1.x, (*sup)->p1.y, (*sup)->p2.x, (*sup)->p2.y, 15, Drawings::ps_solid, ColorClasses::red);
-        ARROW("module:LinePerceptor:Lines1", seg.p1.x, seg.p1.y, (*sup)->p1.x, (*sup)->p1.y, 5, Drawings::ps_solid, ColorClasses::robotBlue);
-        d += (*sup)->d;
-        alpha += (*sup)->alpha;
-        l.segments.push_back(*(*sup));
+        segUsed[*sup] = true;
+        l.segments.push_back(lineSegs[*sup]);
+        LinePercept::LineSegment& other = l.segments.back();
+        ARROW("module:LinePerceptor:Lines1", other.p1.x, other.p1.y, other.p2.x, other.p2.y, 15, Drawings::ps_solid, ColorClasses::red);
+        ARROW("module:LinePerceptor:Lines1", seg.p1.x, seg.p1.y, other.p1.x, other.p1.y, 5, Drawings::ps_solid, ColorClasses::robotBlue);
+
+        //make supporters all look into the same direction
+        if(!(fabs(other.alpha - seg.alpha) < parameters.maxAlphaDiff &&
+           fabs(other.d - seg.d) < parameters.maxDDiff))
+        {
+          if(other.alpha > seg.alpha)
+            other.alpha -= pi;
+          else
+            other.alpha += pi;
+          other.d *= -1;
+        }
+        d += other.d;
+        alpha += other.alpha;
       }
-      for(std::vector<std::list<LinePercept::LineSegment>::iterator>::const_reverse_iterator sup = supporters.rbegin(); sup != supporters.rend(); sup++)
-        lineSegs.erase(*sup);
       l.d = d / ((int)supporters.size()+1);
       l.alpha = alpha / ((int)supporters.size()+1);
-      lines.push_back(l); 
     }
     else
       singleSegs.push_back(seg);
@@ -174,12 +174,66 @@ class LinePerceptor : public LinePerceptorBase
       int counter; /**< Number of nonLineSpots in this sector */
   };
 
+  /**
+   * @class Accumulator
+   * A grid in (alpha, d) space (Hess norm form) the line segments are sorted into.
+   * The cells are at least as large as the maximum differences of segments supporting
+   * each other, so all supporters of a segment are found in the 3x3 cells around it
+   * or around its representation with the opposite direction.
+   */
+  class Accumulator
+  {
+    public:
+      enum {maxCells = 64}; /**< The maximum number of cells in each dimension */
+      double alphaCellSize; /**< The size of a cell in alpha direction */
+      double dCellSize; /**< The size of a cell in d direction */
+      double minD; /**< The d value the first cell starts at */
+      int alphaCells; /**< The number of cells in alpha direction */
+      int dCells; /**< The number of cells in d direction */
+      std::vector<int> firstInCell; /**< The index of the first entry in segments for each cell, plus the end of the last cell */
+      std::vector<int> segments; /**< The indices of all line segments sorted by their cells */
+
+      /**
+       * Sorts the line segments into the grid.
+       * @param lineSegs The line segments.
+       * @param maxAlphaDiff The maximum difference in direction of segments supporting each other
+       * @param maxDDiff The maximum difference in distance of segments supporting each other
+       */
+      void init(const std::vector<LinePercept::LineSegment>& lineSegs, double maxAlphaDiff, double maxDDiff);
+
+      /**
+       * Returns the cell index in alpha direction.
+       * @param alpha The direction. Values outside [0...pi] are clipped.
+       * @return The index in [0...alphaCells-1]
+       */
+      int getAlphaCell(double alpha) const
+      {
+        const int a = (int) (alpha / alphaCellSize);
+        return a < 0 ? 0 : a >= alphaCells ? alphaCells - 1 : a;
+      }
+
+      /**
+       * Returns the cell index in d direction.
+       * @param d The distance. Values outside the grid are clipped.
+       * @return The index in [0...dCells-1]
+       */
+      int getDCell(double d) const
+      {
+        const int c = (int) ((d - minD) / dCellSize);
+        return c < 0 ? 0 : c >= dCells ? dCells - 1 : c;
+      }
+  };
+
   Parameters parameters; /**< Parameters for this module */
   CircleParameters circleParams; /**< Parameters for center circle detection */
   NonLineParameters nonLineParams; /**< Parameters for filtering out lines near robots */
   BanSectorParameters banSectorParams; /**< Parameters for the creation of ban sectors */
 
-  std::list<LinePercept::LineSegment> lineSegs; /**< All the lineSegments */
+  std::vector<LinePercept::LineSegment> lineSegs; /**< All the lineSegments. Keeps its capacity between frames. */
+  Accumulator accumulator; /**< The grid the lineSegments are sorted into to find supporters */
+  std::vector<char> segUsed; /**< Was a lineSegment already used as start or supporter of a line? */
+  std::vector<int> segVisited; /**< The start segment a lineSegment was last checked for */
+  std::vector<int> supporters; /**< The supporters of the current start segment */
   std::list<BanSector> banSectors; /**< The ban sectors, where no vertical, long spots are accepted */
 
   /** update the LinePercept */
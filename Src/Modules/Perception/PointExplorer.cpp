@@ -1,13 +1,13 @@
 #include "Representations/Perception/RegionPercept.h"
 #include "PointExplorer.h"
+#include "Tools/ImageProcessing/ColorClassScanner.h"
 #include "Tools/Debugging/Modify.h"
 
 ColorClasses::Color PointExplorer::getColor(int x, int y)
 {
   ASSERT(x < theImage->cameraInfo.resolutionWidth && y < theImage->cameraInfo.resolutionHeight && x >= 0 && y >= 0);
 
-  unsigned col(theImage->image[y][x].color); 
-  return (ColorClasses::Color)theColorTable64->colorClasses[col >> 18 & 0x3f][col >> 10 & 0x3f][col >> 26 & 0x3f];
+  return theColorClassPlane->getColor(x, y, *theImage, *theColorTable64);
 }
 
 int PointExplorer::explorePoint(int x, int y, ColorClasses::Color col, int xMin, int yEnd, int yMin, int& run_end, int& explored_min_y, int& explored_max_y, bool force_detailed)
@@ -53,58 +53,88 @@ int PointExplorer::explorePoint(int x, int y, ColorClasses::Color col, int xMin,
 int PointExplorer::runDown(int x, int y, ColorClasses::Color col, int yEnd, Drawings::PenStyle draw)
 {
   const int yStart = y;
-  int tmp;
+  const unsigned char* column = theColorClassPlane->getColumn(x);
 
-  for(y+=parameters.skipOffset; y < yEnd; y+=parameters.skipOffset)
+  if(column && parameters.skipOffset <= 16)
+    y = ColorClassScanner::findGap(column, y + 1, yEnd, (unsigned char) col, parameters.skipOffset);
+  else
   {
-    if(getColor(x,y) != col)
+    int tmp;
+    for(y+=parameters.skipOffset; y < yEnd; y+=parameters.skipOffset)
     {
-      tmp = y - parameters.skipOffset;
-      for(--y; y > tmp; y--)
-        if(getColor(x,y) == col)
-          break;
-
-      if(y == tmp)
+      if(getColor(x,y) != col)
       {
-        y++;
-        break;
+        tmp = y - parameters.skipOffset;
+        for(--y; y > tmp; y--)
+          if(getColor(x,y) == col)
+            break;
+
+        if(y == tmp)
+        {
+          y++;
+          break;
+        }
       }
     }
+    if(y > yEnd)
+      y = yEnd;
   }
-  if(y > yEnd)
-    y = yEnd;
 
-  COMPLEX_DRAWING("module:PointExplorer:runs",
-        {LINE("module:PointExplorer:runs", x, yStart, x, y, 1, draw, getOnFieldDrawColor(col));}
-    );
+  if(drawRuns)
+  {
+    COMPLEX_DRAWING("module:PointExplorer:runs",
+          {LINE("module:PointExplorer:runs", x, yStart, x, y, 1, draw, getOnFieldDrawColor(col));}
+      );
+  }
   return y;
 }
 
 int PointExplorer::findDown(int x, int y, ColorClasses::Color col, int yEnd, Drawings::PenStyle draw)
 {
   const int yStart = y;
+  const unsigned char* column = theColorClassPlane->getColumn(x);
   int tmp;
 
-  for(y+=parameters.skipOffset; y < yEnd; y+=parameters.skipOffset)
+  if(column)
   {
-    if(getColor(x,y) == col)
+    y = ColorClassScanner::findSample(column, yStart, yEnd, parameters.skipOffset, (unsigned char) col, (unsigned char) col);
+    if(y < yEnd)
     {
       tmp = y - parameters.skipOffset;
       for(--y; y > tmp; y--)
-        if(getColor(x,y) != col)
+        if(column[y] != col)
           break;
 
       if(y != tmp)
         ++y;
-      break;
     }
   }
-  if(y > yEnd)
-    y = yEnd;
+  else
+  {
+    for(y+=parameters.skipOffset; y < yEnd; y+=parameters.skipOffset)
+    {
+      if(getColor(x,y) == col)
+      {
+        tmp = y - parameters.skipOffset;
+        for(--y; y > tmp; y--)
+          if(getColor(x,y) != col)
+            break;
+
+        if(y != tmp)
+          ++y;
+        break;
+      }
+    }
+    if(y > yEnd)
+      y = yEnd;
+  }
 
-  COMPLEX_DRAWING("module:PointExplorer:runs",
-        {LINE("module:PointExplorer:runs", x, yStart, x, y, 1, draw, getOnFieldDrawColor(col));}
-    );
+  if(drawRuns)
+  {
+    COMPLEX_DRAWING("module:PointExplorer:runs",
+          {LINE("module:PointExplorer:runs", x, yStart, x, y, 1, draw, getOnFieldDrawColor(col));}
+      );
+  }
   return y;
 }
 
@@ -113,96 +143,139 @@ int PointExplorer::findDown2(int x, int y, ColorClasses::Color col1, ColorClasse
   const int yStart = y;
   int tmp;
   ColorClasses::Color col = ColorClasses::none;
+  const unsigned char* column = theColorClassPlane->getColumn(x);
 
-  for(y+=parameters.skipOffset; y < yEnd; y+=parameters.skipOffset)
+  if(column)
   {
-    col = getColor(x,y);
-    if(col == col1 || col == col2)
+    y = ColorClassScanner::findSample(column, yStart, yEnd, parameters.skipOffset, (unsigned char) col1, (unsigned char) col2);
+    if(y < yEnd)
     {
+      col = (ColorClasses::Color) column[y];
       tmp = y - parameters.skipOffset;
       for(--y; y > tmp; y--)
-        if(getColor(x,y) != col)
+        if(column[y] != col)
           break;
 
       if(y != tmp)
         ++y;
-      break;
     }
+    else if(yStart + parameters.skipOffset < yEnd) // the color of the last pixel sampled
+      col = (ColorClasses::Color) column[yStart + (yEnd - 1 - yStart) / parameters.skipOffset * parameters.skipOffset];
+  }
+  else
+  {
+    for(y+=parameters.skipOffset; y < yEnd; y+=parameters.skipOffset)
+    {
+      col = getColor(x,y);
+      if(col == col1 || col == col2)
+      {
+        tmp = y - parameters.skipOffset;
+        for(--y; y > tmp; y--)
+          if(getColor(x,y) != col)
+            break;
+
+        if(y != tmp)
+          ++y;
+        break;
+      }
+    }
+    if(y > yEnd)
+      y = yEnd;
   }
-  if(y > yEnd)
-    y = yEnd;
 
   foundCol = col;
-  COMPLEX_DRAWING("module:PointExplorer:runs",
-        {LINE("module:PointExplorer:runs", x, yStart, x, y, 1, draw, getOnFieldDrawColor(col));}
-    );
+  if(drawRuns)
+  {
+    COMPLEX_DRAWING("module:PointExplorer:runs",
+          {LINE("module:PointExplorer:runs", x, yStart, x, y, 1, draw, getOnFieldDrawColor(col));}
+      );
+  }
   return y;
 }
 
 int PointExplorer::runUp(int x, int y, ColorClasses::Color col, int yEnd, Drawings::PenStyle draw)
 {
   const int yStart = y;
-  int tmp;
+  const unsigned char* column = theColorClassPlane->getColumn(x);
 
-  for(y-=parameters.skipOffset; y > yEnd; y-=parameters.skipOffset)
+  if(column && parameters.skipOffset <= 16)
+    y = ColorClassScanner::findGapReverse(column, y - 1, yEnd, (unsigned char) col, parameters.skipOffset);
+  else
   {
-    if(getColor(x,y) != col)
+    int tmp;
+    for(y-=parameters.skipOffset; y > yEnd; y-=parameters.skipOffset)
     {
-      tmp = y + parameters.skipOffset;
-      for(++y; y < tmp; y++)
-        if(getColor(x,y) == col)
-          break;
-
-      if(y == tmp)
+      if(getColor(x,y) != col)
       {
-        y--;
-        break;
+        tmp = y + parameters.skipOffset;
+        for(++y; y < tmp; y++)
+          if(getColor(x,y) == col)
+            break;
+
+        if(y == tmp)
+        {
+          y--;
+          break;
+        }
       }
     }
+    if(y < yEnd)
+      y = yEnd;
   }
-  if(y < yEnd)
-    y = yEnd;
 
-  COMPLEX_DRAWING("module:PointExplorer:runs",
-      {LINE("module:PointExplorer:runs", x, yStart, x, y, 1, draw, getOnFieldDrawColor(col));}
-    );
+  if(drawRuns)
+  {
+    COMPLEX_DRAWING("module:PointExplorer:runs",
+        {LINE("module:PointExplorer:runs", x, yStart, x, y, 1, draw, getOnFieldDrawColor(col));}
+      );
+  }
   return y;
 }
 
 int PointExplorer::runRight(int x, int y, ColorClasses::Color col, int xMax, Drawings::PenStyle draw)
 {
   const int xStart = x;
-  int tmp;
+  const unsigned char* row = theColorClassPlane->getRow(y);
 
-  for(x += parameters.skipOffset; x < xMax; x += parameters.skipOffset)
+  if(row && parameters.skipOffset <= 16)
+    x = ColorClassScanner::findGap(row, x + 1, xMax, (unsigned char) col, parameters.skipOffset);
+  else
   {
-    if(getColor(x,y) != col)
+    int tmp;
+    for(x += parameters.skipOffset; x < xMax; x += parameters.skipOffset)
     {
-      tmp = x - parameters.skipOffset;
-      for(--x; x > tmp; x--)
-        if(getColor(x,y) == col)
-          break;
-
-      if(x == tmp)
+      if(getColor(x,y) != col)
       {
-        x++;
-        break;
+        tmp = x - parameters.skipOffset;
+        for(--x; x > tmp; x--)
+          if(getColor(x,y) == col)
+            break;
+
+        if(x == tmp)
+        {
+          x++;
+          break;
+        }
       }
     }
+    if(x > xMax)
+      x = xMax;
   }
-  if(x > xMax)
-    x = xMax;
 
-  COMPLEX_DRAWING("module:PointExplorer:runs",
-      {LINE("module:PointExplorer:runs", xStart, y, x, y, 1, draw, getOnFieldDrawColor(col));}
-    );
+  if(drawRuns)
+  {
+    COMPLEX_DRAWING("module:PointExplorer:runs",
+        {LINE("module:PointExplorer:runs", xStart, y, x, y, 1, draw, getOnFieldDrawColor(col));}
+      );
+  }
   return x;
 }
 
-void PointExplorer::initFrame(const Image *image, const ColorTable64* colorTable, int exploreStepSize, int gridStepSize, int skipOffset, int* minSegLength)
+void PointExplorer::initFrame(const Image *image, const ColorTable64* colorTable, const ColorClassPlane* colorClassPlane, int exploreStepSize, int gridStepSize, int skipOffset, int* minSegLength)
 {
   theImage = image;
   theColorTable64 = colorTable;
+  theColorClassPlane = colorClassPlane;
   parameters.exploreStepSize = exploreStepSize;
   parameters.gridStepSize = gridStepSize;
   parameters.skipOffset = skipOffset;
@@ -3,6 +3,7 @@
 
 #include "Representations/Configuration/ColorTable64.h"
 #include "Representations/Infrastructure/Image.h"
+#include "Representations/Perception/ColorClassPlane.h"
 #include "Tools/Debugging/DebugDrawings.h"
 
 /**
@@ -19,16 +20,20 @@
 class PointExplorer
 {
 public:
+  /** Default constructor. */
+  PointExplorer() : drawRuns(true) {}
+
   /**
    * Initialize the PointExplorer for a frame. Pass the ColorTable, the Image and some parameters.
    * @param image theImage Representation of the frame
    * @param colorTable theColorTable Representation
+   * @param colorClassPlane theColorClassPlane Representation, i.e. the precomputed color classes of the scan grid
    * @param exploreStepSize the distance in pixels between the explore scanlines
    * @param gridStepSize the distance in pixels between (normal) scanlines
    * @param skipOffset the amount of pixels allowed to skip in a run
    * @param minSegLength a array giving holding the minimum segment size for each color
    */
-  void initFrame(const Image *image, const ColorTable64* colorTable, int exploreStepSize, int gridStepSize, int skipOffset, int* minSegLength);
+  void initFrame(const Image *image, const ColorTable64* colorTable, const ColorClassPlane* colorClassPlane, int exploreStepSize, int gridStepSize, int skipOffset, int* minSegLength);
 
   /**
    * Run down from (x,y) unless there is a run of skipOffset pixels with color != col.
@@ -120,6 +125,8 @@ public:
 
   const Image* theImage; /**< a pointer to the image Representation */
   const ColorTable64* theColorTable64; /**< a pointer to the colortable Representation */
+  const ColorClassPlane* theColorClassPlane; /**< a pointer to the colorClassPlane Representation */
+  bool drawRuns; /**< Draw the runs? Must be false if the PointExplorer is not used by the thread of the process. */
 
   /**
    * @class Parameters
@@ -38,7 +38,7 @@ void RegionAnalyzer::update(BallSpots& ballSpots)
 int RegionAnalyzer::getGreenBelow(const RegionPercept::Region* region)
 {
   int greenBelow = 0;
-  for(std::vector<RegionPercept::Segment*>::const_iterator child = region->childs.begin(); child != region->childs.end(); child++)
+  for(RegionPercept::List<RegionPercept::Segment>::const_iterator child = region->childs.begin(); child != region->childs.end(); child++)
   {
     if((*child) - theRegionPercept.segments == theRegionPercept.segmentsCounter-1)
       continue;
@@ -70,7 +70,7 @@ int RegionAnalyzer::getGreenBelow(const RegionPercept::Region* region)
 int RegionAnalyzer::getGreenAbove(const RegionPercept::Region* region)
 {
   int greenAbove = 0;
-  for(std::vector<RegionPercept::Segment*>::const_iterator child = region->childs.begin(); child != region->childs.end(); child++)
+  for(RegionPercept::List<RegionPercept::Segment>::const_iterator child = region->childs.begin(); child != region->childs.end(); child++)
   {
     if((*child) == theRegionPercept.segments)
       continue;
@@ -104,7 +104,7 @@ int RegionAnalyzer::getGreenRight(const RegionPercept::Region *region)
   const RegionPercept::Segment* nextColumnSegment;
   const int& gridStepSize = theRegionPercept.gridStepSize;
   int greenRight = 0;
-  for(std::vector<RegionPercept::Segment*>::const_iterator seg_iter = region->childs.begin();
+  for(RegionPercept::List<RegionPercept::Segment>::const_iterator seg_iter = region->childs.begin();
       seg_iter != region->childs.end();
       seg_iter++)
   {
@@ -156,7 +156,7 @@ int RegionAnalyzer::getGreenLeft(const RegionPercept::Region *region)
   const RegionPercept::Segment* lastColumnSegment;
   const int& gridStepSize = theRegionPercept.gridStepSize;
   int greenLeft = 0;
-  for(std::vector<RegionPercept::Segment*>::const_iterator seg_iter = region->childs.begin();
+  for(RegionPercept::List<RegionPercept::Segment>::const_iterator seg_iter = region->childs.begin();
       seg_iter != region->childs.end();
       seg_iter++)
   {
@@ -226,7 +226,7 @@ bool RegionAnalyzer::isLine(const RegionPercept::Region* region, float& directio
   }
 
   int neighborNoneSize = 0;
-  for(std::vector<RegionPercept::Region*>::const_iterator neighbor = region->neighborRegions.begin(); neighbor != region->neighborRegions.end(); neighbor++)
+  for(RegionPercept::List<RegionPercept::Region>::const_iterator neighbor = region->neighborRegions.begin(); neighbor != region->neighborRegions.end(); neighbor++)
   {
     switch((*neighbor)->color)
     {
@@ -349,7 +349,7 @@ bool RegionAnalyzer::isLine(const RegionPercept::Region* region, float& directio
          len_min = 0,
          len_max2 = 0,
          len_min2 = 0;
-  for(std::vector<RegionPercept::Segment*>::const_iterator child = region->childs.begin(); child != region->childs.end(); child++)
+  for(RegionPercept::List<RegionPercept::Segment>::const_iterator child = region->childs.begin(); child != region->childs.end(); child++)
   {
     const RegionPercept::Segment* seg = *child;
     const Vector2<double> childRelToSwp(seg->x - spot.x_s, seg->y - spot.y_s),
@@ -19,6 +19,12 @@ Regionizer::Regionizer()
   }
 }
 
+Regionizer::~Regionizer()
+{
+  for(std::vector<Stripe*>::iterator i = stripes.begin(); i != stripes.end(); ++i)
+    delete *i;
+}
+
 void Regionizer::update(RegionPercept& rPercept)
 {
   regionPercept = &rPercept;
@@ -26,7 +32,7 @@ void Regionizer::update(RegionPercept& rPercept)
   DECLARE_DEBUG_DRAWING("module:Regionizer:borders","drawingOnImage");
   DECLARE_DEBUG_DRAWING("module:Regionizer:borders2","drawingOnImage");
 
-  pointExplorer.initFrame(&theImage, &theColorTable64, parameters.exploreStepSize, parameters.gridStepSize, parameters.skipOffset, parameters.minSegSize);
+  pointExplorer.initFrame(&theImage, &theColorTable64, &theColorClassPlane, parameters.exploreStepSize, parameters.gridStepSize, parameters.skipOffset, parameters.minSegSize);
 
   regionPercept->fieldBorders.clear();
   regionPercept->verticalPostSegments.clear();
@@ -44,14 +50,44 @@ void Regionizer::update(RegionPercept& rPercept)
   STOP_TIME_ON_REQUEST("buildRegions", buildRegions(););
 }
 
+inline RegionPercept::Region* Regionizer::getRegion(RegionPercept::Segment* seg)
+{
+  RegionPercept::Region* region = seg->region;
+  if(region && region->root)
+  {
+    RegionPercept::Region* root = region->root;
+    while(root->root)
+      root = root->root;
+    //let all regions on the path point directly to the root
+    while(region->root != root)
+    {
+      RegionPercept::Region* next = region->root;
+      region->root = root;
+      region = next;
+    }
+    seg->region = root;
+  }
+  return seg->region;
+}
+
+inline void Regionizer::addNeighbors(RegionPercept::Region* region1, RegionPercept::Region* region2)
+{
+  if(neighborsCounter < MAX_NEIGHBORS_COUNT)
+  {
+    neighbors[neighborsCounter][0] = region1;
+    neighbors[neighborsCounter++][1] = region2;
+  }
+}
+
 bool Regionizer::uniteRegions(RegionPercept::Segment* seg1, RegionPercept::Segment* seg2)
 {
-  ASSERT(seg1->region);
+  RegionPercept::Region* region1 = getRegion(seg1);
+  ASSERT(region1);
   //we want straight white regions (lines) so don't unite white regions which would not be straight
   if(seg1->color == ColorClasses::white)
   {
-    ASSERT(seg1->region->childs.size() >= 1);
-    if(seg1->region->childs.at(seg1->region->childs.size()-1)->x == seg2->x)
+    ASSERT(region1->numOfChilds >= 1);
+    if(region1->lastChild->x == seg2->x)
       return false;
 
     if(seg1->link)
@@ -71,26 +107,24 @@ bool Regionizer::uniteRegions(RegionPercept::Segment* seg1, RegionPercept::Segme
   //seg1 always has a region
   if(!seg2->region)
   {
-    RegionPercept::Segment *sWithRegion = seg1,
-            *sWithoutRegion = seg2;
-
-    if((int)sWithRegion->region->childs.size() < parameters.regionMaxSize || 
+    if(region1->numOfChilds < parameters.regionMaxSize || 
             seg1->color == ColorClasses::yellow || //yellow, blue and orange regions can grow unlimited
             seg1->color == ColorClasses::blue ||
             seg1->color == ColorClasses::orange)
     {
-      sWithRegion->region->childs.push_back(sWithoutRegion);
-      sWithoutRegion->region = sWithRegion->region;
-      sWithRegion->region->size += sWithoutRegion->explored_size;
-
-      if(sWithoutRegion->y < sWithRegion->region->min_y)
-        sWithRegion->region->min_y = sWithoutRegion->y;
-      if(sWithoutRegion->y + sWithoutRegion->length > sWithRegion->region->max_y)
-        sWithRegion->region->max_y = sWithoutRegion->y + sWithoutRegion->length;
+      ++region1->numOfChilds;
+      if(seg2 > region1->lastChild)
+        region1->lastChild = seg2;
+      seg2->region = region1;
+      region1->size += seg2->explored_size;
+
+      if(seg2->y < region1->min_y)
+        region1->min_y = seg2->y;
+      if(seg2->y + seg2->length > region1->max_y)
+        region1->max_y = seg2->y + seg2->length;
       seg2->link = seg1;
       return true;
     }
-    ASSERT(seg1->region == seg2->region || !seg2->region);
   }
   //both segments already have a region
   else
@@ -98,12 +132,20 @@ bool Regionizer::uniteRegions(RegionPercept::Segment* seg1, RegionPercept::Segme
     //don't unite two white regions (since we want straight white regions -> lines)
     if(seg1->color != ColorClasses::white)
     {
-      if(seg1->region != seg2->region && ((int)(seg1->region->childs.size() + seg2->region->childs.size()) < parameters.regionMaxSize || seg1->color == ColorClasses::yellow || seg1->color == ColorClasses::blue || seg1->color == ColorClasses::orange))
+      RegionPercept::Region* region2 = getRegion(seg2);
+      if(region1 != region2 && (region1->numOfChilds + region2->numOfChilds < parameters.regionMaxSize || seg1->color == ColorClasses::yellow || seg1->color == ColorClasses::blue || seg1->color == ColorClasses::orange))
       {
-        RegionPercept::Region* oldRegion = seg2->region;
-        seg1->region->mergeWithRegion(seg2->region);
-        oldRegion->childs.clear();
-        oldRegion->root = seg1->region;
+        //region2 becomes "dead", its segments are assigned to region1 by getRegion()
+        region1->numOfChilds += region2->numOfChilds;
+        if(region2->lastChild > region1->lastChild)
+          region1->lastChild = region2->lastChild;
+        region1->size += region2->size;
+        if(region2->min_y < region1->min_y)
+          region1->min_y = region2->min_y;
+        if(region2->max_y > region1->max_y)
+          region1->max_y = region2->max_y;
+        region2->numOfChilds = 0;
+        region2->root = region1;
         seg2->link = seg1;
         return true;
       }
@@ -112,12 +154,12 @@ bool Regionizer::uniteRegions(RegionPercept::Segment* seg1, RegionPercept::Segme
   return false;
 }
 
-inline RegionPercept::Segment* Regionizer::addSegment(int x, int y, int length, ColorClasses::Color color, int yEnd)
+inline RegionPercept::Segment* Regionizer::addSegment(RegionPercept::Segment* segments, int& segmentsCounter, int x, int y, int length, ColorClasses::Color color, int yEnd) const
 {
-    if(!(regionPercept->segmentsCounter < MAX_SEGMENTS_COUNT))
+    if(!(segmentsCounter < MAX_SEGMENTS_COUNT))
       return NULL;
 
-    RegionPercept::Segment* seg = regionPercept->segments + regionPercept->segmentsCounter++;
+    RegionPercept::Segment* seg = segments + segmentsCounter++;
     seg->color = color;
     seg->x = x;
     seg->y = y;
@@ -158,7 +200,8 @@ RegionPercept::Segment* Regionizer::connectToRegions(RegionPercept::Segment* new
     return NULL;
   }
 
-  std::vector<RegionPercept::Region*> neighborRegions;
+  //the neighbors are stored with the region of newSegment still missing, because it is not known yet
+  const int firstNeighbor = neighborsCounter;
 
   if(lastColumPointer->y + lastColumPointer->length >= newSegment->explored_min_y)
     if(lastColumPointer->y <= newSegment->explored_max_y)
@@ -167,12 +210,12 @@ RegionPercept::Segment* Regionizer::connectToRegions(RegionPercept::Segment* new
       if(lastColumPointer->color == newSegment->color)
       {
         if(!uniteRegions(lastColumPointer, newSegment))
-          neighborRegions.push_back(lastColumPointer->region);
+          addNeighbors(getRegion(lastColumPointer), NULL);
       } 
       else
       {
         if(lastColumPointer->region)
-          neighborRegions.push_back(lastColumPointer->region);
+          addNeighbors(getRegion(lastColumPointer), NULL);
       }
     }
 
@@ -190,7 +233,10 @@ RegionPercept::Segment* Regionizer::connectToRegions(RegionPercept::Segment* new
     {
       if(!newSegment->region)
         if(!createNewRegionForSegment(newSegment))
+        {
+          neighborsCounter = firstNeighbor;
           return NULL;
+        }
       break;
     }
 
@@ -201,12 +247,12 @@ RegionPercept::Segment* Regionizer::connectToRegions(RegionPercept::Segment* new
       if(tmpLastColumPointer->color == newSegment->color)
       {
         if(!uniteRegions(tmpLastColumPointer, newSegment))
-          neighborRegions.push_back(tmpLastColumPointer->region);
+          addNeighbors(getRegion(tmpLastColumPointer), NULL);
       }
       else
       {
         if(tmpLastColumPointer->region)
-          neighborRegions.push_back(tmpLastColumPointer->region);
+          addNeighbors(getRegion(tmpLastColumPointer), NULL);
       }
     }
     else
@@ -215,14 +261,14 @@ RegionPercept::Segment* Regionizer::connectToRegions(RegionPercept::Segment* new
 
   if(!newSegment->region)
     if(!createNewRegionForSegment(newSegment))
+    {
+      neighborsCounter = firstNeighbor;
       return NULL;
+    }
 
-  for(std::vector<RegionPercept::Region*>::iterator nb_reg = neighborRegions.begin(); nb_reg != neighborRegions.end(); nb_reg++)
-  {
-    ASSERT(newSegment->region);
-    (*nb_reg)->neighborRegions.push_back(newSegment->region);
-    newSegment->region->neighborRegions.push_back(*nb_reg);
-  }
+  RegionPercept::Region* region = getRegion(newSegment);
+  for(int i = firstNeighbor; i < neighborsCounter; ++i)
+    neighbors[i][1] = region;
   return lastColumPointer;
 }
 
@@ -232,13 +278,12 @@ bool Regionizer::createNewRegionForSegment(RegionPercept::Segment* seg)
   {
     seg->region = regionPercept->regions + regionPercept->regionsCounter++;
     seg->region->color = seg->color;
-    seg->region->childs.clear();
-    seg->region->neighborRegions.clear();
+    seg->region->numOfChilds = 1;
+    seg->region->lastChild = seg;
     seg->region->min_y = seg->y;
     seg->region->max_y = seg->y + seg->length;
     seg->region->root = NULL;
     seg->region->size = seg->explored_size;
-    seg->region->childs.push_back(seg);
     return true;
   }
   return false;
@@ -349,6 +394,8 @@ void Regionizer::buildRegions()
 
   RegionPercept::Segment* firstInColum=NULL, *lastColumPointer = NULL, *newSegment, *lastSegment = NULL;
 
+  neighborsCounter = 0;
+
   for(int i = 0; i < regionPercept->segmentsCounter; i++)
   {
     newSegment = regionPercept->segments + i;
@@ -375,8 +422,7 @@ void Regionizer::buildRegions()
     {
       if(newSegment-> y - (lastSegment->y + lastSegment->length) < parameters.skipOffset)
       {
-        lastSegment->region->neighborRegions.push_back(newSegment->region);
-        newSegment->region->neighborRegions.push_back(lastSegment->region);
+        addNeighbors(getRegion(lastSegment), getRegion(newSegment));
       }
       else
         lastSegment = NULL;
@@ -385,93 +431,270 @@ void Regionizer::buildRegions()
     lastSegment = newSegment;
     lastx = newSegment->x;
   }
+
+  buildLists();
+}
+
+void Regionizer::buildLists()
+{
+  RegionPercept::Region* const regions = regionPercept->regions;
+  const int regionsCounter = regionPercept->regionsCounter;
+
+  //let all dead regions point directly to their root
+  for(int i = 0; i < regionsCounter; i++)
+    if(regions[i].root)
+      regions[i].root = regions[i].getRootRegion();
+
+  //count the neighbors of all root regions
+  for(int i = 0; i < regionsCounter; i++)
+    numOfNeighbors[i] = 0;
+  for(int i = 0; i < neighborsCounter; i++)
+    for(int j = 0; j < 2; j++)
+    {
+      const RegionPercept::Region* region = neighbors[i][j];
+      ++numOfNeighbors[(region->root ? region->root : region) - regions];
+    }
+
+  //assign the ranges in the arrays of the percept
+  RegionPercept::Segment** child = regionPercept->childSegments;
+  RegionPercept::Region** neighbor = regionPercept->neighborRegions;
+  for(int i = 0; i < regionsCounter; i++)
+  {
+    RegionPercept::Region& region = regions[i];
+    region.childs.first = region.childs.last = child;
+    child += region.numOfChilds;
+    region.neighborRegions.first = region.neighborRegions.last = neighbor;
+    neighbor += numOfNeighbors[i];
+  }
+
+  //fill the lists. The segments are sorted by x and y, so the childs will be as well
+  for(int i = 0; i < regionPercept->segmentsCounter; i++)
+  {
+    RegionPercept::Segment* seg = regionPercept->segments + i;
+    RegionPercept::Region* region = getRegion(seg);
+    if(region)
+    {
+      ASSERT(region->childs.size() < (size_t) region->numOfChilds);
+      *region->childs.last++ = seg;
+    }
+  }
+  for(int i = 0; i < neighborsCounter; i++)
+    for(int j = 0; j < 2; j++)
+    {
+      RegionPercept::Region* region = neighbors[i][j]->root ? neighbors[i][j]->root : neighbors[i][j];
+      *region->neighborRegions.last++ = neighbors[i][1 - j];
+    }
 }
 
 void Regionizer::scanVertically()
 {
-  int xStart = parameters.gridStepSize-1 + ((theImage.cameraInfo.resolutionWidth) %  parameters.gridStepSize) / 2,
-    xEnd = theImage.cameraInfo.resolutionWidth,
-    yEnd = theImage.cameraInfo.resolutionHeight,
-    yStart = 0;
-  int yHorizon = theImageCoordinateSystem.fromHorizonBased(Vector2<double>()).y;
+  xStart = parameters.gridStepSize-1 + ((theImage.cameraInfo.resolutionWidth) %  parameters.gridStepSize) / 2;
+  const int xEnd = theImage.cameraInfo.resolutionWidth;
+  yHorizon = theImageCoordinateSystem.fromHorizonBased(Vector2<double>()).y;
+
+  STOP_TIME_ON_REQUEST("calcBorders",
+  calcBorders(xStart, xEnd););
 
+  updateStripes();
 
+  //the runs can only be drawn by the thread of the process
+  bool drawRuns = false;
+  COMPLEX_DRAWING("module:PointExplorer:runs", drawRuns = true;);
+
+  if(stripes.size() > 1 && !drawRuns)
+    scanStripes(xStart < xEnd ? (xEnd - xStart - 1) / parameters.gridStepSize + 1 : 0);
+  else
+  {
+    std::vector<Vector2<int> >::const_iterator border = regionPercept->fieldBorders.begin();
+    for(int x = xStart; x < xEnd; x += parameters.gridStepSize)
+    {
+      int yStart = 0;
+      if(border != regionPercept->fieldBorders.end())
+      {
+        ASSERT(x == border->x);
+        yStart = border->y;
+        border++;
+      }
+
+      if(!scanColumn(pointExplorer, x, yStart, yHorizon, regionPercept->segments, regionPercept->segmentsCounter, regionPercept->verticalPostSegments))
+        break;
+    }
+  }
+}
+
+bool Regionizer::scanColumn(PointExplorer& pointExplorer, int x, int yStart, int yHorizon,
+                            RegionPercept::Segment* segments, int& segmentsCounter,
+                            std::vector<RegionPercept::Segment>& verticalPostSegments) const
+{
   RegionPercept::Segment *newSegment;
   ColorClasses::Color curColor;
   int run_end_y, explored_min_y, explored_max_y, explored_size;
 
-  STOP_TIME_ON_REQUEST("calcBorders",
-  calcBorders(xStart, xEnd););
+  // calculate yEnd based on stopPolygon
+  int yEnd = theImage.cameraInfo.resolutionHeight;
+  theBodyContour.clipBottom(x, yEnd);
 
-  std::vector<Vector2<int> >::const_iterator border = regionPercept->fieldBorders.begin();
+  int y = 0;
 
-  bool perceptFull = false;
-  int x = xStart,
-      y = 0;
-  for(; x < xEnd && !perceptFull ; x += parameters.gridStepSize)
+  //scan for goal segments above horizon
+  const int tyEnd = yHorizon < yEnd ? yHorizon : yEnd;
+  while(y < yHorizon && y < yEnd)
   {
-    // calculate yEnd based on stopPolygon
-    yEnd = theImage.cameraInfo.resolutionHeight;
-    
-    theBodyContour.clipBottom(x, yEnd);
+    y = pointExplorer.findDown2(x, y, ColorClasses::blue, ColorClasses::yellow, tyEnd, curColor);
+
+    if(y >= yEnd)
+      break;
 
-    if(border != regionPercept->fieldBorders.end())
+    if(y < yHorizon)
     {
-      ASSERT(x == border->x);
-      yStart = border->y;
-      border++;
+      RegionPercept::Segment seg;
+      seg.x = x;
+      seg.y = y;
+      seg.length = pointExplorer.runDown(x,y, curColor, yEnd, Drawings::ps_solid) - y;
+      seg.color = curColor;
+      verticalPostSegments.push_back(seg);
+      y += seg.length;
     }
-    else
-      yStart = 0;
+  }
 
-    y = 0;
+  y = yStart;
 
-    //scan for goal segments above horizon
-    const int tyEnd = yHorizon < yEnd ? yHorizon : yEnd;
-    while(y < yHorizon && y < yEnd)
-    {
-      y = pointExplorer.findDown2(x, y, ColorClasses::blue, ColorClasses::yellow, tyEnd, curColor);
+  while(y < yEnd)
+  {
+    curColor = pointExplorer.getColor(x,y);
 
-      if(y >= yEnd)
-        break;
+    explored_size = pointExplorer.explorePoint(x, y, curColor, std::max(0, x - parameters.gridStepSize), yEnd, yStart, run_end_y, explored_min_y, explored_max_y);
+
+    if(run_end_y - y >= parameters.minSegSize[curColor])
+    {
+      newSegment = addSegment(segments, segmentsCounter, x, y, run_end_y - y, curColor, yEnd);
 
-      if(y < yHorizon)
+      if(!newSegment) //MAX_SEGMENTS_COUNT
       {
-        RegionPercept::Segment seg;
-        seg.x = x;
-        seg.y = y;
-        seg.length = pointExplorer.runDown(x,y, curColor, yEnd, Drawings::ps_solid) - y;
-        seg.color = curColor;
-        regionPercept->verticalPostSegments.push_back(seg);
-        y += seg.length;
+        ASSERT(segmentsCounter == MAX_SEGMENTS_COUNT - 1);
+        return false;
       }
+
+      newSegment->explored_min_y = explored_min_y;
+      newSegment->explored_max_y = explored_max_y;
+      newSegment->explored_size = explored_size;
     }
+    y = run_end_y;
+  }
+  return true;
+}
+
+void Regionizer::updateStripes()
+{
+  const int numOfStripes = parameters.numOfStripes > 1 ? parameters.numOfStripes : 0;
+  while((int) stripes.size() > numOfStripes)
+  {
+    delete stripes.back();
+    stripes.pop_back();
+  }
+  while((int) stripes.size() < numOfStripes)
+  {
+    stripes.push_back(new Stripe(*this));
+    if(stripes.size() > 1)
+      stripes.back()->thread.start(stripes.back(), &Stripe::run);
+  }
+}
+
+void Regionizer::scanStripes(int numOfColumns)
+{
+  const int numOfStripes = (int) stripes.size();
+  for(int i = 0; i < numOfStripes; i++)
+  {
+    Stripe& stripe = *stripes[i];
+    stripe.pointExplorer = pointExplorer;
+    stripe.pointExplorer.drawRuns = false;
+    stripe.firstColumn = numOfColumns * i / numOfStripes;
+    stripe.endColumn = numOfColumns * (i + 1) / numOfStripes;
+    if(i > 0)
+      stripe.startScan.post();
+  }
 
-    y = yStart;
+  //the first stripe is scanned by this thread
+  stripes[0]->scan();
+  for(int i = 1; i < numOfStripes; i++)
+    stripes[i]->scanDone.wait();
 
-    while(y < yEnd)
+  //merge the stripes column by column and stop where the sequential scan would have stopped
+  for(int i = 0; i < numOfStripes; i++)
+  {
+    const Stripe& stripe = *stripes[i];
+    int segment = 0,
+        postSegment = 0;
+    for(int column = 0; column < stripe.numOfColumns; column++)
     {
-      curColor = pointExplorer.getColor(x,y);
+      for(; postSegment < stripe.postSegmentsEnd[column]; postSegment++)
+        regionPercept->verticalPostSegments.push_back(stripe.verticalPostSegments[postSegment]);
 
-      explored_size = pointExplorer.explorePoint(x, y, curColor, std::max(0, x - parameters.gridStepSize), yEnd, yStart, run_end_y, explored_min_y, explored_max_y);
+      const int numOfSegments = stripe.segmentsEnd[column] - segment,
+                numOfCopied = std::min(numOfSegments, MAX_SEGMENTS_COUNT - regionPercept->segmentsCounter);
+      for(int j = 0; j < numOfCopied; j++)
+        regionPercept->segments[regionPercept->segmentsCounter++] = stripe.segments[segment + j];
+      segment = stripe.segmentsEnd[column];
 
-      if(run_end_y - y >= parameters.minSegSize[curColor])
-      {
-        newSegment = addSegment(x, y, run_end_y - y, curColor, yEnd);
+      if(numOfCopied < numOfSegments || (stripe.full && column == stripe.numOfColumns - 1))
+        return;
+    }
+  }
+}
 
-        if(!newSegment) //MAX_SEGMENTS_COUNT
-        {
-          ASSERT(regionPercept->segmentsCounter == MAX_SEGMENTS_COUNT - 1);
-          perceptFull = true;
-          break;
-        }
+Regionizer::Stripe::Stripe(Regionizer& regionizer) :
+  regionizer(regionizer),
+  firstColumn(0),
+  endColumn(0),
+  numOfColumns(0),
+  full(false),
+  segmentsCounter(0)
+{
+  verticalPostSegments.reserve(200);
+}
 
-        newSegment->explored_min_y = explored_min_y;
-        newSegment->explored_max_y = explored_max_y;
-        newSegment->explored_size = explored_size;
-      }
-      y = run_end_y;
+Regionizer::Stripe::~Stripe()
+{
+  if(thread.isRunning())
+  {
+    thread.announceStop();
+    startScan.post();
+  }
+}
+
+void Regionizer::Stripe::run()
+{
+  for(;;)
+  {
+    startScan.wait();
+    if(!thread.isRunning())
+      break;
+    scan();
+    scanDone.post();
+  }
+}
+
+void Regionizer::Stripe::scan()
+{
+  const std::vector<Vector2<int> >& fieldBorders = regionizer.regionPercept->fieldBorders;
+  segmentsCounter = 0;
+  verticalPostSegments.clear();
+  numOfColumns = 0;
+  full = false;
+
+  for(int i = firstColumn; i < endColumn && !full; i++)
+  {
+    const int x = regionizer.xStart + i * regionizer.parameters.gridStepSize;
+    int yStart = 0;
+    if(i < (int) fieldBorders.size())
+    {
+      ASSERT(x == fieldBorders[i].x);
+      yStart = fieldBorders[i].y;
     }
+
+    full = !regionizer.scanColumn(pointExplorer, x, yStart, regionizer.yHorizon, segments, segmentsCounter, verticalPostSegments);
+    segmentsEnd[numOfColumns] = segmentsCounter;
+    postSegmentsEnd[numOfColumns++] = (int) verticalPostSegments.size();
   }
 }
 
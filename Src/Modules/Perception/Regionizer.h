@@ -8,16 +8,19 @@
 
 #include "Tools/Module/Module.h"
 #include "Representations/Configuration/ColorTable64.h"
+#include "Representations/Perception/ColorClassPlane.h"
 #include "Representations/Infrastructure/Image.h"
 #include "Representations/Perception/BodyContour.h"
 #include "Representations/Perception/ImageCoordinateSystem.h"
 #include "Representations/Perception/RegionPercept.h"
 #include "Tools/Math/Geometry.h"
+#include "Platform/Thread.h"
 #include "PointExplorer.h"
 
 MODULE(Regionizer)
   REQUIRES(BodyContour)
   REQUIRES(ColorTable64)
+  REQUIRES(ColorClassPlane)
   REQUIRES(Image)
   REQUIRES(ImageCoordinateSystem)
   PROVIDES_WITH_MODIFY_AND_DRAW(RegionPercept)
@@ -49,6 +52,7 @@ private:
       STREAM(maxAngleDiff);
       STREAM(exploreStepSize);
       STREAM(borderMinGreen);
+      STREAM(numOfStripes);
       STREAM_REGISTER_FINISH();
     }
 
@@ -62,11 +66,62 @@ private:
                               The angle is the vector from the middle of the last segment to the next one. */
     int exploreStepSize; /**< The distance in pixels between exploring scanlines */
     int borderMinGreen; /**< The minimum number of green pixels for border detection */
+    int numOfStripes; /**< The number of vertical stripes scanned in parallel. 1 scans the image in the thread of the process. */
   };
 
+  /**
+   * @class Stripe
+   * A vertical stripe of the image that is scanned for segments independently
+   * from the others. All stripes except for the first one are scanned by their
+   * own threads. Their results are merged into the RegionPercept afterwards.
+   */
+  class Stripe
+  {
+  public:
+    Regionizer& regionizer; /**< The module this stripe belongs to. */
+    PointExplorer pointExplorer; /**< The PointExplorer of this stripe. It does not draw. */
+    int firstColumn, /**< The index of the first grid column of this stripe. */
+        endColumn, /**< The index after the last grid column of this stripe. */
+        numOfColumns; /**< The number of columns scanned. Less than endColumn - firstColumn if the segments were full. */
+    bool full; /**< Was the scan stopped, because the segments were full? */
+    RegionPercept::Segment segments[MAX_SEGMENTS_COUNT]; /**< The segments found in this stripe. */
+    int segmentsCounter; /**< The number of entries in segments. */
+    std::vector<RegionPercept::Segment> verticalPostSegments; /**< The post segments found in this stripe. */
+    int segmentsEnd[cameraResolutionWidth], /**< The index after the last segment of each column scanned. */
+        postSegmentsEnd[cameraResolutionWidth]; /**< The index after the last post segment of each column scanned. */
+    Semaphore startScan, /**< Signals the thread to scan the stripe. */
+              scanDone; /**< Signals that the scan is finished. */
+    Thread<Stripe> thread; /**< The thread scanning this stripe. Not used by the first stripe. Declared last, so it is stopped first. */
+
+    /**
+     * Constructor.
+     * @param regionizer The module this stripe belongs to.
+     */
+    Stripe(Regionizer& regionizer);
+
+    /**
+     * Destructor. Stops the thread if it was started.
+     */
+    ~Stripe();
+
+    /** Scans all columns of this stripe. */
+    void scan();
+
+    /** The main function of the thread. */
+    void run();
+  };
+
+  friend class Stripe;
+
   RegionPercept *regionPercept; /**< internal pointer to the RegionPercept */
   Parameters parameters; /**< The parameters of this module. */
   PointExplorer pointExplorer; /**< PointerExplorer instace for running in the image */
+  std::vector<Stripe*> stripes; /**< The stripes the image is scanned in if parameters.numOfStripes > 1. */
+  int xStart, /**< The x coordinate of the first grid column. */
+      yHorizon; /**< The y coordinate of the horizon in the current image. */
+  RegionPercept::Region* neighbors[MAX_NEIGHBORS_COUNT][2]; /**< The pairs of neighboring regions found while building the regions. */
+  int neighborsCounter; /**< The number of entries in neighbors. */
+  int numOfNeighbors[MAX_REGIONS_COUNT]; /**< The number of neighbors of each region, used to fill the neighbor lists. */
 
   /** Updates the RegionPercept */
   void update(RegionPercept& rPercept);
@@ -77,6 +132,32 @@ private:
   * It includes the scanning for goal / post segments
   */
   void scanVertically();
+  /**
+   * The method scans a single grid column for segments.
+   * @param pointExplorer The PointExplorer used.
+   * @param x The x coordinate of the column.
+   * @param yStart The y coordinate of the field border in this column.
+   * @param yHorizon The y coordinate of the horizon.
+   * @param segments The array the segments are added to.
+   * @param segmentsCounter The number of entries in segments. It is updated.
+   * @param verticalPostSegments The vector the post segments are added to.
+   * @return Was there enough space in segments?
+   */
+  bool scanColumn(PointExplorer& pointExplorer, int x, int yStart, int yHorizon,
+                  RegionPercept::Segment* segments, int& segmentsCounter,
+                  std::vector<RegionPercept::Segment>& verticalPostSegments) const;
+  /**
+   * The method scans the grid columns in parallel stripes and merges the
+   * results into the RegionPercept in the same order scanVertically would
+   * have produced them.
+   * @param numOfColumns The number of grid columns.
+   */
+  void scanStripes(int numOfColumns);
+  /**
+   * The method creates or removes stripes, so that their number matches
+   * the parameters.
+   */
+  void updateStripes();
   /**
    * This method scans horizontally for goal / post segments
    */
@@ -90,7 +171,23 @@ private:
    */
   bool uniteRegions(RegionPercept::Segment* seg1, RegionPercept::Segment* seg2);
   /**
-   * Returns a pointer to a new segment (from the segments array within the RegionPercept).
+   * Returns the region a segment belongs to. Since regions are not updated in
+   * their segments when they are merged, the root region is searched, and the
+   * path to it is compressed.
+   * @param seg The segment.
+   * @return The root region of the segment or NULL if it does not have a region.
+   */
+  inline RegionPercept::Region* getRegion(RegionPercept::Segment* seg);
+  /**
+   * Stores that two regions are neighbors.
+   * @param region1 The first region.
+   * @param region2 The second region.
+   */
+  inline void addNeighbors(RegionPercept::Region* region1, RegionPercept::Region* region2);
+  /**
+   * Returns a pointer to a new segment.
+   * @param segments the array the segment is added to
+   * @param segmentsCounter the number of entries in segments. It is updated.
    * @param x the x coordinate of the new segment
    * @param y the y coordinate of the new segment
    * @param length the length of the new segment
@@ -98,7 +195,7 @@ private:
    * @param yEnd the end of the scanline the segment was found on 
    * @return pointer to the new segment or NULL if segments array is full
    */
-  inline RegionPercept::Segment* addSegment(int x, int y, int length, ColorClasses::Color color, int yEnd);
+  inline RegionPercept::Segment* addSegment(RegionPercept::Segment* segments, int& segmentsCounter, int x, int y, int length, ColorClasses::Color color, int yEnd) const;
   /**
    * Creates a new Region in the RegionPercept for the segment passed.
    * @param seg the segment to be added to the region
@@ -118,6 +215,11 @@ private:
    * Builds the regions from the segments.
    */
   void buildRegions();
+  /**
+   * Fills the child and neighbor lists of all root regions after the
+   * regions were built.
+   */
+  void buildLists();
 
   /**
    * Detects the fieldborder in the image and stores it in the RegionPercept.
@@ -136,6 +238,11 @@ public:
   * Default constructor.
   */
   Regionizer();
+
+  /**
+  * Destructor.
+  */
+  ~Regionizer();
 };
 
 #endif// __Regionizer_h_
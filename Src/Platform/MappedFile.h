@@ -0,0 +1,20 @@
+/**
+* @file Platform/MappedFile.h
+* Inclusion of platform dependend implementation of a class for mapping files into memory. 
+*/
+
+#ifndef __MAPPEDFILE_H__
+
+#ifdef WIN32
+#include "Win32/MappedFile.h"
+#endif
+
+#ifdef LINUX
+#include "linux/MappedFile.h"
+#endif
+
+#ifndef __MAPPEDFILE_H__
+#error "Unknown platform"
+#endif
+
+#endif //__MAPPEDFILE_H__
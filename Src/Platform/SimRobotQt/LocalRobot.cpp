@@ -11,6 +11,8 @@
 #include <ControllerQt/ConsoleRoboCupCtrl.h>
 #include "Platform/itoa.h"
 
+static const int imageDelay = 33; /**< The time between two images of the simulated camera in ms. */
+
 LocalRobot::LocalRobot()
 : RobotConsole(theDebugReceiver,theDebugSender),
 theDebugReceiver(this,"Receiver.MessageQueue.O",false),
@@ -30,6 +32,10 @@ imageLastTimeStampSent(0)
   else if(mode == SystemCall::simulatedRobot)
   {
     oracle.init();
+
+    // Without GUI, there is no OpenGL context to render camera images.
+    if(ctrl->isHeadless())
+      calculateImage = false;
   }
 }
 
@@ -85,6 +91,16 @@ int LocalRobot::main()
   return -20;
 }
 
+void LocalRobot::prepareUpdate()
+{
+  // Only one thread can access *this now.
+  SYNC;
+
+  if(mode == SystemCall::simulatedRobot && calculateImage &&
+     SystemCall::getTimeSince(imageTimeStamp) >= imageDelay)
+    oracle.prepareImage();
+}
+
 void LocalRobot::update()
 {
   RobotConsole::update();
@@ -122,7 +138,6 @@ void LocalRobot::update()
       moveOp = noMove;
     }
 
-    const int imageDelay = 33;
     int duration = SystemCall::getTimeSince(imageTimeStamp);
     if(duration >= imageDelay)
     {
@@ -51,6 +51,13 @@ public:
   */
   virtual int main();
 
+  /**
+  * The function must be called for all robots before update() is called for any of them.
+  * It announces the camera image if update() will acquire one, so that the images of
+  * all robots are rendered together.
+  */
+  void prepareUpdate();
+
   /**
   * The function must be called to exchange data with SimRobot.
   * It sends the motor commands to SimRobot and acquires new sensor data.
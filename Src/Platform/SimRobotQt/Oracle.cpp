@@ -13,6 +13,7 @@
 #include "Representations/Modeling/RobotPose.h"
 #include "Representations/Modeling/BallModel.h"
 #include "Representations/MotionControl/OdometryData.h"
+#include "Tools/ImageProcessing/YCbCrConversions.h"
 
 USING_HASH_MAP
 
@@ -62,13 +63,13 @@ static const char* translate[] =
 };
 
 Oracle::Oracle() :
-blue(false), me(0), leftFoot(0), rightFoot(0), ball(0), imageYUV422x2(0), naoV3(false) 
+blue(false), me(0), leftFoot(0), rightFoot(0), ball(0), imageYUV422(0), naoV3(false) 
 {}
 
 Oracle::~Oracle()
 {
-  if(imageYUV422x2)
-    delete[] imageYUV422x2;
+  if(imageYUV422)
+    delete[] imageYUV422;
 }
 
 void Oracle::init()
@@ -267,6 +268,13 @@ void Oracle::getBallModel(const RobotPose& robotPose, BallModel& ballModel)
   }
 }
 
+void Oracle::prepareImage()
+{
+  ASSERT(me);
+  if(spCamera != -1)
+    ctrl->prepareSensorReading(spCamera);
+}
+
 void Oracle::getImage(Image& image)
 {
   ASSERT(me);
@@ -275,45 +283,14 @@ void Oracle::getImage(Image& image)
     const SensorReading& imageReading = ctrl->getSensorReading(spCamera);
     const int w = imageReading.dimensions[0];
     const int h = imageReading.dimensions[1];
-    if(imageYUV422x2 == 0)
-      imageYUV422x2 = new unsigned char[w*h*8];
-    /** TODO: Convert image here! */
-
-    int w3 = w * 3, w2 = w * 2;
-    unsigned char* src = (unsigned char*)imageReading.data.byteArray;
-    unsigned char* srcLineEnd = src;
-    Image::Pixel* destBegin = (Image::Pixel*)imageYUV422x2;
-    Image::Pixel* dest;
-    int r, g, b, yy, uu, vv;
+    if(imageYUV422 == 0)
+      imageYUV422 = new unsigned char[w*h*4];
+
+    const unsigned char* src = (const unsigned char*)imageReading.data.byteArray;
+    Image::Pixel* dest = (Image::Pixel*)imageYUV422;
     for(int y = 0; y < h; ++y)
-    {
-      for(srcLineEnd += w3, dest = destBegin + y * w2; src < srcLineEnd; )
-      {
-        b = *src++;
-        g = *src++;
-        r = *src++;
-        yy =          306 * r,
-        uu = 130560 + 512 * r - 429 * g,
-        vv = 130560 - 173 * r - 339 * g + 512 * b;
-        yy += 601 * g + 117 * b;
-        uu -= 83 * b;
-        // yy =          306 * r + 601 * g + 117 * b // && 0<=r<=255, 0<=g<=255, 0<=b<=255
-        // => max = 261120, min = 0
-        // uu = 130048 + 512 * r - 429 * g -  83 * b // && 0<=r<=255, 0<=g<=255, 0<=b<=255
-        // => max = 260 608, min = -512
-        // vv = 130048 - 173 * r - 339 * g + 512 * b // && 0<=r<=255, 0<=g<=255, 0<=b<=255
-        // => max = 260 608, min = -512
-        // I suggest using 130560 instead of 130048 to get rid of these tests:
-        //if(yy < 0) yy = 0; else if(yy > 261120) yy = 261120;
-        //if(uu < 0) uu = 0; else if(uu > 261120) uu = 261120;
-        //if(vv < 0) vv = 0; else if(vv > 261120) vv = 261120;
-        dest->y = dest->yCbCrPadding = (unsigned char)(yy >> 10);
-        dest->cr = (unsigned char)(uu >> 10);
-        dest->cb = (unsigned char)(vv >> 10);
-        ++dest;
-      }
-    }
-    image.setImage(imageYUV422x2);
+      YCbCrConversions::fromBGR(src + y * w * 3, dest + y * w, w);
+    image.setImage(imageYUV422, w);
   }
   image.timeStamp = SystemCall::getCurrentSystemTime();
 }
@@ -57,6 +57,13 @@ public:
   */
   void getBallModel(const RobotPose& robotPose, BallModel& ballModel);
 
+  /**
+  * Announces that the camera image will be determined in this simulation step.
+  * The camera then renders it and starts reading it back, so the images of all
+  * robots can be rendered before the first one is converted.
+  */
+  void prepareImage();
+
   /**
   * Determines the camera image of the simulated robot.
   * @param image The determined image.
@@ -95,7 +102,7 @@ private:
   SimObject* leftFoot; /**< The simulated left foot of the roboter. */
   SimObject* rightFoot; /**< The simulated right foot of the roboter. */
   SimObject* ball; /**< The simulated ball. */
-  unsigned char* imageYUV422x2; /**< Image data in the NAO format interpretation that we use*/
+  unsigned char* imageYUV422; /**< Image data in the NAO format interpretation that we use*/
   bool naoV3; /**< Flag, indicates robot model type in simulation */
 
   Vector2<double> lastBallPosition; /**< The last ball position on field to determine the velocity of the ball. */
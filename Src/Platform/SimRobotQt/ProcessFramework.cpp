@@ -7,7 +7,9 @@
  */
 #include "ControllerQt/RoboCupCtrl.h"
 #include "Platform/ProcessFramework.h"
+#include "Platform/SimRobotQt/Robot.h"
 #include "Platform/GTAssert.h"
+#include "Tools/Math/Common.h"
 
 /*
  * ProcessCreatorBase::list must be initialized before any code generated
@@ -75,6 +77,7 @@ void PlatformProcess::nextFrame()
 {
   deliverBroadcastPackages();
   int frameTime = processMain();
+  ++numberOfFrames;
   if(getFirstSender())
     getFirstSender()->finishFrame();
   if(getFirstReceiver())
@@ -99,3 +102,39 @@ void PlatformProcess::nextFrame()
     sleepUntil = 0;
   setBlockingId(31,frameTime != 0);
 }
+
+void ProcessBase::seedRandom()
+{
+  // FNV-1a hash of the seed, the robot name, and the process name
+  RoboCupCtrl* ctrl = RoboCupCtrl::getController();
+  unsigned seed = 2166136261u;
+  if(ctrl)
+    for(int i = 0; i < 32; i += 8)
+      seed = (seed ^ ((ctrl->getRandomSeed() >> i) & 0xff)) * 16777619u;
+  for(const char* p = robot.getName(); *p; ++p)
+    seed = (seed ^ (unsigned char) *p) * 16777619u;
+  for(const char* p = getName(); *p; ++p)
+    seed = (seed ^ (unsigned char) *p) * 16777619u;
+  randomSeed(seed);
+}
+
+bool ProcessBase::waitForTick()
+{
+  RoboCupCtrl* ctrl = RoboCupCtrl::getController();
+  if(!ctrl || !ctrl->isLockstep())
+    return false;
+  tick.wait();
+
+  // The controller does not change the seed during a tick.
+  if(ctrl->getSeedGeneration() != seedGeneration)
+  {
+    seedGeneration = ctrl->getSeedGeneration();
+    seedRandom();
+  }
+  return isRunning() && ctrl->isLockstep();
+}
+
+void ProcessBase::finishTick(bool frameExecuted)
+{
+  robot.finishTick(this, frameExecuted);
+}
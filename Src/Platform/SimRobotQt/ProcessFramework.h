@@ -53,6 +53,7 @@ private:
   void (BroadcastReceiver::*onReceive)(const char*); /**< The address of the function that receives broadcast packages. */
   BroadcastReceiver* broadcastReceiver; /**< A pointer to the object that receives broadcast packages. */
   int priority; /**< The priority of the process. */
+  unsigned numberOfFrames; /**< The number of frames executed so far. */
 
 protected:
   /**
@@ -78,7 +79,8 @@ public:
     id(0),
     sleepUntil(0),
     broadcastReceiver(0),
-    priority(0)
+    priority(0),
+    numberOfFrames(0)
   {
   }
 
@@ -203,6 +205,12 @@ public:
   */
   int getPriority() const {return priority;}
 
+  /**
+  * The function returns the number of frames executed so far.
+  * @return The number of calls of processMain().
+  */
+  unsigned getNumberOfFrames() const {return numberOfFrames;}
+
   /**
   * The method is called when the process is terminated.
   */
@@ -221,6 +229,8 @@ class ProcessBase : public Thread<ProcessBase>
 {
 private:
   Robot& robot; /**< A reference to the robot this process corresponds to. */
+  Semaphore tick; /**< Allows the process to check for events once in lockstep mode. */
+  unsigned seedGeneration; /**< The generation of the seed the random number generator was seeded with. */
 
 protected:
   /**
@@ -228,12 +238,32 @@ protected:
   */
   virtual void main() = 0;
 
+  /**
+  * The function seeds the random number generator of this thread with a value
+  * that only depends on the seed set in the controller and the names of the
+  * robot and the process.
+  */
+  void seedRandom();
+
+  /**
+  * The function waits until the process may check for events in lockstep mode.
+  * @return Should the process check for events exactly once and then call finishTick()?
+  *         false if the process should poll for events on its own.
+  */
+  bool waitForTick();
+
+  /**
+  * The function passes the turn to the next process of the robot in lockstep mode.
+  * @param frameExecuted Did the process execute a frame in this turn?
+  */
+  void finishTick(bool frameExecuted);
+
 public:
   /**
   * Constructor.
   * @param r The robot this process corresponds to.
   */
-  ProcessBase(Robot* r) : robot(*r) {}
+  ProcessBase(Robot* r) : robot(*r), seedGeneration(0) {}
 
   /**
   * Virtual destructor.
@@ -245,6 +275,22 @@ public:
   */
   void start() {Thread<ProcessBase>::start( this, &ProcessBase::main);}
 
+  /**
+  * The function announces that the thread shall stop. It also wakes up
+  * the thread if it is waiting for its turn in lockstep mode.
+  */
+  void announceStop()
+  {
+    Thread<ProcessBase>::announceStop();
+    tick.post();
+  }
+
+  /**
+  * The function allows the process to check for events once in lockstep mode.
+  * It also releases the process when the lockstep mode was switched off.
+  */
+  void startTick() {tick.post();}
+
   /**
   * The functions searches for a sender with a given name.
   * @param name The name of the sender.
@@ -300,23 +346,41 @@ protected:
   */
   virtual void main()
   {
+    seedRandom();
+
     // Call process.nextFrame if no blocking receivers are waiting
     process.setBlockingId(31);
     process.setEventId(31);
     setPriority(process.getPriority());
     SystemCall::sleep(1); // always leave processing time to other threads
     while(isRunning())
-    {
-      if(process.getFirstSender())
-        process.getFirstSender()->checkAllForRequests();
-      if(process.getFirstReceiver())
-        process.getFirstReceiver()->checkAllForPackages();
-      process.checkTime();
-      SystemCall::sleep(1); // always leave processing time to other threads
-    }
+      if(waitForTick())
+      {
+        const unsigned numberOfFrames = process.getNumberOfFrames();
+        checkForEvents();
+        finishTick(process.getNumberOfFrames() != numberOfFrames);
+      }
+      else
+      {
+        checkForEvents();
+        SystemCall::sleep(1); // always leave processing time to other threads
+      }
     process.terminate();
   }
 
+  /**
+  * The function checks all senders, receivers, and the timer for events.
+  * If an event the process is waiting for occurred, a frame is executed.
+  */
+  void checkForEvents()
+  {
+    if(process.getFirstSender())
+      process.getFirstSender()->checkAllForRequests();
+    if(process.getFirstReceiver())
+      process.getFirstReceiver()->checkAllForPackages();
+    process.checkTime();
+  }
+
 public:
   /**
   * Constructor.
@@ -9,9 +9,12 @@
 #include "Platform/SimRobotQt/LocalRobot.h"
 #include "Robot.h"
 #include "Tools/Streams/InStreams.h"
+#include <algorithm>
 
 Robot::Robot(const char* name, SimObject* obj)
-: name(name)
+: name(name),
+  round(0),
+  framesExecuted(false)
 {
   this->obj = obj;
 
@@ -42,11 +45,47 @@ Robot::Robot(const char* name, SimObject* obj)
     broadcastReceiver = (*i)->getBroadcastReceiver();
 }
 
+void Robot::prepareUpdate()
+{
+  static_cast<LocalRobot*>(robotProcess)->prepareUpdate();
+}
+
 void Robot::update()
 {
   robotProcess->update();
 }
 
+void Robot::startTick()
+{
+  round = 0;
+  framesExecuted = false;
+  front()->startTick();
+}
+
+void Robot::finishTick(ProcessBase* process, bool frameExecuted)
+{
+  // Only the process that has its turn calls this function, so no synchronization is required.
+  const int maxRounds = 10; // in case processes keep triggering each other
+  framesExecuted |= frameExecuted;
+  iterator i = std::find(begin(), end(), process);
+  ASSERT(i != end());
+  if(++i != end())
+    (*i)->startTick();
+  else if(framesExecuted && ++round < maxRounds)
+  {
+    framesExecuted = false;
+    front()->startTick();
+  }
+  else
+    tickDone.post();
+}
+
+void Robot::releaseProcesses()
+{
+  for(iterator i = begin(); i != end(); ++i)
+    (*i)->startTick();
+}
+
 std::string Robot::getModel() const
 {
   return "Nao";
@@ -25,6 +25,10 @@ private:
   SimObject* obj; /**< A pointer to the associated robot in SimRobot. */
   std::string name; /**< The name of the robot. */
   PlatformProcess* broadcastReceiver; /**< The receiver of broadcast packages. */
+  Semaphore tickDone; /**< Signals that all processes finished the current tick in lockstep mode. */
+  int round; /**< The number of rounds through all processes in the current tick. */
+  bool framesExecuted; /**< Did any process execute a frame in the current round? */
+  std::list<std::string> broadcastPackages; /**< The packages broadcast during the current tick in lockstep mode. */
 
 public:
   /**
@@ -34,6 +38,11 @@ public:
   */
   Robot(const char* name, SimObject* obj);
 
+  /**
+  * The function announces the sensor data that the next call of update() will acquire.
+  */
+  void prepareUpdate();
+
   /**
   * The function updates all sensors and sends motor commands to SimRobot.
   */
@@ -82,6 +91,48 @@ public:
   */
   bool listensForBroadcastPackages() const {return broadcastReceiver != 0;}
 
+  /**
+  * The function starts a tick in lockstep mode. The processes check for events
+  * one after another in a fixed order. Rounds through all processes are repeated
+  * until no process executes a frame anymore, so that all data sent in this tick
+  * is processed. Since the processes of a robot never run at the same time, the
+  * results do not depend on the scheduling of the threads, but the processes of
+  * different robots run in parallel.
+  */
+  void startTick();
+
+  /**
+  * The function is called by a process when it finished its turn in the current tick.
+  * @param process The process.
+  * @param frameExecuted Did the process execute a frame in its turn?
+  */
+  void finishTick(ProcessBase* process, bool frameExecuted);
+
+  /**
+  * The function waits until all processes finished the current tick.
+  */
+  void waitForTick() {tickDone.wait();}
+
+  /**
+  * The function releases all processes from waiting for their turn.
+  * It must be called after the lockstep mode was switched off.
+  */
+  void releaseProcesses();
+
+  /**
+  * The method stores a package broadcast by a process of this robot in lockstep mode.
+  * The packages are delivered after all robots finished the tick.
+  * @param package The package.
+  * @param size The size of the package.
+  */
+  void queueBroadcastPackage(const char* package, unsigned size) {broadcastPackages.push_back(std::string(package, size));}
+
+  /**
+  * The method returns the packages broadcast during the current tick and removes them.
+  * @param packages The packages are returned here.
+  */
+  void takeBroadcastPackages(std::list<std::string>& packages) {packages.swap(broadcastPackages); broadcastPackages.clear();}
+
 private:
   /**
   * The function looks up a sender.
@@ -9,6 +9,7 @@
 #include <sys/timeb.h>
 #ifndef _WIN32
 #include <sys/sysinfo.h>
+#include <time.h>
 #endif
 
 unsigned SystemCall::getCurrentSystemTime() 
@@ -34,6 +35,23 @@ unsigned SystemCall::getRealSystemTime()
   return time - base;
 }
 
+unsigned SystemCall::getUsSystemTime()
+{
+#ifdef _WIN32
+  static LARGE_INTEGER frequency = {0};
+  if(!frequency.QuadPart)
+    QueryPerformanceFrequency(&frequency);
+  LARGE_INTEGER counter;
+  QueryPerformanceCounter(&counter);
+  return unsigned(counter.QuadPart / frequency.QuadPart * 1000000 + 
+                  counter.QuadPart % frequency.QuadPart * 1000000 / frequency.QuadPart);
+#else
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return unsigned(ts.tv_sec) * 1000000 + unsigned(ts.tv_nsec / 1000);
+#endif
+}
+
 const char* SystemCall::getHostName()
 {
   static char buf[100];
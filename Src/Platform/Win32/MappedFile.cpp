@@ -0,0 +1,97 @@
+/**
+* \file Platform/Win32/MappedFile.cpp
+* Implements a class for mapping files into memory.
+* This is the Win32 implementation.
+*/
+
+#undef UNICODE
+#include <windows.h>
+#include <string.h>
+
+#include "MappedFile.h"
+#include "Platform/File.h"
+
+MappedFile::MappedFile() : file(INVALID_HANDLE_VALUE), mapping(0), size(0), view(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+bool MappedFile::open(const std::string& rawName)
+{
+  close();
+
+  std::string name(rawName);
+  if(name[0] != '/' && name[0] != '\\' && name[0] != '.' && (name[0] == 0 || name[1] != ':'))
+    name = std::string(File::getGTDir()) + "/Config/" + rawName;
+
+  file = CreateFile(name.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, 0);
+
+  // if file doesn't exist; fall back to the default location
+  if(file == INVALID_HANDLE_VALUE && !strncmp(rawName.c_str(), "Locations/", 10) && 
+     strncmp(rawName.c_str() + 10, "Default/", 8))
+  {
+    const char* subPath = strchr(rawName.c_str() + 10, '/');
+    if(subPath)
+    {
+      name = std::string(File::getGTDir()) + "/Config/Locations/Default/" + (subPath + 1);
+      file = CreateFile(name.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, 0);
+    }
+  }
+  if(file == INVALID_HANDLE_VALUE)
+    return false;
+  LARGE_INTEGER fileSize;
+  if(!GetFileSizeEx((HANDLE) file, &fileSize) || !fileSize.QuadPart ||
+     !(mapping = CreateFileMapping((HANDLE) file, 0, PAGE_READONLY, 0, 0, 0)))
+  {
+    close();
+    return false;
+  }
+  size = fileSize.QuadPart;
+  return true;
+}
+
+void MappedFile::close()
+{
+  unmap();
+  if(mapping)
+  {
+    CloseHandle((HANDLE) mapping);
+    mapping = 0;
+  }
+  if(file != INVALID_HANDLE_VALUE)
+  {
+    CloseHandle((HANDLE) file);
+    file = INVALID_HANDLE_VALUE;
+  }
+  size = 0;
+}
+
+const char* MappedFile::map(unsigned long long offset, size_t length)
+{
+  unmap();
+  if(!mapping || offset + length > size || !length)
+    return 0;
+
+  // views must start at a multiple of the allocation granularity
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  const unsigned long long start = offset / info.dwAllocationGranularity * info.dwAllocationGranularity;
+  view = MapViewOfFile((HANDLE) mapping, FILE_MAP_READ, (DWORD) (start >> 32), (DWORD) start, 
+                       (SIZE_T) (offset - start) + length);
+  if(!view)
+    return 0;
+  return (const char*) view + (offset - start);
+}
+
+void MappedFile::unmap()
+{
+  if(view)
+  {
+    UnmapViewOfFile(view);
+    view = 0;
+  }
+}
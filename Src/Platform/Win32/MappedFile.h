@@ -0,0 +1,79 @@
+/**
+* \file Platform/Win32/MappedFile.h
+* Declares a platform dependend class for mapping files into memory.
+* This is the Win32 implementation.
+*/
+
+#ifndef __MAPPEDFILE_H__
+#define __MAPPEDFILE_H__
+
+#include <string>
+
+/**
+* A class for read-only access to a file through memory mapping.
+* Only a single range of the file is mapped at a time, so files of any size
+* can be accessed with a bounded amount of address space.
+*/
+class MappedFile
+{
+public:
+
+  /**
+  * Default constructor.
+  */
+  MappedFile();
+
+  /**
+  * Destructor.
+  */
+  ~MappedFile();
+
+  /**
+  * Opens a file for reading.
+  * \param name The name of the file. It is interpreted as relative to the
+  *             configuration directory, unless it is an absolute path.
+  *             Files in a location are searched in the default location
+  *             if they do not exist in the location itself.
+  * \return Whether the file was opened successfully.
+  */
+  bool open(const std::string& name);
+
+  /**
+  * Closes the file.
+  */
+  void close();
+
+  /**
+  * Returns whether a file is open.
+  * \return Is a file open?
+  */
+  bool isOpen() const {return mapping != 0;}
+
+  /**
+  * Returns the size of the file opened.
+  * \return The size in bytes.
+  */
+  unsigned long long getSize() const {return size;}
+
+  /**
+  * Maps a range of the file into memory. The range mapped before is unmapped.
+  * \param offset The offset of the first byte of the range in the file.
+  * \param length The number of bytes in the range.
+  * \return The address of the first byte of the range or 0 if it could not be mapped.
+  */
+  const char* map(unsigned long long offset, size_t length);
+
+private:
+
+  void* file; /**< File handle. */
+  void* mapping; /**< File mapping handle. */
+  unsigned long long size; /**< The size of the file. */
+  void* view; /**< The address of the mapped range. */
+
+  /**
+  * Unmaps the range mapped.
+  */
+  void unmap();
+};
+
+#endif //!__MAPPEDFILE_H__
@@ -188,6 +188,67 @@ class Sync
     ~Sync() {syncObject.leave();}
 };
 
+/**
+ * The class encapsulates a counting semaphore.
+ */
+class Semaphore
+{
+  private:
+    HANDLE handle; /**< The Windows handle of the semaphore. */
+
+  public:
+    /**
+     * Constructor.
+     * @param value The initial value of the semaphore.
+     */
+    Semaphore(unsigned value = 0) {handle = CreateSemaphore(0, value, 0x7fffffff, 0);}
+
+    /**
+     * Destructor.
+     */
+    ~Semaphore() {CloseHandle(handle);}
+
+    /**
+     * The function increments the semaphore and wakes up a waiting thread.
+     */
+    void post() {ReleaseSemaphore(handle, 1, 0);}
+
+    /**
+     * The function suspends the current thread until the semaphore is
+     * greater than zero and then decrements it.
+     */
+    void wait() {WaitForSingleObject(handle, INFINITE);}
+};
+
+/**
+ * A class providing atomic operations on integers.
+ */
+class Atomic
+{
+  public:
+    /**
+     * The function atomically adds a value to a variable.
+     * @param var The variable.
+     * @param value The value added.
+     * @return The new value of the variable.
+     */
+    static int add(volatile int& var, int value) {return InterlockedExchangeAdd((volatile LONG*) &var, value) + value;}
+
+    /**
+     * The function atomically replaces the value of a variable if it has an expected value.
+     * @param var The variable.
+     * @param expected The value the variable must have.
+     * @param value The new value of the variable.
+     * @return Was the value replaced?
+     */
+    static bool compareAndSwap(volatile int& var, int expected, int value) {return InterlockedCompareExchange((volatile LONG*) &var, value, expected) == expected;}
+
+    /**
+     * The function prevents the compiler and the processor from reordering memory accesses across it.
+     */
+    static void barrier() {MemoryBarrier();}
+};
+
 /**
  * The macro places a SyncObject as member variable into a class.
  * This is the precondition for using the macro SYNC.
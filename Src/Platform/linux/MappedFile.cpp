@@ -0,0 +1,99 @@
+/**
+* \file Platform/linux/MappedFile.cpp
+* Implements a class for mapping files into memory.
+* This is the POSIX implementation.
+*/
+
+#define _FILE_OFFSET_BITS 64
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+
+#include "MappedFile.h"
+#include "Platform/File.h"
+
+MappedFile::MappedFile() : fd(-1), size(0), view(0), viewSize(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+bool MappedFile::open(const std::string& rawName)
+{
+  close();
+
+  std::string name(rawName);
+  for(int i = (int) name.length() - 1; i >= 0; i--)
+    if(name[i] == '\\')
+      name[i] = '/';
+  if(name[0] != '/' && name[0] != '.')
+    fd = ::open((std::string(File::getGTDir()) + "/Config/" + name).c_str(), O_RDONLY);
+  else
+    fd = ::open(name.c_str(), O_RDONLY);
+
+  // if file doesn't exist; fall back to the default location
+  if(fd == -1 && !strncmp(name.c_str(), "Locations/", 10) && strncmp(name.c_str() + 10, "Default/", 8))
+  {
+    const char* subPath = strchr(name.c_str() + 10, '/');
+    if(subPath)
+      fd = ::open((std::string(File::getGTDir()) + "/Config/Locations/Default/" + (subPath + 1)).c_str(), O_RDONLY);
+  }
+  if(fd == -1)
+    return false;
+  struct stat buff;
+  if(fstat(fd, &buff) != 0)
+  {
+    close();
+    return false;
+  }
+  size = buff.st_size;
+  return true;
+}
+
+void MappedFile::close()
+{
+  unmap();
+  if(fd != -1)
+  {
+    ::close(fd);
+    fd = -1;
+  }
+  size = 0;
+}
+
+const char* MappedFile::map(unsigned long long offset, size_t length)
+{
+  unmap();
+  if(fd == -1 || offset + length > size || !length)
+    return 0;
+
+  // mappings must start at a page boundary
+  const unsigned long long pageSize = sysconf(_SC_PAGESIZE);
+  const unsigned long long start = offset / pageSize * pageSize;
+  viewSize = (size_t) (offset - start) + length;
+  view = mmap(0, viewSize, PROT_READ, MAP_SHARED, fd, (off_t) start);
+  if(view == MAP_FAILED)
+  {
+    view = 0;
+    viewSize = 0;
+    return 0;
+  }
+  madvise(view, viewSize, MADV_SEQUENTIAL);
+  return (const char*) view + (offset - start);
+}
+
+void MappedFile::unmap()
+{
+  if(view)
+  {
+    munmap(view, viewSize);
+    view = 0;
+    viewSize = 0;
+  }
+}
@@ -6,6 +6,7 @@
  * @author <a href="mailto:Thomas.Roefer@dfki.de">Thomas Rfer</a>
  */
 #include "Platform/ProcessFramework.h"
+#include "Tools/Math/Common.h"
 
 void PlatformProcess::nextFrame()
   {
@@ -35,6 +36,19 @@ void PlatformProcess::nextFrame()
     setBlockingId(31,frameTime != 0);
   }
 
+void ProcessBase::seedRandom()
+{
+  // FNV-1a hash of the process name, the thread, and the time, so each process gets a different sequence
+  unsigned seed = 2166136261u;
+  for(const char* p = getName(); *p; ++p)
+    seed = (seed ^ (unsigned char) *p) * 16777619u;
+  const unsigned values[2] = {getCurrentId(), SystemCall::getUsSystemTime()};
+  for(int i = 0; i < 2; ++i)
+    for(int j = 0; j < 32; j += 8)
+      seed = (seed ^ ((values[i] >> j) & 0xff)) * 16777619u;
+  randomSeed(seed);
+}
+
 /*
  * ProcessCreatorBase::list must be initialized before any code generated
  * by MAKE_PROCESS is executed. Therefore, early initialization is forced.
@@ -176,6 +176,12 @@ protected:
   * The main function of this Windows thread.
   */
   virtual void main() = 0;
+
+  /**
+  * The function seeds the random number generator of this thread with a value
+  * that depends on the name of the process, its thread, and the current time.
+  */
+  void seedRandom();
   
 public:
   /**
@@ -236,6 +242,8 @@ protected:
   */
   virtual void main()
   {
+    seedRandom();
+
     // Call process.nextFrame if no blocking receivers are waiting
     process.setBlockingId(31);
     process.setEventId(31);
@@ -25,6 +25,7 @@ ReceiverList::ReceiverList(PlatformProcess* p,const char* receiverName,bool bloc
   next = 0;
   this->blocking = blocking;
   package = 0;
+  readers = 0;
 }
 
 ReceiverList*& ReceiverList::getFirst()
@@ -31,7 +31,8 @@ class ReceiverList
     int eventId;                /**< The id of the current receiver in the range [0..30]. */
     bool blocking;              /**< Stores whether this is a blocking receiver. */
     typedef unsigned char byte;
-    byte* package;              /**< A received package. */
+    byte* package;              /**< A received package. It is located in a buffer of the sender. */
+    volatile int* readers;      /**< The reader count of the sender's buffer containing the package. */
 
     /**
      * The function checks whether a new package has arrived.
@@ -48,14 +49,6 @@ class ReceiverList
      */
     ReceiverList(PlatformProcess* process, const char* receiverName, bool blocking);
 
-    /**
-     * Destructor.
-     */
-    ~ReceiverList()
-    {
-      if(package)
-        delete [] package;
-    }
 
     /**
      * Returns the begin of the list of all receivers.
@@ -95,11 +88,23 @@ class ReceiverList
     /**
      * The function sets the package.
      * @param p The package.
+     * @param r The reader count of the sender's buffer containing the package.
+     *          It is decremented when the package was processed.
      */
-    void setPackage(void* p)
+    void setPackage(void* p, volatile int* r)
     {
+      readers = r;
       package = static_cast<byte *>(p);
-   }
+    }
+
+    /**
+     * The function releases the package, i.e. the sender can reuse its buffer.
+     */
+    void releasePackage()
+    {
+      Atomic::add(*readers, -1);
+      package = 0;
+    }
 
     /**
      * The function determines whether the receiver has a pending package.
@@ -141,8 +146,7 @@ template<class T> class Receiver : public ReceiverList, public T
         InBinaryMemory memory(package);
         memory >> data;
         process->setEventId(eventId);
-        delete [] package;
-        package = 0;
+        releasePackage();
       }
     }
 
@@ -24,6 +24,26 @@ SenderList::SenderList(PlatformProcess* p,const char* senderName,bool blocking)
     getFirst() = this;
   next = 0;
   this->blocking = blocking;
+  published = -1;
+}
+
+void SenderList::Buffer::reserve(int size)
+{
+  if(size > capacity)
+  {
+    delete [] data;
+    capacity = size + size / 4; // leave some room for growth
+    data = new char[capacity];
+  }
+}
+
+int SenderList::getFreeBuffer() const
+{
+  for(int i = 0; i < RECEIVERS_MAX + 2; ++i)
+    if(i != published && !buffers[i].readers)
+      return i;
+  ASSERT(false); // there is at most one buffer per receiver being read
+  return 0;
 }
 
 SenderList*& SenderList::getFirst()
@@ -24,9 +24,46 @@ class SenderList
     char name[NAME_LENGTH_MAX]; /**< The name of a sender without the module's name. */
   
   protected:
+    /**
+     * A preallocated buffer a package is serialized into. Receivers read the package
+     * directly from the buffer. The buffer is only overwritten after all receivers
+     * released it.
+     */
+    class Buffer
+    {
+      public:
+        char* data;           /**< The memory of the buffer. */
+        int capacity;         /**< The size of the memory. */
+        volatile int readers; /**< The number of receivers that currently read the package. */
+
+        /**
+         * Constructor.
+         */
+        Buffer() : data(0), capacity(0), readers(0) {}
+
+        /**
+         * Destructor.
+         */
+        ~Buffer() {delete [] data;}
+
+        /**
+         * The function enlarges the buffer. Its content is lost.
+         * @param size The minimum size required.
+         */
+        void reserve(int size);
+    };
+
     PlatformProcess* process;   /**< The process this sender is associated with. */
     int eventId;                /**< The id of the current sender in the range [0..30]. */
     bool blocking;              /**< Stores whether this is a blocking sender. */
+    Buffer buffers[RECEIVERS_MAX + 2]; /**< The buffers. One is written, one contains the current package, and the others can be read by receivers. */
+    int published;              /**< The index of the buffer that contains the current package or -1 if there is none. */
+
+    /**
+     * The function returns a buffer that is neither the current package nor read by any receiver.
+     * @return The index of the buffer.
+     */
+    int getFreeBuffer() const;
 
     /**
      * The function sends a package to all receivers that requested it.
@@ -143,14 +180,9 @@ template<class T> class Sender : public SenderList, public T
                 break;
             if(j == numOfAlreadyReceived)
             { // receiver[i] has not received its requested package yet
-              const T& data = *static_cast<const T*>(this);
-              OutBinarySize size;
-              size << data;
-              void* r = (void*) new char[size.getSize()];
-              ASSERT(r);
-              OutBinaryMemory memory(r);
-              memory << data;
-              receiver[i]->setPackage(r);
+              Buffer& buffer = buffers[published];
+              Atomic::add(buffer.readers, 1);
+              receiver[i]->setPackage(buffer.data, &buffer.readers);
               // note that receiver[i] has received the current package
               ASSERT(numOfAlreadyReceived < RECEIVERS_MAX);
               alreadyReceived[numOfAlreadyReceived++] = receiver[i];
@@ -191,10 +223,24 @@ template<class T> class Sender : public SenderList, public T
     /**
      * Marks the package for sending and transmits it to all receivers that already requested for it.
      * All other receiver may get it later if they request for it before the package is changed.
+     * The package is serialized only once into a buffer that no receiver is reading.
+     * The buffers grow to the largest package sent, so no memory is allocated afterwards.
      */
     void send()
     {
       process->setBlockingId(eventId,blocking);
+      const T& data = *static_cast<const T*>(this);
+      Buffer& buffer = buffers[getFreeBuffer()];
+      OutBinaryBoundedMemory memory(buffer.data, buffer.capacity);
+      memory << data;
+      if(!memory.isComplete()) // the package has grown, so stream it again into a larger buffer
+      {
+        buffer.reserve(memory.getLength());
+        OutBinaryMemory memory2(buffer.data);
+        memory2 << data;
+      }
+      Atomic::barrier(); // the package must be complete before it can be received
+      published = &buffer - buffers;
       numOfAlreadyReceived = 0;
       sendPackage();
     }
@@ -12,6 +12,7 @@
 #include "Platform/SystemCall.h"
 #include "Platform/GTAssert.h"
 #include <sys/timeb.h>
+#include <time.h>
 #include <unistd.h>
 #include <string>
 #include <sys/sysinfo.h>
@@ -33,6 +34,13 @@ unsigned SystemCall::getRealSystemTime()
   return time - base;
 }
 
+unsigned SystemCall::getUsSystemTime()
+{
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return unsigned(ts.tv_sec) * 1000000 + unsigned(ts.tv_nsec / 1000);
+}
+
 const char* SystemCall::getHostName()
 {
   static char buf[100];
@@ -39,6 +39,9 @@ public:
   
   /** returns the real system time in milliseconds (never the simulated one)*/
   static unsigned getRealSystemTime ();
+
+  /** returns a monotonic real system time in microseconds (for measuring short durations)*/
+  static unsigned getUsSystemTime();
   
   /** returns the time since aTime*/
   static int getTimeSince(unsigned long aTime) 
@@ -7,10 +7,10 @@
 #include "TeamHandler.h"
 #include "Platform/GTAssert.h"
 #include "Platform/SystemCall.h"
-#include "Tools/Streams/OutStreams.h"
-#include "Tools/Streams/InStreams.h"
+#include "Tools/CRC.h"
 #include <netdb.h>
 #include <sys/ioctl.h>
+#include <unistd.h>
 
 TeamHandler::TeamHandler(MessageQueue& in, MessageQueue& out) :
 in(in),
@@ -55,23 +55,18 @@ void TeamHandler::send()
 
   if(!out.isEmpty())
   {
-    OutBinarySize size;
-    size << out;
-    char* package = new char[size.getSize() + 4];
-    ASSERT(package);
-    OutBinaryMemory memory(package + 4);
-    memory << out;
-    ((unsigned short*) package)[1] = size.getSize() + 4;
-    ((unsigned short*) package)[0] = calcCRC16(package + 2, size.getSize() + 2);
+    // A packet consists of a CRC16 checksum, its size, and the messages in the compact format.
+    // Messages that do not fit into the packet are dropped.
+    const int size = 4 + out.writeCompact(packet + 4, packetSize - 4);
+    ((unsigned short*) packet)[1] = (unsigned short) size;
+    ((unsigned short*) packet)[0] = CRC::calcCRC16(packet + 2, size - 2);
 
     sockaddr_in address;
     address.sin_family = AF_INET;
     address.sin_port = htons(port);
     address.sin_addr.s_addr = INADDR_BROADCAST;
-    if(sendto(udpSocket, package, size.getSize() + 4, 0, (struct sockaddr *) &address, sizeof(address)) == (int)size.getSize() + 4)
+    if(sendto(udpSocket, packet, size, 0, (struct sockaddr *) &address, sizeof(address)) == size)
       out.clear();
-
-    delete [] package;
   }
 }
 
@@ -80,39 +75,20 @@ void TeamHandler::receive()
   if(!port)
     return; // not started yet
 
-  char buffer[1400];
   int size;
   do
   {
-    size = recv(udpSocket, buffer, sizeof(buffer), 0);
-    if(size >= 4 && size == ((unsigned short*) buffer)[1] && 
-       ((unsigned short*) buffer)[0] == calcCRC16(buffer + 2, size - 2))
+    size = recv(udpSocket, packet, packetSize, 0);
+    if(size >= 4 && size == ((unsigned short*) packet)[1] && 
+       ((unsigned short*) packet)[0] == CRC::calcCRC16(packet + 2, size - 2) &&
+       MessageQueue::isValidCompact(packet + 4, size - 4)) // invalid packets are dropped
     {
       in.out.bin << SystemCall::getCurrentSystemTime();
       in.out.finishMessage(idReceiveTimeStamp);
-      InBinaryMemory memory(buffer + 4, size - 4);
-      memory >> in;
-      ASSERT(memory.eof());
+      in.appendCompact(packet + 4, size - 4);
     }
   }
   while(size > 0);
 }
 
-unsigned short TeamHandler::calcCRC16(const char* address, unsigned size) const
-{
-  unsigned short crc16 = 0;
-  unsigned char lastChar = 0;
-  while(size--)
-  {
-    if(crc16 & 0x8000)
-      crc16 = (crc16 << 1) ^ 0x8005;
-    else
-      crc16 <<= 1;
-    unsigned char c = *address++;
-    crc16 ^= (unsigned short) (c | (lastChar << 8));
-    lastChar = c;
-  }
-  return crc16;
-}
-
 
@@ -50,13 +50,8 @@ private:
               & out; /**< Outgoing debug data is stored here. */
   int port; /**< The UDP port this handler is listening to. */
   int udpSocket; /**< The socket used to communicate. */
-
-  /**
-  * The method calculates a CRC16 checksum of a memory area.
-  * @param address The begin of the area.
-  * @param size The length of the area in bytes.
-  */
-  unsigned short calcCRC16(const char* address, unsigned size) const;
+  enum {packetSize = 1400}; /**< The maximum size of a packet in bytes. */
+  char packet[packetSize]; /**< The packet that is sent or received. */
 };
 
 #endif 
@@ -12,6 +12,8 @@
 #define THREAD_H_
 
 #include <pthread.h>
+#include <semaphore.h>
+#include <errno.h>
 #include <unistd.h>
 #include <iostream> // TODO: remove me
 #include "Platform/GTAssert.h"
@@ -217,6 +219,80 @@ public:
   ~Sync() {syncObject.leave();}
 };
 
+/**
+* A class encapsulating a counting semaphore.
+*/
+class Semaphore
+{
+private:
+  sem_t semaphore; /**< The semaphore. */
+
+public:
+  /**
+  * Constructor.
+  * @param value The initial value of the semaphore.
+  */
+  Semaphore(unsigned value = 0)
+  {
+    VERIFY(sem_init(&semaphore, 0, value) == 0);
+  }
+
+  /**
+  * Destructor.
+  */
+  ~Semaphore()
+  {
+    sem_destroy(&semaphore);
+  }
+
+  /**
+  * The function increments the semaphore and wakes up a waiting thread.
+  */
+  void post()
+  {
+    sem_post(&semaphore);
+  }
+
+  /**
+  * The function suspends the current thread until the semaphore is
+  * greater than zero and then decrements it.
+  */
+  void wait()
+  {
+    while(sem_wait(&semaphore) == -1 && errno == EINTR)
+      ;
+  }
+};
+
+/**
+* A class providing atomic operations on integers.
+*/
+class Atomic
+{
+public:
+  /**
+  * The function atomically adds a value to a variable.
+  * @param var The variable.
+  * @param value The value added.
+  * @return The new value of the variable.
+  */
+  static int add(volatile int& var, int value) {return __sync_add_and_fetch(&var, value);}
+
+  /**
+  * The function atomically replaces the value of a variable if it has an expected value.
+  * @param var The variable.
+  * @param expected The value the variable must have.
+  * @param value The new value of the variable.
+  * @return Was the value replaced?
+  */
+  static bool compareAndSwap(volatile int& var, int expected, int value) {return __sync_bool_compare_and_swap(&var, expected, value);}
+
+  /**
+  * The function prevents the compiler and the processor from reordering memory accesses across it.
+  */
+  static void barrier() {__sync_synchronize();}
+};
+
 /**
 * The macro places a SyncObject as member variable into a class.
 * This is the precondition for using the macro SYNC.
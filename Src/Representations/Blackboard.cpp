@@ -35,6 +35,7 @@ Blackboard::Blackboard() :
   // Configuration
   theRobotName(theRobotName),
   theColorTable64(theColorTable64),
+  theCompactColorTable64(theCompactColorTable64),
   theCameraSettings(theCameraSettings),
   theFieldDimensions(theFieldDimensions),
   theRobotDimensions(theRobotDimensions),
@@ -55,6 +56,7 @@ Blackboard::Blackboard() :
   theExtendedBallPercepts(theExtendedBallPercepts),
   theLinePercept(theLinePercept),
   theRegionPercept(theRegionPercept),
+  theColorClassPlane(theColorClassPlane),
   theFilteredJointData(theFilteredJointData),
   theFilteredSensorData(theFilteredSensorData),
   theGoalPercept(theGoalPercept),
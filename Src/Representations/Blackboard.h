@@ -36,6 +36,7 @@ class BoardInfo;
 // Configuration
 class RobotName;
 class ColorTable64;
+class CompactColorTable64;
 class CameraSettings;
 class FieldDimensions;
 class RobotDimensions;
@@ -56,6 +57,7 @@ class BallPercept;
 class ExtendedBallPercepts;
 class LinePercept;
 class RegionPercept;
+class ColorClassPlane;
 class FilteredJointData;
 class FilteredSensorData;
 class GoalPercept;
@@ -95,6 +97,7 @@ class SensorPrediction;
 class Process;
 class Cognition;
 class Motion;
+class ParallelExecutor;
 
 /**
 * @class Blackboard
@@ -133,6 +136,7 @@ protected:
   // Configuration
   const RobotName& theRobotName;
   const ColorTable64& theColorTable64;
+  const CompactColorTable64& theCompactColorTable64;
   const CameraSettings& theCameraSettings;
   const FieldDimensions& theFieldDimensions;
   const RobotDimensions& theRobotDimensions;
@@ -153,6 +157,7 @@ protected:
   const ExtendedBallPercepts& theExtendedBallPercepts;
   const LinePercept& theLinePercept;
   const RegionPercept& theRegionPercept;
+  const ColorClassPlane& theColorClassPlane;
   const FilteredJointData& theFilteredJointData;
   const FilteredSensorData& theFilteredSensorData;
   const GoalPercept& theGoalPercept;
@@ -236,6 +241,7 @@ public:
   friend class Process; /**< The class Process can set theInstance. */
   friend class Cognition; /**< The class Cognition can read theInstance. */
   friend class Motion; /**< The class Motion can read theInstance. */
+  friend class ParallelExecutor; /**< The class ParallelExecutor can share theInstance with its threads. */
 };
 
 #endif //__Blackboard_h_
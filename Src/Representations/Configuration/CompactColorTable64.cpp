@@ -0,0 +1,77 @@
+/**
+* @file CompactColorTable64.cpp
+* Implementation of class CompactColorTable64.
+*/
+
+#include <cstring>
+#include <map>
+#include "CompactColorTable64.h"
+#include "Platform/GTAssert.h"
+
+CompactColorTable64::CompactColorTable64() :
+  blocks(64, (unsigned char) ColorClasses::none)
+{
+  memset(blockIndex, 0, sizeof(blockIndex));
+}
+
+void CompactColorTable64::fromColorTable(const ColorTable64& colorTable)
+{
+  std::map<std::vector<unsigned char>, unsigned short> blockNumbers;
+  std::vector<unsigned char> block(64);
+  blocks.clear();
+  for(int u = 0; u < 64; ++u)
+    for(int v = 0; v < 64; ++v)
+    {
+      for(int y = 0; y < 64; ++y)
+        block[y] = colorTable.colorClasses[y][u][v];
+      std::map<std::vector<unsigned char>, unsigned short>::const_iterator i = blockNumbers.find(block);
+      if(i == blockNumbers.end())
+      {
+        i = blockNumbers.insert(std::pair<const std::vector<unsigned char>, unsigned short>(block, (unsigned short) (blocks.size() / 64))).first;
+        blocks.insert(blocks.end(), block.begin(), block.end());
+      }
+      blockIndex[u][v] = i->second;
+    }
+}
+
+void CompactColorTable64::toColorTable(ColorTable64& colorTable) const
+{
+  for(int u = 0; u < 64; ++u)
+    for(int v = 0; v < 64; ++v)
+    {
+      const unsigned char* block = &blocks[blockIndex[u][v] << 6];
+      for(int y = 0; y < 64; ++y)
+        colorTable.colorClasses[y][u][v] = block[y];
+    }
+}
+
+void CompactColorTable64::generateColorClassImage(const Image& image, ColorClassImage& colorClassImage) const
+{
+  colorClassImage.width = image.cameraInfo.resolutionWidth;
+  colorClassImage.height = image.cameraInfo.resolutionHeight;
+
+  for(int y = image.cameraInfo.resolutionHeight-1; y >= 0; --y)
+    for(int x = image.cameraInfo.resolutionWidth-1; x >= 0; --x)
+    {
+      const Image::Pixel& cur = image.image[y][x];
+      colorClassImage.image[y][x] = blocks[blockIndex[cur.cb >> 2][cur.cr >> 2] << 6 | cur.y >> 2];
+    }
+}
+
+Out& operator<<(Out& stream, const CompactColorTable64& colorTable)
+{
+  ColorTable64* colorTable64 = new ColorTable64;
+  colorTable.toColorTable(*colorTable64);
+  stream << *colorTable64;
+  delete colorTable64;
+  return stream;
+}
+
+In& operator>>(In& stream, CompactColorTable64& colorTable)
+{
+  ColorTable64* colorTable64 = new ColorTable64;
+  stream >> *colorTable64;
+  colorTable.fromColorTable(*colorTable64);
+  delete colorTable64;
+  return stream;
+}
@@ -0,0 +1,94 @@
+/**
+* @file CompactColorTable64.h
+* Declaration of class CompactColorTable64.
+*/
+
+#ifndef _CompactColorTable64_h_
+#define _CompactColorTable64_h_
+
+#include "ColorTable64.h"
+#include <vector>
+
+/**
+* @class CompactColorTable64
+*
+* A cache-friendly layout of a ColorTable64. The table is organized by Cb and Cr.
+* For each combination, it references a block of the 64 color classes along the Y axis.
+* Identical blocks are only stored once. Since most Cb/Cr combinations are not
+* segmented at all, only a few different blocks exist, so the whole table usually
+* occupies a few dozen kilobytes instead of 256 KB.
+* The class is read from and written to streams in the .c64 format.
+*/
+class CompactColorTable64
+{
+public:
+  /** Constructor. Creates an empty table that classifies everything as none. */
+  CompactColorTable64();
+
+  /**
+  * The method sets the content of this table from a ColorTable64.
+  * @param colorTable The color table that is converted.
+  */
+  void fromColorTable(const ColorTable64& colorTable);
+
+  /**
+  * The method writes the content of this table to a ColorTable64.
+  * @param colorTable The color table that is set.
+  */
+  void toColorTable(ColorTable64& colorTable) const;
+
+  /**
+  * Calculates the color class of a pixel.
+  * @param y the y value of the pixel
+  * @param u the u value of the pixel
+  * @param v the v value of the pixel
+  * @return the color class
+  */
+  ColorClasses::Color getColorClass(const unsigned char y,
+    const unsigned char u,
+    const unsigned char v) const
+  {
+    return (ColorClasses::Color) blocks[blockIndex[u >> 2][v >> 2] << 6 | y >> 2];
+  }
+
+  /**
+  * Segments an image to an color class image.
+  * @param image A reference to the image to be segmented
+  * @param colorClassImage A reference to the color class image to be created
+  */
+  void generateColorClassImage(const Image& image, ColorClassImage& colorClassImage) const;
+
+  /**
+  * The method returns the number of different blocks.
+  * @return The number of blocks stored.
+  */
+  int getNumOfBlocks() const {return (int) blocks.size() / 64;}
+
+  /**
+  * The method returns the memory occupied by the table.
+  * @return The size in bytes.
+  */
+  int getSize() const {return (int) (sizeof(blockIndex) + blocks.size());}
+
+private:
+  unsigned short blockIndex[64][64]; /**< The number of the block in blocks for each Cb/Cr combination. */
+  std::vector<unsigned char> blocks; /**< The color classes of all blocks, 64 per block. */
+};
+
+/**
+* Streaming operator that writes a CompactColorTable64 to a stream in the .c64 format.
+* @param stream The stream to write on.
+* @param colorTable The CompactColorTable64 object.
+* @return The stream.
+*/
+Out& operator<<(Out& stream, const CompactColorTable64& colorTable);
+
+/**
+* Streaming operator that reads a CompactColorTable64 from a stream in the .c64 format.
+* @param stream The stream from which is read.
+* @param colorTable The CompactColorTable64 object.
+* @return The stream.
+*/
+In& operator>>(In& stream, CompactColorTable64& colorTable);
+
+#endif //_CompactColorTable64_h_
@@ -9,12 +9,13 @@
 #include "Image.h"
 #include "Tools/Math/Common.h"
 #include "Tools/ImageProcessing/ColorModelConversions.h"
+#include "Tools/ImageProcessing/YCbCrConversions.h"
 
 Image::Image()
 : timeStamp(0),
   isReference(false)
 {
-  image = new Pixel[cameraResolutionHeight][cameraResolutionWidth * 2];
+  allocate();
   for(int y = 0; y < cameraInfo.resolutionHeight; ++y)
     for(int x = 0; x < cameraInfo.resolutionWidth; ++x)
       image[y][x].color = 0x80008000;
@@ -25,7 +26,7 @@ Image::Image(Settings::Model model)
   timeStamp(0),
   isReference(false)
 {
-  image = new Pixel[cameraResolutionHeight][cameraResolutionWidth * 2];
+  allocate();
   for(int y = 0; y < cameraInfo.resolutionHeight; ++y)
     for(int x = 0; x < cameraInfo.resolutionWidth; ++x)
       image[y][x].color = 0x80008000;
@@ -35,24 +36,34 @@ Image& Image::operator=(const Image& other)
 {
   if(isReference) 
   {
-    image = new Pixel[cameraResolutionHeight][cameraResolutionWidth * 2];
+    allocate();
     isReference = false;
   }
   cameraInfo = other.cameraInfo;
   timeStamp = other.timeStamp;
-  for(int y = 0; y < cameraInfo.resolutionHeight; ++y)
-    memcpy(&image[y], &other.image[y], cameraInfo.resolutionWidth * sizeof(Image::Pixel));
+  if(other.image.stride == cameraInfo.resolutionWidth && image.stride == cameraInfo.resolutionWidth)
+    memcpy(image[0], other.image[0], cameraInfo.resolutionWidth * cameraInfo.resolutionHeight * sizeof(Image::Pixel));
+  else
+    for(int y = 0; y < cameraInfo.resolutionHeight; ++y)
+      memcpy(image[y], other.image[y], cameraInfo.resolutionWidth * sizeof(Image::Pixel));
   return *this;
 }
 
-void Image::setImage(const unsigned char* buffer)
+void Image::allocate()
+{
+  image.pixels = new Pixel[cameraResolutionHeight * cameraResolutionWidth];
+  image.stride = cameraResolutionWidth;
+}
+
+void Image::setImage(const unsigned char* buffer, int stride)
 {
   if(!isReference) 
   {
-    delete [] image;
+    delete [] image.pixels;
     isReference = true;
   }
-  image = (Pixel (*)[cameraResolutionWidth * 2]) buffer;
+  image.pixels = (Pixel*) buffer;
+  image.stride = stride;
 }
 
 void Image::convertFromYCbCrToRGB(const Image& ycbcrImage)
@@ -71,13 +82,7 @@ void Image::convertFromYCbCrToRGB(const Image& ycbcrImage)
 void Image::convertFromRGBToYCbCr(const Image& rgbImage)
 {
   for(int y = 0; y < cameraInfo.resolutionHeight; ++y)
-    for(int x = 0; x < cameraInfo.resolutionWidth; ++x)
-      ColorModelConversions::fromRGBToYCbCr(rgbImage.image[y][x].r,
-                                            rgbImage.image[y][x].g,
-                                            rgbImage.image[y][x].b,
-                                            image[y][x].y,
-                                            image[y][x].cb,
-                                            image[y][x].cr);
+    YCbCrConversions::fromRGB(&rgbImage.image[y][0], &image[y][0], cameraInfo.resolutionWidth);
   this->cameraInfo = rgbImage.cameraInfo;
 }
 
@@ -131,13 +136,21 @@ void Image::serialize(In* in, Out* out)
   STREAM(timeStamp);
 
   if(out)
-    for(int y = 0; y < cameraInfo.resolutionHeight; ++y)
-      out->write(&image[y], cameraInfo.resolutionWidth * sizeof(Pixel));
+  {
+    if(image.stride == cameraInfo.resolutionWidth)
+      out->write(image[0], cameraInfo.resolutionWidth * cameraInfo.resolutionHeight * sizeof(Pixel));
+    else
+      for(int y = 0; y < cameraInfo.resolutionHeight; ++y)
+        out->write(image[y], cameraInfo.resolutionWidth * sizeof(Pixel));
+  }
   else
   {
     cameraInfo = CameraInfo();
-    for(int y = 0; y < cameraInfo.resolutionHeight; ++y)
-      in->read(&image[y], cameraInfo.resolutionWidth * sizeof(Pixel));
+    if(image.stride == cameraInfo.resolutionWidth)
+      in->read(image[0], cameraInfo.resolutionWidth * cameraInfo.resolutionHeight * sizeof(Pixel));
+    else
+      for(int y = 0; y < cameraInfo.resolutionHeight; ++y)
+        in->read(image[y], cameraInfo.resolutionWidth * sizeof(Pixel));
   }
 
   STREAM_REGISTER_FINISH();
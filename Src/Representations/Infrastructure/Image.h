@@ -23,6 +23,9 @@ class Image : public Streamable
 private:
   void serialize(In* in, Out* out);
 
+  /** The method allocates an image owned by this object. */
+  void allocate();
+
 public:
   /**
   * Default constructor.
@@ -32,7 +35,7 @@ public:
   Image(Settings::Model model);
 
   /** destructs an image */
-  ~Image() {if(!isReference) delete [] image;}
+  ~Image() {if(!isReference) delete [] image.pixels;}
 
   /**
   * Copy constructor.
@@ -54,16 +57,18 @@ public:
   /**
   * The method sets an external image.
   * @param buffer The image buffer.
+  * @param stride The distance between the beginnings of two rows in pixels.
+  *               The camera delivers two rows per row of the image.
   */
-  void setImage(const unsigned char* buffer);
+  void setImage(const unsigned char* buffer, int stride = cameraResolutionWidth * 2);
 
   /** Converts an YCbCr image into an RGB image.
   *  @param ycbcrImage The given YCbCr image
   */
   void convertFromYCbCrToRGB(const Image& ycbcrImage);
 
-  /** Converts an RGB image into an YCbCr image.
-  *  @param rgbImage The given RGB image
+  /** Converts an RGB image into an YCbCr image with the channel layout of the camera.
+  *  @param rgbImage The given RGB image. It may be this image.
   */
   void convertFromRGBToYCbCr(const Image& rgbImage);
 
@@ -119,7 +124,25 @@ public:
     };
   };
 
-  Pixel (*image)[cameraResolutionWidth * 2]; /**< The image. Please not that the second half of each row must be ignored. */
+  /**
+  * The class provides access to the rows of an image, so that pixels can be
+  * accessed as image[y][x] independent from the distance between the rows.
+  */
+  class Rows
+  {
+  public:
+    Pixel* pixels; /**< The first pixel of the first row. */
+    int stride; /**< The distance between the beginnings of two rows in pixels. */
+
+    /**
+    * The operator returns a row.
+    * @param y The number of the row.
+    * @return The address of the first pixel of the row.
+    */
+    Pixel* operator[](int y) const {return pixels + y * stride;}
+  };
+
+  Rows image; /**< The image. Images owned have no gaps between their rows. */
   CameraInfo cameraInfo; /**< Information on the camera used to take this image. */
   unsigned timeStamp; /**< The time stamp of this image. */
   bool isReference; /**< States whether this class holds the image, or only a reference to an image stored elsewhere. */
@@ -131,8 +154,8 @@ public:
    */
   inline Vector2<int> getCoords(const Image::Pixel* p) const
   {
-    const int diff(p - &image[0][0]);
-    return Vector2<int>(diff % (cameraResolutionWidth*2), diff / (cameraResolutionWidth*2));
+    const int diff(p - image.pixels);
+    return Vector2<int>(diff % image.stride, diff / image.stride);
   }
 
   /**
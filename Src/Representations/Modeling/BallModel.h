@@ -137,6 +137,77 @@ public:
   }
 };
 
+/**
+* @class BallModelCompressed
+* A compressed version of BallModel used in team communication.
+* Positions are in mm and velocities are in mm/s.
+*/
+class BallModelCompressed : public Streamable
+{
+private:
+  virtual void serialize(In* in, Out* out)
+  {
+    STREAM_REGISTER_BEGIN();
+      STREAM(lastPerceptionPosition);
+      STREAM(lastPerceptionVelocity);
+      STREAM(estimatePosition);
+      STREAM(estimateVelocity);
+      STREAM(lastSeenEstimatePosition);
+      STREAM(lastSeenEstimateVelocity);
+      STREAM(timeWhenLastSeen);
+    STREAM_REGISTER_FINISH();
+  }
+
+  /**
+  * The method compresses a vector.
+  * @param v The vector.
+  * @return The vector with short components.
+  */
+  static Vector2<short> compress(const Vector2<double>& v)
+  {
+    return Vector2<short>(roundNumberToShort(v.x), roundNumberToShort(v.y));
+  }
+
+public:
+  Vector2<short> lastPerceptionPosition, lastPerceptionVelocity, /**< The last seen position of the ball */
+                 estimatePosition, estimateVelocity, /**< The estimated state of the ball */
+                 lastSeenEstimatePosition, lastSeenEstimateVelocity; /**< The last seen estimate */
+  unsigned timeWhenLastSeen; /**< Time stamp, indicating what its name says*/
+
+  /** Default constructor. */
+  BallModelCompressed() : timeWhenLastSeen(0) {}
+
+  /**
+  * Constructor.
+  * @param ballModel The ball model that is compressed.
+  */
+  BallModelCompressed(const BallModel& ballModel) :
+    lastPerceptionPosition(compress(ballModel.lastPerception.position)),
+    lastPerceptionVelocity(compress(ballModel.lastPerception.velocity)),
+    estimatePosition(compress(ballModel.estimate.position)),
+    estimateVelocity(compress(ballModel.estimate.velocity)),
+    lastSeenEstimatePosition(compress(ballModel.lastSeenEstimate.position)),
+    lastSeenEstimateVelocity(compress(ballModel.lastSeenEstimate.velocity)),
+    timeWhenLastSeen(ballModel.timeWhenLastSeen) {}
+
+  /**
+  * The method restores the ball model.
+  * @return The ball model.
+  */
+  operator BallModel() const
+  {
+    BallModel ballModel;
+    ballModel.lastPerception.position = Vector2<double>(lastPerceptionPosition.x, lastPerceptionPosition.y);
+    ballModel.lastPerception.velocity = Vector2<double>(lastPerceptionVelocity.x, lastPerceptionVelocity.y);
+    ballModel.estimate.position = Vector2<double>(estimatePosition.x, estimatePosition.y);
+    ballModel.estimate.velocity = Vector2<double>(estimateVelocity.x, estimateVelocity.y);
+    ballModel.lastSeenEstimate.position = Vector2<double>(lastSeenEstimatePosition.x, lastSeenEstimatePosition.y);
+    ballModel.lastSeenEstimate.velocity = Vector2<double>(lastSeenEstimateVelocity.x, lastSeenEstimateVelocity.y);
+    ballModel.timeWhenLastSeen = timeWhenLastSeen;
+    return ballModel;
+  }
+};
+
 class GroundTruthBallModel : public BallModel 
 {
 public:
@@ -76,4 +76,49 @@ public:
   void draw();
 };
 
+/**
+* @class RobotPoseCompressed
+* A compressed version of RobotPose used in team communication.
+*/
+class RobotPoseCompressed : public Streamable
+{
+private:
+  virtual void serialize(In* in, Out* out)
+  {
+    STREAM_REGISTER_BEGIN();
+    STREAM(translation);
+    STREAM(rotation);
+    STREAM(validity);
+    STREAM_REGISTER_FINISH();
+  }
+
+public:
+  Vector2<short> translation; /**< The position in mm. */
+  short rotation; /**< The rotation in 1/10000 rad. */
+  unsigned char validity; /**< The validity in 1/255. */
+
+  /** Default constructor. */
+  RobotPoseCompressed() : rotation(0), validity(0) {}
+
+  /**
+  * Constructor.
+  * @param robotPose The robot pose that is compressed.
+  */
+  RobotPoseCompressed(const RobotPose& robotPose) :
+    translation(roundNumberToShort(robotPose.translation.x), roundNumberToShort(robotPose.translation.y)),
+    rotation(roundNumberToShort(normalize(robotPose.rotation) * 10000.0)),
+    validity((unsigned char) roundNumberToInt((robotPose.validity < 0 ? 0 : robotPose.validity > 1 ? 1 : robotPose.validity) * 255.0)) {}
+
+  /**
+  * The method restores the robot pose.
+  * @return The robot pose.
+  */
+  operator RobotPose() const
+  {
+    RobotPose robotPose(Pose2D(rotation / 10000.0, translation.x, translation.y));
+    robotPose.validity = validity / 255.0;
+    return robotPose;
+  }
+};
+
 #endif //__RobotPose_h_
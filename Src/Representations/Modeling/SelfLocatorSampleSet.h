@@ -22,18 +22,22 @@ private:
   {
     STREAM_REGISTER_BEGIN();
     //STREAM(sampleSetProxy);
+    STREAM(numberOfSamples);
     STREAM_REGISTER_FINISH();
   }
 
 public: 
   /** Constructor */
-  SelfLocatorSampleSet() {}
+  SelfLocatorSampleSet() : numberOfSamples(0) {}
 
   SampleSetProxy<SelfLocatorSample> sampleSetProxy;
 
   //sum of weightings in the last sensor update.
   double weightingsSum; 
 
+  //the number of samples currently used. It changes in adaptive mode.
+  int numberOfSamples;
+
   //void draw();
 };
 
@@ -0,0 +1,90 @@
+/**
+* @file ColorClassPlane.h
+*
+* Declaration of class ColorClassPlane
+*/
+
+#ifndef __ColorClassPlane_h_
+#define __ColorClassPlane_h_
+
+#include "Tools/Streams/Streamable.h"
+#include "Representations/Configuration/ColorTable64.h"
+#include <string.h>
+
+/**
+* @class ColorClassPlane
+*
+* Contains the color classes of the pixels on the scan grid of the current image.
+* Columns are stored contiguously, so runs along them can be scanned block-wise.
+* Only the columns and rows marked as classified are filled. All other pixels
+* are classified on demand using the image and the color table, so a plane
+* that was never filled (e.g. if it is provided by the default module) just
+* falls back to the table lookup.
+*/
+class ColorClassPlane : public Streamable
+{
+private:
+  /** Streaming function
+  * @param in  streaming in ...
+  * @param out ... streaming out.
+  */
+  void serialize(In* in, Out* out)
+  {
+    STREAM_REGISTER_BEGIN();
+    STREAM(width);
+    STREAM(height);
+    STREAM_ARRAY(classifiedColumns);
+    STREAM_ARRAY(classifiedRows);
+    STREAM_REGISTER_FINISH();
+  }
+
+public:
+  /** Constructor */
+  ColorClassPlane() : width(0), height(0)
+  {
+    memset(classifiedColumns, 0, sizeof(classifiedColumns));
+    memset(classifiedRows, 0, sizeof(classifiedRows));
+  }
+
+  /**
+  * Returns the color class of the pixel (x,y). Pixels that are not part of the
+  * plane are classified using the image and the color table.
+  * @param x x-coordinate
+  * @param y y-coordinate
+  * @param image The image the plane was created from.
+  * @param colorTable The color table the plane was created with.
+  * @return the color of the pixel (x,y)
+  */
+  ColorClasses::Color getColor(int x, int y, const Image& image, const ColorTable64& colorTable) const
+  {
+    if(classifiedColumns[x])
+      return (ColorClasses::Color) columns[x][y];
+    else if(classifiedRows[y])
+      return (ColorClasses::Color) rows[y][x];
+    unsigned col(image.image[y][x].color);
+    return (ColorClasses::Color) colorTable.colorClasses[col >> 18 & 0x3f][col >> 10 & 0x3f][col >> 26 & 0x3f];
+  }
+
+  /**
+  * Returns the color classes of a column.
+  * @param x The x-coordinate of the column.
+  * @return The color classes of all pixels in the column or 0 if the column is not classified.
+  */
+  const unsigned char* getColumn(int x) const {return classifiedColumns[x] ? columns[x] : 0;}
+
+  /**
+  * Returns the color classes of a row.
+  * @param y The y-coordinate of the row.
+  * @return The color classes of all pixels in the row or 0 if the row is not classified.
+  */
+  const unsigned char* getRow(int y) const {return classifiedRows[y] ? rows[y] : 0;}
+
+  unsigned char columns[cameraResolutionWidth][cameraResolutionHeight]; /**< The color classes column by column. Only valid in classified columns. */
+  unsigned char rows[cameraResolutionHeight][cameraResolutionWidth]; /**< The color classes row by row. Only valid in classified rows. */
+  unsigned char classifiedColumns[cameraResolutionWidth]; /**< Is the column classified completely (0 or 1)? */
+  unsigned char classifiedRows[cameraResolutionHeight]; /**< Is the row classified completely (0 or 1)? */
+  int width, /**< The width of the image the plane was created from. */
+      height; /**< The height of the image the plane was created from. */
+};
+
+#endif //__ColorClassPlane_h_
@@ -8,30 +8,7 @@
 #define __JPEGImage_h_
 
 #include "Representations/Infrastructure/Image.h"
-
-#ifndef LINUX
-
-// INT32 and FAR conflict with any other header files...
-#define INT32 _INT32
-#undef FAR
-
-// "boolean" conflicts with "rpcndr.h", so we force "jpeglib.h" not to define boolean
-#ifdef __RPCNDR_H__
-#define HAVE_BOOLEAN
-#endif
-
-#include <../Util/libjpeg/src/jpeglib.h>
-
-#undef INT32
-#undef FAR
-
-
-#else
-extern "C"
-{
-#include <../Util/libjpeg/src/jpeglib.h>
-}
-#endif
+#include "Tools/ImageProcessing/JPEGCodec.h"
 
 /**
  * Definition of a class for JPEG-compressed images.
@@ -41,29 +18,8 @@ class JPEGImage : public Image
 private:
   void serialize(In* in, Out* out);
 
-  /**
-  * The class is required during JPEG-compression to access
-  * the main JPEGImage object from library handlers.
-  */
-  class DestDescriptor : public jpeg_destination_mgr
-  {
-  public:
-    JPEGImage* theObject; /**< A pointer to the JPEGImage object. */
-  };
-
   int size; /**< The size of the JPEG image. */
 
-  //!@name Handlers for JPEG-compression
-  //!@{
-  static void onDestInit(j_compress_ptr cInfo);
-  static int onDestEmpty(j_compress_ptr);
-  static void onDestTerm(j_compress_ptr cInfo);
-
-  static void onSrcSkip(j_decompress_ptr cInfo,long numBytes);
-  static int onSrcEmpty(j_decompress_ptr);
-  static void onSrcIgnore(j_decompress_ptr);
-  //!@}
-
 public:
   /** 
   * Empty constructor. 
@@ -76,6 +32,13 @@ public:
   */
   JPEGImage(const Image& src);
 
+  /** 
+  * Constructs a JPEG image from an image.
+  * @param src The image used as template.
+  * @param encoder The encoder used to compress the image.
+  */
+  JPEGImage(const Image& src, JPEGEncoder& encoder);
+
   /**
   * Assignment operator.
   * @param src The image used as template.
@@ -83,11 +46,25 @@ public:
   */
   JPEGImage& operator=(const Image& src);
 
+  /**
+  * Compress an image.
+  * @param src The image used as template.
+  * @param encoder The encoder used to compress the image.
+  */
+  void fromImage(const Image& src, JPEGEncoder& encoder);
+
   /**
   * Uncompress image.
   * @param dest Will receive the uncompressed image.
   */
   void toImage(Image& dest) const;
+
+  /**
+  * Uncompress image.
+  * @param dest Will receive the uncompressed image.
+  * @param decoder The decoder used to uncompress the image.
+  */
+  void toImage(Image& dest, JPEGDecoder& decoder) const;
 };
 
 #endif //__JPEGImage_h_
@@ -24,7 +24,7 @@ Vector2<int> RegionPercept::Region::getCenter() const
   int childIdx;
   Vector2<int> center;
   Segment* segment;
-  for(std::vector<Segment*>::const_iterator segmentIter = childs.begin();
+  for(List<Segment>::const_iterator segmentIter = childs.begin();
       segmentIter != childs.end();
       segmentIter++)
   {
@@ -42,7 +42,7 @@ Vector2<int> RegionPercept::Region::getCenter() const
 int RegionPercept::Region::calcMoment00() const
 {
   int m00 = 0;
-  for(std::vector<Segment*>::const_iterator seg = childs.begin(); seg != childs.end(); seg++)
+  for(List<Segment>::const_iterator seg = childs.begin(); seg != childs.end(); seg++)
     m00 += (*seg)->length;
 
   return m00;
@@ -52,7 +52,7 @@ int RegionPercept::Region::calcMoment10() const
 {
   int m10 = 0;
 
-  for(std::vector<Segment*>::const_iterator seg = childs.begin(); seg != childs.end(); seg++)
+  for(List<Segment>::const_iterator seg = childs.begin(); seg != childs.end(); seg++)
     m10 += (*seg)->x * (*seg)->length;
   
   return m10;
@@ -62,7 +62,7 @@ int RegionPercept::Region::calcMoment01() const
 {
   int m01 = 0;
 
-  for(std::vector<Segment*>::const_iterator seg = childs.begin(); seg != childs.end(); seg++)
+  for(List<Segment>::const_iterator seg = childs.begin(); seg != childs.end(); seg++)
   {
     const int ylo = (*seg)->y;
     const int yhi = (*seg)->y + (*seg)->length;
@@ -76,7 +76,7 @@ int RegionPercept::Region::calcMoment01() const
 double RegionPercept::Region::calcCMoment11(int swp_x, int swp_y) const
 {
   double cm11 = 0;
-  for(std::vector<Segment*>::const_iterator seg = childs.begin(); seg != childs.end(); seg++)
+  for(List<Segment>::const_iterator seg = childs.begin(); seg != childs.end(); seg++)
   {
     const double yStart = (*seg)->y, yEnd = (*seg)->y + (*seg)->length;
     const double ySum = GAUSS_SUM(yEnd) - GAUSS_SUM(yStart);
@@ -91,7 +91,7 @@ int RegionPercept::Region::calcCMoment20(int swp_x) const
 {
   int cm20 = 0;
 
-  for(std::vector<Segment*>::const_iterator seg = childs.begin(); seg != childs.end(); seg++)
+  for(List<Segment>::const_iterator seg = childs.begin(); seg != childs.end(); seg++)
       cm20 += (*seg)->length * ((*seg)->x-swp_x) * ((*seg)->x-swp_x);
 
   return cm20;
@@ -102,7 +102,7 @@ double RegionPercept::Region::calcCMoment02(int swp_y) const
 {
   double cm02 = 0;
 
-  for(std::vector<Segment*>::const_iterator seg = childs.begin(); seg != childs.end(); seg++)
+  for(List<Segment>::const_iterator seg = childs.begin(); seg != childs.end(); seg++)
   {
     // sum(x) = sum_(y = seg->y ; y< seg->y + seg->length)(x)
     // cm02 = sum((y-y_s)^2)
@@ -116,52 +116,6 @@ double RegionPercept::Region::calcCMoment02(int swp_y) const
   return cm02;
 }
 
-void RegionPercept::Region::mergeWithRegion(Region *other)
-{
-  //merge the childs of both regions (sorted)
-  std::vector<RegionPercept::Segment*>::iterator regIter1 = childs.begin();
-  std::vector<RegionPercept::Segment*>::iterator regIter2 = other->childs.begin();
-  std::vector<RegionPercept::Segment*> mergedChilds;
-  while(!(regIter1 == childs.end() && regIter2 == other->childs.end()))
-  {
-    if(regIter1 == childs.end())
-    {
-      ASSERT(*regIter2 != NULL);
-      mergedChilds.push_back(*regIter2);
-      (*regIter2)->region = this;
-      regIter2++;
-    }
-    else if(regIter2 == other->childs.end())
-    {
-      ASSERT(*regIter1 != NULL);
-      mergedChilds.push_back(*regIter1);
-      regIter1++;
-    }
-    else
-    {
-      if(*regIter1 < *regIter2)
-      {
-        mergedChilds.push_back(*regIter1);
-        regIter1++;
-      }
-      else
-      {
-        mergedChilds.push_back(*regIter2);
-        (*regIter2)->region = this;
-        regIter2++;
-      }
-    }
-  }
-  childs = mergedChilds;
-
-  size += other->size;
-  neighborRegions.insert(neighborRegions.end(), other->neighborRegions.begin(), other->neighborRegions.end());
-  if(other->min_y < min_y)
-    min_y = other->min_y;
-  if(other->max_y > max_y)
-    max_y = other->max_y;
-}
-
 bool RegionPercept::Segment::operator<(Segment *s2)
 {
   if(this->x < s2->x)
@@ -198,8 +152,6 @@ void RegionPercept::draw() const
       if(region->childs.size() == 0)
       continue;
 
-      std::vector<Region*>::const_iterator i;
-
       //Draw Region
       ColorRGBA color = getOnFieldDrawColor(region->color);
       upperPoints.clear();
@@ -15,6 +15,7 @@
 
 #define MAX_SEGMENTS_COUNT 1000
 #define MAX_REGIONS_COUNT 250
+#define MAX_NEIGHBORS_COUNT 5000
 
 #define GAUSS_SUM(x) ( x * ( x + 1 ) / 2 )
 #define GAUSS_SUM2(x) ( x * ( x + 1 ) * ( 2 * x + 1 ) / 6 )
@@ -71,20 +72,57 @@ public:
   class Segment;
 
   /**
-   * @class Region
-   * A class to store a region
+   * @class List
+   * A list of pointers that is stored as a range in one of the arrays of the percept.
    */
-  class Region
+  template<class T> class List
   {
     public:
+      typedef T* const* const_iterator; /**< The type of an iterator through the list. */
+
+      /** Default constructor. Creates an empty list. */
+      List() : first(0), last(0) {}
+
+      /**
+       * Returns an iterator to the first entry.
+       * @return The iterator.
+       */
+      const_iterator begin() const {return first;}
+
+      /**
+       * Returns an iterator to the entry after the last one.
+       * @return The iterator.
+       */
+      const_iterator end() const {return last;}
+
+      /**
+       * Returns the number of entries.
+       * @return The number of entries.
+       */
+      size_t size() const {return last - first;}
+
       /**
-       *Default Constructor
+       * Returns an entry of the list.
+       * @param index The index of the entry.
+       * @return The entry.
        */
-      Region()
+      T* at(size_t index) const
       {
-        childs.reserve(64);
+        ASSERT(index < size());
+        return first[index];
       }
 
+      T** first, /**< The first entry of the list. */
+        ** last; /**< The entry after the last one of the list. */
+  };
+
+  /**
+   * @class Region
+   * A class to store a region
+   */
+  class Region
+  {
+    public:
       /** 
        * If the region was merged with another one, this
        * function will return the region it was merged to.
@@ -131,15 +169,10 @@ public:
        * */
       double calcCMoment02(int swp_y) const;
 
-      /**
-       * Merges another region to this one. This will be the parent (root)
-       * region, the other one will be "dead".
-       * @param other region to merge into this one
-       */
-      void mergeWithRegion(Region *other);
-      
-      std::vector<Segment*> childs; /**< The child segments of this region. */
-      std::vector<Region*> neighborRegions; /**< The neighbor Regions of this region. */
+      List<Segment> childs; /**< The child segments of this region. Empty if the region was merged to another one. */
+      List<Region> neighborRegions; /**< The neighbor Regions of this region. */
+      int numOfChilds; /**< The number of child segments while the regions are built. */
+      Segment* lastChild; /**< The last child segment while the regions are built. */
       int min_y, /**< The minimum y value of the childs. */
           max_y; /**< The maximum y value of the childs. */
       Region* root; /**< The root region, if this region was merged to another one. */
@@ -181,6 +214,8 @@ public:
 
   Segment segments[MAX_SEGMENTS_COUNT]; /**< This array stores all the segments. */
   Region regions[MAX_REGIONS_COUNT]; /**< This array stores all the regions. */
+  Segment* childSegments[MAX_SEGMENTS_COUNT]; /**< This array stores the child lists of all regions. */
+  Region* neighborRegions[MAX_NEIGHBORS_COUNT * 2]; /**< This array stores the neighbor lists of all regions. */
   std::vector<Segment> horizontalPostSegments; /**< This vector stores all the horizontal post / goal
                                                     segments (blue or yellow) found in the image */
   std::vector<Segment> verticalPostSegments; /**< This vector stores all the vertical post / goal
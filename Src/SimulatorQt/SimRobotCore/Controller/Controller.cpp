@@ -81,6 +81,11 @@ const SensorReading& Controller::getSensorReading(int id)
   return simulation.getSensorReading(id);
 }
 
+void Controller::prepareSensorReading(int id)
+{
+  simulation.prepareSensorReading(id);
+}
+
 void Controller::addView(View* view, const std::string& name)
 {
   simulation.addView(view, name);
@@ -111,6 +116,11 @@ void Controller::setGUIUpdateDelay(unsigned ms)
   simulatorGui.setUpdateDelay(ms);
 }
 
+bool Controller::isHeadless() const
+{
+  return simulatorGui.isHeadless();
+}
+
 void Controller::registerDrawingByPartOfName(const std::vector<std::string>& parts,
                                              Controller3DDrawing* drawing)
 {
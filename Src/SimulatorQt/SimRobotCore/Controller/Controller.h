@@ -125,6 +125,14 @@ public:
   */
   const SensorReading& getSensorReading(int id); 
 
+  /** 
+  * Announces that the data of a sensor will be requested in this simulation step.
+  * Preparing several camera images before requesting any of them allows
+  * rendering them together and overlapping their transfer.
+  * @param id The sensor port id 
+  */
+  void prepareSensorReading(int id);
+
   /**
   * The function adds a view to the scene.
   * The view can be found in the object tree in the group "views".
@@ -163,6 +171,13 @@ public:
   */
   void setGUIUpdateDelay(unsigned ms);
 
+  /**
+  * The function returns whether the simulator runs without GUI.
+  * In that case, the simulation is stepped as fast as possible.
+  * @return Is the simulator headless?
+  */
+  bool isHeadless() const;
+
   /**
   * The function is called before every simulation step.
   * It must be implemented in a derived class.
@@ -228,6 +243,14 @@ public:
   */
   virtual void onConsoleCommand(const std::string&) {}
 
+  /**
+  * The function is called before the first step if a seed for random
+  * numbers was given on the command line of the headless mode.
+  * Controllers that use random numbers should derive them from it.
+  * @param seed The seed.
+  */
+  virtual void setRandomSeed(unsigned) {}
+
   /**
   * The function is called when the tabulator key is pressed.
   * It can replace the given command line by a new one.
@@ -305,6 +328,12 @@ public:
   * @param text The text to be printed in the status bar.
   */
   void setStatusText(const std::string& text);
+
+  /**
+  * The function returns whether there is no GUI at all.
+  * @return Is the simulator headless?
+  */
+  bool isHeadless() const;
 };
 
 /**
@@ -359,6 +359,61 @@ void OffscreenRenderer::finishRendering(void* image, int w, int h, OffscreenRend
     glWidget->swapBuffers();
 }
 
+bool OffscreenRenderer::startReading(unsigned int& pixelBuffer, int w, int h)
+{
+  if(!GLEW_ARB_pixel_buffer_object)
+    return false;
+
+  if(!pixelBuffer)
+    glGenBuffersARB(1, &pixelBuffer);
+  glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, pixelBuffer);
+  glBufferDataARB(GL_PIXEL_PACK_BUFFER_ARB, w * h * 3, 0, GL_STREAM_READ_ARB);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glReadPixels(0, useOffset ? height - h : 0, w, h, GL_BGR, GL_UNSIGNED_BYTE, 0);
+  glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, 0);
+
+  if(glWidget && glWidget->isVisible())
+    glWidget->swapBuffers();
+  return true;
+}
+
+void OffscreenRenderer::finishReading(unsigned int pixelBuffer, void* image, int w, int h)
+{
+  ASSERT(pixelBuffer);
+  VERIFY(makeCurrent());
+  glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, pixelBuffer);
+  const char* pSrc = (const char*) glMapBufferARB(GL_PIXEL_PACK_BUFFER_ARB, GL_READ_ONLY_ARB);
+  if(pSrc)
+  {
+    const int width3(w * 3);
+    if(flippingBuffer) // upside down
+    {
+      char* pDest = (char*) image;
+      pSrc += width3 * h;
+      for(int y = 0; y < h; ++y)
+      {
+        pSrc -= width3;
+        memcpy(pDest, pSrc, width3);
+        pDest += width3;
+      }
+    }
+    else // not upside down
+      memcpy(image, pSrc, width3 * h);
+    glUnmapBufferARB(GL_PIXEL_PACK_BUFFER_ARB);
+  }
+  glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, 0);
+}
+
+void OffscreenRenderer::deletePixelBuffer(unsigned int& pixelBuffer)
+{
+  if(pixelBuffer)
+  {
+    VERIFY(makeCurrent());
+    glDeleteBuffersARB(1, &pixelBuffer);
+    pixelBuffer = 0;
+  }
+}
+
 OffscreenRenderer::Method OffscreenRenderer::getRenderingMethod() const
 {
   if(pbuffer)
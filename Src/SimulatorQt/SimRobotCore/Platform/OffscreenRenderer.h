@@ -64,6 +64,33 @@ public:
   */
   void finishRendering(void* image, int width, int height, Content content);
 
+  /**
+  * Starts reading a BGR image from the current rendering context into a pixel buffer object.
+  * The call returns without waiting for the rendering to finish, so further images can be
+  * rendered while this one is transferred. Use finishReading() to get the image.
+  * @param pixelBuffer The pixel buffer object. It is created if it is 0.
+  * @param width The image width.
+  * @param height The image height.
+  * @return Whether the reading was started. If pixel buffer objects are not supported,
+  *         finishRendering() has to be used instead.
+  */
+  bool startReading(unsigned int& pixelBuffer, int width, int height);
+
+  /**
+  * Copies an image read by startReading() to memory. The call waits until the image is available.
+  * @param pixelBuffer The pixel buffer object passed to startReading().
+  * @param image The buffer where is image will be saved to (BGR, 3 byte).
+  * @param width The image width.
+  * @param height The image height.
+  */
+  void finishReading(unsigned int pixelBuffer, void* image, int width, int height);
+
+  /**
+  * Deletes a pixel buffer object created by startReading().
+  * @param pixelBuffer The pixel buffer object. It is reset to 0.
+  */
+  void deletePixelBuffer(unsigned int& pixelBuffer);
+
   /**
   * Requests the used rendering method. Only availabe when prepareRendering() was called at least once.
   * @return The used rendering method.
@@ -17,6 +17,8 @@
 Camera::Camera():ImagingSensor()
 {
   cycle_order_offset = -1;
+  pixelBuffer = 0;
+  readingStarted = false;
   fbo_reg = GLHelper::getGLH()->getFBOreg();
   sensorReading.data.byteArray = 0;
 }
@@ -24,6 +26,8 @@ Camera::Camera():ImagingSensor()
 Camera::Camera(const AttributeSet& attributes):ImagingSensor(attributes)
 {
   cycle_order_offset = -1;
+  pixelBuffer = 0;
+  readingStarted = false;
   fbo_reg = GLHelper::getGLH()->getFBOreg();
   sensorReading.data.byteArray = 0;
   sensorReading.minValue = 0;
@@ -36,6 +40,8 @@ Camera::~Camera()
 {
   if(sensorReading.data.byteArray)
     delete [] sensorReading.data.byteArray;
+  if(pixelBuffer && osRenderer)
+    osRenderer->deletePixelBuffer(pixelBuffer);
   GLHelper::getGLH()->removeFBOreg(fbo_reg);
 }
 
@@ -72,6 +78,7 @@ void Camera::setResolution(int x, int y)
   resolutionX = x;
   resolutionY = y;
   sensorReading.data.byteArray = 0;
+  readingStarted = false;
 }
 
 void Camera::renderCubeMap(VisualizationParameterSet& visParams)
@@ -214,9 +221,22 @@ void Camera::setCamera(const VisualizationParameterSet& visParams, const int gen
   }
 }
 
-SensorReading& Camera::getSensorReading(int localPortId)
-{ 
+bool Camera::isImageDue() const
+{
   int simulationStep(simulation->getSimulationStep());
+  if(exposureTime > 0.0)
+  {
+    // currently physicupdates are rewritten at the end of the simstep and not
+    // at the end of the pyhsic update...
+    double timePast = (double)(simulationStep - lastComputationStep)*simulation->getStepLength();
+    return timePast >= exposureTime;
+  }
+  else
+    return simulationStep > lastComputationStep;
+}
+
+void Camera::renderImage(bool readAsynchronously)
+{
   if(!osRenderer)
     osRenderer = simulation->getOffscreenRenderer();
   if(!sensorReading.data.byteArray)
@@ -224,28 +244,32 @@ SensorReading& Camera::getSensorReading(int localPortId)
     sensorReading.data.byteArray = new unsigned char[sensorReading.dimensions[0] *
       sensorReading.dimensions[1] * sensorReading.dimensions[2]];
   }
-  unsigned char* imageData = const_cast<unsigned char*>(sensorReading.data.byteArray);
+  osRenderer->prepareRendering(resolutionX, resolutionY);
   if(exposureTime > 0.0)
+    graphicsManager->setExposure(exposureTime, simulation->getStepLength());
+  render();
+  readingStarted = readAsynchronously && osRenderer->startReading(pixelBuffer, resolutionX, resolutionY);
+  if(!readingStarted)
+    osRenderer->finishRendering(const_cast<unsigned char*>(sensorReading.data.byteArray),
+                                resolutionX, resolutionY, OffscreenRenderer::IMAGE);
+  lastComputationStep = simulation->getSimulationStep();
+}
+
+void Camera::prepareSensorReading(int localPortId)
+{
+  if(isImageDue())
+    renderImage(true);
+}
+
+SensorReading& Camera::getSensorReading(int localPortId)
+{ 
+  if(isImageDue()) // not prepared in this step
+    renderImage(false);
+  else if(readingStarted)
   {
-    // currently physicupdates are rewritten at the end of the simstep and not
-    // at the end of the pyhsic update...
-    double simStepLength = simulation->getStepLength();
-    double timePast = (double)(simulationStep - lastComputationStep)*simStepLength;
-    if(timePast >= exposureTime)
-    {
-      osRenderer->prepareRendering(resolutionX, resolutionY);
-      graphicsManager->setExposure(exposureTime, simStepLength);
-      render();
-      osRenderer->finishRendering(imageData, resolutionX, resolutionY, OffscreenRenderer::IMAGE);
-      lastComputationStep = simulationStep;
-    }
-  }
-  else if(simulationStep>lastComputationStep)
-  {
-    osRenderer->prepareRendering(resolutionX, resolutionY);
-    render();
-    osRenderer->finishRendering(imageData, resolutionX, resolutionY, OffscreenRenderer::IMAGE);
-    lastComputationStep = simulationStep;
+    osRenderer->finishReading(pixelBuffer, const_cast<unsigned char*>(sensorReading.data.byteArray),
+                              resolutionX, resolutionY);
+    readingStarted = false;
   }
   return sensorReading;
 }
@@ -30,10 +30,25 @@ protected:
   void renderCubeMap(VisualizationParameterSet& visParams);
 
   SensorReading sensorReading;
+
+  /** The pixel buffer object the image is read into asynchronously */
+  unsigned int pixelBuffer;
+  /** Whether the image is currently read into the pixel buffer object */
+  bool readingStarted;
   
   /** Executes the rendering of the image */
   void render();
 
+  /** Determines whether a new image has to be rendered in the current simulation step
+  * @return Is a new image due?
+  */
+  bool isImageDue() const;
+
+  /** Renders a new image and reads it
+  * @param readAsynchronously Whether the image is read into the pixel buffer object if possible
+  */
+  void renderImage(bool readAsynchronously);
+
   /** render according to the composition */
   void renderingInstructions(VisualizationParameterSet& visParams);
 
@@ -93,6 +108,12 @@ public:
    */
   virtual SensorReading& getSensorReading(int localPortId);
 
+  /** Renders the image if it is due and starts reading it, so the next camera
+   * can already be rendered while this image is transferred
+   * @param localPortId The local sensor port
+   */
+  virtual void prepareSensorReading(int localPortId);
+
   /**
    * Writes back the results from the physical simulation.
    * Sets position and rotation from body/geometry to simulation object.
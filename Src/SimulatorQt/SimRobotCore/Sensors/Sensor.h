@@ -47,6 +47,13 @@ public:
     return *dummySensorReading;
   }
 
+  /** Announces that the result of the sensor data computation will be requested
+   * soon. Sensors can use this to start expensive computations for several
+   * sensors together before getSensorReading() is called for any of them.
+   * @param localPortId The local sensor port
+   */
+  virtual void prepareSensorReading(int localPortId) {}
+
   /**
    * Returns a pointer to the bumper if the sensor is one. This is used to prevent dynamic downcasts
    * from sensor objects to bumper objects. Has to be overloaded by the appropriate subclass
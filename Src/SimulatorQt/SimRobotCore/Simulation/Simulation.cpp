@@ -9,6 +9,7 @@
 */
 
 #include <math.h>
+#include <string.h>
 
 #include "Simulation.h"
 #include "Actuatorport.h"
@@ -33,8 +34,13 @@ backgroundSurface(0), defaultSurface(0), physicsParameters(0), physicalWorld(0),
 staticSpace(0), movableSpace(0), contactGroup(0), rootSpace(0), 
 currentSpace(0), intersectionRay(0), physicsStepLength(-1.0),  useQuickSolverForPhysics(false), 
 numberOfIterationsForQuickSolver (20), useAutomaticObjectDisabling(false), 
-collisionDetectionMode(0), numberOfCollisionContacts(0), applyDynamicsForceFactor(1.0)
+collisionDetectionMode(0), broadphase(HASH_BROADPHASE), hashSpaceMinLevel(-3), hashSpaceMaxLevel(10),
+quadTreeDepth(5), useStaticContactCache(false), staticContactCacheTolerance(1e-5), collisionPass(0),
+numberOfCollisionContacts(0), applyDynamicsForceFactor(1.0)
 {
+  quadTreeCenter[0] = quadTreeCenter[1] = quadTreeCenter[2] = quadTreeCenter[3] = 0;
+  quadTreeSize[0] = quadTreeSize[1] = quadTreeSize[2] = 10;
+  quadTreeSize[3] = 0;
   simulationStatus = NOT_LOADED;
   highestMovableID = 0;
   movableIDs.push(highestMovableID);
@@ -824,10 +830,7 @@ bool Simulation::loadFile(const std::string& filename, const std::string& schema
   //setup physics
   physicsParameters = new PhysicsParameterSet();
   physicalWorld = dWorldCreate();
-  rootSpace = dHashSpaceCreate(0);
   intersectionRay = dCreateRay(0, 1.0);
-  staticSpace = dHashSpaceCreate(rootSpace);
-  movableSpace = dHashSpaceCreate(rootSpace);
   contactGroup = dJointGroupCreate(0);
   currentSpace = &staticSpace;
 
@@ -836,6 +839,13 @@ bool Simulation::loadFile(const std::string& filename, const std::string& schema
     graphicsManager, &surfaces, &materials, &environments);
   delete parser;
 
+  // The spaces are created after parsing, because the scene selects their broadphase.
+  // Geometries are only inserted when the physics are created below.
+  // The root space only contains the two other spaces, so it needs no broadphase.
+  rootSpace = dSimpleSpaceCreate(0);
+  staticSpace = createSpace(rootSpace);
+  movableSpace = createSpace(rootSpace);
+
   if(useQuickSolverForPhysics)
     dWorldSetQuickStepNumIterations(physicalWorld, numberOfIterationsForQuickSolver);
   offscreenRenderer = new OffscreenRenderer(graphicsManager);
@@ -996,6 +1006,7 @@ void Simulation::closeSimulation()
     contactGroup = 0;
   }
   currentSpace = 0;
+  staticContactCache.clear();
   if(movableSpace)
   {
     dSpaceDestroy(movableSpace);
@@ -1064,7 +1075,10 @@ void Simulation::doSimulationStep()
     if(!collisionSensors.empty())
       resetCollisionSensors();
     //collision detection
+    ++collisionPass;
     dSpaceCollide(rootSpace, this, staticCollisionCallback);
+    if(useStaticContactCache)
+      removeUnusedStaticContacts();
     if(useQuickSolverForPhysics)
     {
       dWorldQuickStep(physicalWorld, (dReal)physicsSimulationStepsize);
@@ -1191,6 +1205,12 @@ SensorReading& Simulation::getSensorReading(int id)
   return sensorPortList[id].sensor->getSensorReading(sensorPortList[id].localPortId);
 }
 
+void Simulation::prepareSensorReading(int id)
+{
+  assert(id >= 0 && id < (int) sensorPortList.size());
+  sensorPortList[id].sensor->prepareSensorReading(sensorPortList[id].localPortId);
+}
+
 Surface* Simulation::getSurface(const std::string& name) const
 {
   std::vector<Surface*>::const_iterator iter;
@@ -1461,7 +1481,10 @@ void Simulation::collisionCallback(dGeomID geom1, dGeomID geom2)
     dContact contact[N];
     const double* fricTable = frictionCoefficientTable.getTable();
     int numOfMaterials = frictionCoefficientTable.getNumberOfMaterialsInTable();
-    n = dCollide (geom1, geom2, N, &contact[0].geom, sizeof(dContact));
+    if(useStaticContactCache && (!b1 || !b2))
+      n = collideStatic(geom1, geom2, contact, N);
+    else
+      n = dCollide (geom1, geom2, N, &contact[0].geom, sizeof(dContact));
     if(n > 0)
     {
       numberOfCollisionContacts++;
@@ -1632,6 +1655,74 @@ void Simulation::collisionCallback(dGeomID geom1, dGeomID geom2)
   }
 }
 
+int Simulation::collideStatic(dGeomID geom1, dGeomID geom2, dContact* contact, int maxContacts)
+{
+  // only the movable geometry can have moved
+  dGeomID movableGeom = dGeomGetBody(geom1) ? geom1 : geom2;
+  const dReal* position = dGeomGetPosition(movableGeom);
+  const dReal* rotation = dGeomGetRotation(movableGeom);
+  const dReal tolerance = (dReal)staticContactCacheTolerance;
+  StaticContacts& cached = staticContactCache[std::make_pair(geom1, geom2)];
+  bool moved = cached.lastPass == 0;
+  for(int i = 0; i < 3 && !moved; ++i)
+    moved = fabs(position[i] - cached.position[i]) > tolerance;
+  for(int i = 0; i < 12 && !moved; ++i)
+    moved = i % 4 != 3 && fabs(rotation[i] - cached.rotation[i]) > tolerance;
+  cached.lastPass = collisionPass;
+
+  if(moved)
+  {
+    int n = dCollide(geom1, geom2, maxContacts, &contact[0].geom, sizeof(dContact));
+    cached.contacts.resize(n);
+    for(int i = 0; i < n; ++i)
+      cached.contacts[i] = contact[i].geom;
+    memcpy(cached.position, position, sizeof(cached.position));
+    memcpy(cached.rotation, rotation, sizeof(cached.rotation));
+    return n;
+  }
+  else
+  {
+    int n = (int) cached.contacts.size();
+    for(int i = 0; i < n; ++i)
+      contact[i].geom = cached.contacts[i];
+    return n;
+  }
+}
+
+void Simulation::removeUnusedStaticContacts()
+{
+  std::map<std::pair<dGeomID, dGeomID>, StaticContacts>::iterator iter = staticContactCache.begin();
+  while(iter != staticContactCache.end())
+  {
+    if(iter->second.lastPass != collisionPass)
+      staticContactCache.erase(iter++);
+    else
+      ++iter;
+  }
+}
+
+dSpaceID Simulation::createSpace(dSpaceID parent)
+{
+  if(broadphase == SWEEP_AND_PRUNE_BROADPHASE)
+  {
+    // the z axis points upwards, so sorting along the x axis separates most objects on the ground
+    return dSweepAndPruneSpaceCreate(parent, dSAP_AXES_XYZ);
+  }
+  else if(broadphase == QUADTREE_BROADPHASE)
+  {
+    dVector3 extents;
+    for(int i = 0; i < 4; ++i)
+      extents[i] = quadTreeSize[i] * (dReal)0.5;
+    return dQuadTreeSpaceCreate(parent, quadTreeCenter, extents, quadTreeDepth);
+  }
+  else
+  {
+    dSpaceID space = dHashSpaceCreate(parent);
+    dHashSpaceSetLevels(space, hashSpaceMinLevel, hashSpaceMaxLevel);
+    return space;
+  }
+}
+
 void Simulation::intersectionCallback(dGeomID geom1, dGeomID geom2)
 {
   if(dGeomIsSpace(geom1) || dGeomIsSpace(geom2))
@@ -1957,6 +2048,46 @@ void Simulation::parseAttributeElements(const std::string& name,
     useQuickSolverForPhysics = true;
     numberOfIterationsForQuickSolver = ParserUtilities::toInt(ParserUtilities::getValueFor(attributes, "iterations"));
   }
+  else if(name == "Broadphase")
+  {
+    std::string type(ParserUtilities::getValueFor(attributes, "type"));
+    if(type == "sap")
+      broadphase = SWEEP_AND_PRUNE_BROADPHASE;
+    else if(type == "quadtree")
+      broadphase = QUADTREE_BROADPHASE;
+    else
+      broadphase = HASH_BROADPHASE;
+    for(unsigned int i=0; i< attributes.size(); i++)
+    {
+      if(attributes[i].attribute == "minLevel")
+        hashSpaceMinLevel = ParserUtilities::toInt(attributes[i].value);
+      else if(attributes[i].attribute == "maxLevel")
+        hashSpaceMaxLevel = ParserUtilities::toInt(attributes[i].value);
+      else if(attributes[i].attribute == "centerX")
+        quadTreeCenter[0] = (dReal)ParserUtilities::toDouble(attributes[i].value);
+      else if(attributes[i].attribute == "centerY")
+        quadTreeCenter[1] = (dReal)ParserUtilities::toDouble(attributes[i].value);
+      else if(attributes[i].attribute == "centerZ")
+        quadTreeCenter[2] = (dReal)ParserUtilities::toDouble(attributes[i].value);
+      else if(attributes[i].attribute == "sizeX")
+        quadTreeSize[0] = (dReal)ParserUtilities::toDouble(attributes[i].value);
+      else if(attributes[i].attribute == "sizeY")
+        quadTreeSize[1] = (dReal)ParserUtilities::toDouble(attributes[i].value);
+      else if(attributes[i].attribute == "sizeZ")
+        quadTreeSize[2] = (dReal)ParserUtilities::toDouble(attributes[i].value);
+      else if(attributes[i].attribute == "depth")
+        quadTreeDepth = ParserUtilities::toInt(attributes[i].value);
+    }
+  }
+  else if(name == "StaticContactCache")
+  {
+    useStaticContactCache = true;
+    for(unsigned int i=0; i< attributes.size(); i++)
+    {
+      if(attributes[i].attribute == "tolerance")
+        staticContactCacheTolerance = ParserUtilities::toDouble(attributes[i].value);
+    }
+  }
   else if(name == "AutomaticObjectDisabling")
   {
     this->useAutomaticObjectDisabling = true;
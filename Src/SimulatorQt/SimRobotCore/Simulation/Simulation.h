@@ -231,6 +231,41 @@ private:
   /** The collision detection mode; if '0', two objects directly connected by a joint can not collide (default);
       if '1' two objects directly connected by a joint can collide */
   short collisionDetectionMode;
+  /** The broadphases available for the collision spaces of static and movable objects */
+  enum Broadphase {HASH_BROADPHASE, SWEEP_AND_PRUNE_BROADPHASE, QUADTREE_BROADPHASE};
+  /** The broadphase of the collision spaces of static and movable objects; default is the hash space */
+  Broadphase broadphase;
+  /** The smallest and the largest cell size of hash spaces as powers of two; default is -3 and 10 */
+  int hashSpaceMinLevel, hashSpaceMaxLevel;
+  /** The center of the region covered by quadtree spaces */
+  dVector3 quadTreeCenter;
+  /** The size of the region covered by quadtree spaces */
+  dVector3 quadTreeSize;
+  /** The depth of quadtree spaces */
+  int quadTreeDepth;
+  /** A flag indicating whether contacts between static and movable objects are reused while the movable object does not move */
+  bool useStaticContactCache;
+  /** The maximum change of the position and the rotation matrix of a movable object, for which contacts are reused */
+  double staticContactCacheTolerance;
+  /** The contacts between a static and a movable geometry computed in an earlier physics step */
+  class StaticContacts
+  {
+  public:
+    /** Constructor */
+    StaticContacts() : lastPass(0) {}
+    /** The position of the movable geometry when the contacts were computed */
+    dReal position[3];
+    /** The rotation of the movable geometry when the contacts were computed */
+    dMatrix3 rotation;
+    /** The contacts computed */
+    std::vector<dContactGeom> contacts;
+    /** The number of the collision detection pass in which the pair of geometries was tested last */
+    unsigned int lastPass;
+  };
+  /** The cached contacts stored by the pair of geometries */
+  std::map<std::pair<dGeomID, dGeomID>, StaticContacts> staticContactCache;
+  /** The number of the current collision detection pass */
+  unsigned int collisionPass;
   /** Counter for statistics*/
   int numberOfCollisionContacts;
   /** A force factor for application of dynamics in drag and drop interaction */
@@ -271,6 +306,29 @@ private:
    */
   void collisionCallback(dGeomID geom1, dGeomID geom2);
 
+  /**
+   * Computes the contacts between a static and a movable geometry. The contacts are reused
+   * from the previous test if the movable geometry has not moved in between.
+   * @param geom1 The first geometry object for collision testing.
+   * @param geom2 The second geometry object for collision testing.
+   * @param contact The array the contacts are written to.
+   * @param maxContacts The size of the array.
+   * @return The number of contacts.
+   */
+  int collideStatic(dGeomID geom1, dGeomID geom2, dContact* contact, int maxContacts);
+
+  /**
+   * Removes the cached contacts of all pairs of geometries that were not tested in the current collision detection pass.
+   */
+  void removeUnusedStaticContacts();
+
+  /**
+   * Creates a collision space using the broadphase selected in the scene.
+   * @param parent The space the new space is inserted into.
+   * @return The new space.
+   */
+  dSpaceID createSpace(dSpaceID parent);
+
   /**
    * Callback method for intersection handling. It is called by staticIntersectionCallback.
    * @param geom1 The first geometry object for collision testing.
@@ -693,6 +751,11 @@ public:
   */
   SensorReading& getSensorReading(int id); 
 
+  /** Announces that the data of a sensor will be requested in this simulation step
+  * @param id The id of the sensor port
+  */
+  void prepareSensorReading(int id);
+
   /** Returns the surface for a given name.
   * @param name The name of the surface searched for.
   * @return A pointer to the surface, or 0 if it does not exist.
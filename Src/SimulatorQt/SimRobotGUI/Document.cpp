@@ -13,6 +13,8 @@
 #include <QApplication>
 #include <QTimer>
 
+#include <cstdio>
+
 #include <Simulation/Simulation.h>
 
 #include "Main.h"
@@ -29,24 +31,40 @@ Connection::Connection(const char* sceneName)
   start = this;
 }
 
+// Without a document, the simulator runs headless and the console is stdout.
+
 void SimulatorGui::print(const std::string& text)
 {
-  Document::document->print(text.c_str());
+  if(Document::document)
+    Document::document->print(text.c_str());
+  else
+  {
+    fputs(text.c_str(), stdout);
+    fflush(stdout);
+  }
 }
 
 void SimulatorGui::clear()
 {
-  Document::document->clearConsole();
+  if(Document::document)
+    Document::document->clearConsole();
 }
 
 void SimulatorGui::setUpdateDelay(unsigned ms)
 {
-  Document::document->setUpdateViewsDelay(ms);
+  if(Document::document)
+    Document::document->setUpdateViewsDelay(ms);
 }
 
 void SimulatorGui::setStatusText(const std::string& text)
 {
-  Document::document->setStatusText(text.c_str());
+  if(Document::document)
+    Document::document->setStatusText(text.c_str());
+}
+
+bool SimulatorGui::isHeadless() const
+{
+  return Document::document == 0;
 }
 
 Document* Document::document = 0;
@@ -0,0 +1,133 @@
+/**
+* @file SimRobotGUI/Headless.cpp
+* Implementation of class Headless.
+*/
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QTextStream>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <string>
+
+#include <Simulation/Simulation.h>
+#include <Controller/Controller.h>
+
+#include "Main.h"
+#include "Headless.h"
+
+int Headless::run(int argc, char *argv[])
+{
+  double minutes = 10.;
+  const char* seed = 0;
+  QString sceneFile, summaryFile;
+  std::vector<std::string> commands;
+  for(int i = 1; i < argc; ++i)
+    if(!strcmp(argv[i], "-headless"))
+      continue;
+    else if(!strcmp(argv[i], "-minutes") && i + 1 < argc)
+      minutes = atof(argv[++i]);
+    else if(!strcmp(argv[i], "-summary") && i + 1 < argc)
+      summaryFile = QFileInfo(argv[++i]).absoluteFilePath();
+    else if(!strcmp(argv[i], "-seed") && i + 1 < argc)
+      seed = argv[++i];
+    else if(!strcmp(argv[i], "-c") && i + 1 < argc)
+      commands.push_back(argv[++i]);
+    else if(*argv[i] != '-')
+      sceneFile = QFileInfo(argv[i]).absoluteFilePath();
+  if(sceneFile.isEmpty() || minutes <= 0.)
+  {
+    fprintf(stderr, "usage: %s -headless [-minutes <m>] [-seed <n>] [-summary <file>] {-c <command>} <scene>\n", argv[0]);
+    return 1;
+  }
+
+  // set directory for relative paths in texture load commands
+  QFileInfo fileInfo(sceneFile);
+  QDir::setCurrent(fileInfo.dir().path());
+  QString roSiFilePath = QFileInfo(Main::main->appPath).dir().path() + "/RoSi.xsd";
+
+  Simulation* simulation = new Simulation();
+  if(!simulation->loadFile(std::string(sceneFile.toAscii().constData()),
+                           std::string(roSiFilePath.toAscii().constData())))
+  {
+    std::vector<ErrorDescription> errors;
+    simulation->getAllErrors(errors);
+    fprintf(stderr, "Scene Compiler Errors:\n");
+    for(std::vector<ErrorDescription>::const_iterator it = errors.begin(); it < errors.end(); it++)
+      fprintf(stderr, "%s\n", it->text.c_str());
+    delete simulation;
+    return 1;
+  }
+
+  // search for controller
+  const std::string& sceneName(simulation->getObjectReference("")->getName());
+  Connection* pThis = Connection::start;
+  while(pThis && !(sceneName == pThis->sceneName))
+    pThis = pThis->next;
+  if(!pThis)
+  {
+    fprintf(stderr, "There's no controller for scene %s\n", sceneName.c_str());
+    delete simulation;
+    return 1;
+  }
+
+  SimulatorGui simulatorGui;
+  Controller* controller = pThis->createController(*simulation, simulatorGui);
+  controller->init();
+  if(seed)
+    controller->setRandomSeed((unsigned) strtoul(seed, 0, 10));
+  for(std::vector<std::string>::const_iterator i = commands.begin(); i != commands.end(); ++i)
+    controller->onConsoleCommand(*i);
+  simulation->resetSceneGraphChanged();
+
+  // Each step simulates stepLength seconds. The wall clock is never consulted inside the loop.
+  const unsigned int stepsPerMinute = (unsigned int) (60. / simulation->getStepLength() + 0.5),
+                     numOfSteps = (unsigned int) (minutes * stepsPerMinute + 0.5),
+                     startTime = Main::getSystemTime();
+  for(unsigned int step = 1; step <= numOfSteps; ++step)
+  {
+    controller->execute();
+    if(simulation->getResetFlag())
+      simulation->resetSimulation();
+    if(simulation->hasSceneGraphChanged())
+      simulation->resetSceneGraphChanged();
+    simulation->doSimulationStep();
+    if(step % stepsPerMinute == 0)
+    {
+      printf("simulated %u min in %.1f s\n", step / stepsPerMinute, (Main::getSystemTime() - startTime) * 0.001);
+      fflush(stdout);
+    }
+  }
+  const unsigned int duration = Main::getSystemTime() - startTime;
+
+  controller->destroy();
+  delete controller;
+  delete simulation;
+
+  const double simulatedSeconds = numOfSteps * 60. / stepsPerMinute,
+               realSeconds = (duration ? duration : 1) * 0.001;
+  QString summary;
+  QTextStream(&summary)
+    << "scene: " << fileInfo.fileName() << "\n"
+    << "seed: " << (seed ? seed : "none") << "\n"
+    << "steps: " << numOfSteps << "\n"
+    << "simulated time: " << simulatedSeconds << " s\n"
+    << "real time: " << realSeconds << " s\n"
+    << "speed: " << simulatedSeconds / realSeconds << "x real time\n";
+  printf("%s", summary.toAscii().constData());
+  if(!summaryFile.isEmpty())
+  {
+    QFile file(summaryFile);
+    if(!file.open(QFile::WriteOnly | QFile::Text))
+    {
+      fprintf(stderr, "Cannot write file %s\n", summaryFile.toAscii().constData());
+      return 1;
+    }
+    QTextStream(&file) << summary;
+  }
+  return 0;
+}
@@ -0,0 +1,37 @@
+/**
+* @file SimRobotGUI/Headless.h
+* Declaration of class Headless.
+*/
+
+#ifndef Headless_H
+#define Headless_H
+
+/**
+* The class runs a scene without any windows and as fast as possible.
+* It is activated by the command line option "-headless". The scene is
+* compiled and its controller is created as in the GUI. Afterwards, the
+* controller and the simulation are stepped alternately in a loop that
+* does not wait for the wall clock. The run ends after a given simulated
+* time and a summary is printed and optionally written to a file.
+* Controllers can check Controller::isHeadless() to switch to a
+* deterministic simulated time.
+* Command line: -headless [-minutes <m>] [-seed <n>] [-summary <file>] {-c <command>} <scene>
+* The seed is passed to Controller::setRandomSeed(), so different runs of the
+* same scene can be made.
+* Each command given with -c is passed to the console of the controller
+* before the first step. There is no OpenGL context, so the controller
+* must not calculate camera images.
+*/
+class Headless
+{
+public:
+  /**
+  * The function runs a scene without GUI.
+  * @param argc The number of command line arguments.
+  * @param argv The command line arguments.
+  * @return The exit code of the application.
+  */
+  static int run(int argc, char *argv[]);
+};
+
+#endif // Headless_H
@@ -12,8 +12,11 @@
 #include <sys/time.h>
 #endif
 
+#include <cstring>
+
 #include "Main.h"
 #include "MainWindow.h"
+#include "Headless.h"
 
 Main* Main::main = 0;
 
@@ -88,6 +91,9 @@ int main(int argc, char *argv[])
 
   Main::main->appString = QString("SimRobot\\%1").arg(Main::main->getAppLocationSum());
 
+  for(int i = 1; i < argc; ++i)
+    if(!strcmp(argv[i], "-headless"))
+      return Headless::run(argc, argv);
 
   QApplication app(argc, argv);
   MainWindow mainWindow(argc, argv);
@@ -0,0 +1,172 @@
+/**
+* @file Tools/CRC.cpp
+*
+* Implementation of a class that calculates CRC checksums.
+*/
+
+#include "CRC.h"
+#include "Platform/SystemCall.h"
+#include "Tools/Debugging/Debugging.h"
+#include <vector>
+
+/**
+* The class contains the lookup tables of both checksums. crc16[k][b] and
+* crc32[k][b] are the checksums of the byte b followed by k zero bytes.
+*/
+class CRCTables
+{
+public:
+  unsigned short crc16[8][256]; /**< The tables of the CRC16. */
+  unsigned crc32[8][256]; /**< The tables of the CRC32. */
+
+  /** Constructor. Fills the tables. */
+  CRCTables()
+  {
+    for(int i = 0; i < 256; ++i)
+    {
+      unsigned short c16 = (unsigned short) (i << 8);
+      unsigned c32 = i;
+      for(int j = 0; j < 8; ++j)
+      {
+        c16 = (unsigned short) (c16 & 0x8000 ? c16 << 1 ^ 0x8005 : c16 << 1);
+        c32 = c32 & 1 ? c32 >> 1 ^ 0xedb88320 : c32 >> 1;
+      }
+      crc16[0][i] = c16;
+      crc32[0][i] = c32;
+    }
+    for(int k = 1; k < 8; ++k)
+      for(int i = 0; i < 256; ++i)
+      {
+        crc16[k][i] = (unsigned short) (crc16[k - 1][i] << 8 ^ crc16[0][crc16[k - 1][i] >> 8]);
+        crc32[k][i] = crc32[k - 1][i] >> 8 ^ crc32[0][crc32[k - 1][i] & 0xff];
+      }
+  }
+};
+
+static CRCTables tables;
+
+unsigned short CRC::calcCRC16(const void* address, size_t size, unsigned short crc16)
+{
+  const unsigned short (*t)[256] = tables.crc16;
+  const unsigned char* p = (const unsigned char*) address;
+  for(; size >= 8; size -= 8, p += 8)
+    crc16 = (unsigned short) (t[7][p[0] ^ crc16 >> 8] ^ t[6][p[1] ^ (crc16 & 0xff)] ^ t[5][p[2]] ^ t[4][p[3]] ^
+                              t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]]);
+  while(size--)
+    crc16 = (unsigned short) (crc16 << 8 ^ t[0][crc16 >> 8 ^ *p++]);
+  return crc16;
+}
+
+unsigned CRC::calcCRC32(const void* address, size_t size, unsigned crc32)
+{
+  const unsigned (*t)[256] = tables.crc32;
+  const unsigned char* p = (const unsigned char*) address;
+  crc32 = ~crc32;
+  for(; size >= 8; size -= 8, p += 8)
+  {
+    // bytes are combined explicitly, so the calculation does not depend on the byte order
+    const unsigned c = crc32 ^ (p[0] | p[1] << 8 | p[2] << 16 | (unsigned) p[3] << 24);
+    crc32 = t[7][c & 0xff] ^ t[6][c >> 8 & 0xff] ^ t[5][c >> 16 & 0xff] ^ t[4][c >> 24] ^
+            t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+  }
+  while(size--)
+    crc32 = crc32 >> 8 ^ t[0][(crc32 ^ *p++) & 0xff];
+  return ~crc32;
+}
+
+/** The CRC16 calculated bit by bit as the reference for the benchmark. */
+static unsigned crc16Bitwise(const unsigned char* p, size_t size)
+{
+  unsigned short crc16 = 0;
+  while(size--)
+  {
+    crc16 ^= (unsigned short) (*p++ << 8);
+    for(int j = 0; j < 8; ++j)
+      crc16 = (unsigned short) (crc16 & 0x8000 ? crc16 << 1 ^ 0x8005 : crc16 << 1);
+  }
+  return crc16;
+}
+
+/** The CRC16 calculated byte by byte for the benchmark. */
+static unsigned crc16Bytewise(const unsigned char* p, size_t size)
+{
+  unsigned short crc16 = 0;
+  while(size--)
+    crc16 = (unsigned short) (crc16 << 8 ^ tables.crc16[0][crc16 >> 8 ^ *p++]);
+  return crc16;
+}
+
+/** The CRC16 calculated with slicing-by-8 for the benchmark. */
+static unsigned crc16Sliced(const unsigned char* p, size_t size)
+{
+  return CRC::calcCRC16(p, size);
+}
+
+/** The CRC32 calculated bit by bit as the reference for the benchmark. */
+static unsigned crc32Bitwise(const unsigned char* p, size_t size)
+{
+  unsigned crc32 = 0xffffffff;
+  while(size--)
+  {
+    crc32 ^= *p++;
+    for(int j = 0; j < 8; ++j)
+      crc32 = crc32 & 1 ? crc32 >> 1 ^ 0xedb88320 : crc32 >> 1;
+  }
+  return ~crc32;
+}
+
+/** The CRC32 calculated byte by byte for the benchmark. */
+static unsigned crc32Bytewise(const unsigned char* p, size_t size)
+{
+  unsigned crc32 = 0xffffffff;
+  while(size--)
+    crc32 = crc32 >> 8 ^ tables.crc32[0][(crc32 ^ *p++) & 0xff];
+  return ~crc32;
+}
+
+/** The CRC32 calculated with slicing-by-8 for the benchmark. */
+static unsigned crc32Sliced(const unsigned char* p, size_t size)
+{
+  return CRC::calcCRC32(p, size);
+}
+
+/**
+* The function measures the throughput of a checksum calculation.
+* @param function The function that calculates the checksum.
+* @param data The data the checksum is calculated of.
+* @param repetitions How often is the checksum calculated?
+* @param result The checksum is returned here.
+* @return The throughput in MB/s.
+*/
+static unsigned measure(unsigned (*function)(const unsigned char*, size_t), const std::vector<unsigned char>& data,
+                        int repetitions, unsigned& result)
+{
+  const unsigned startTime = SystemCall::getUsSystemTime();
+  for(int i = 0; i < repetitions; ++i)
+    result = function(&data[0], data.size());
+  const unsigned duration = SystemCall::getUsSystemTime() - startTime;
+  return unsigned(data.size() * repetitions / (duration ? duration : 1));
+}
+
+void CRC::benchmark()
+{
+  std::vector<unsigned char> data(0x10000);
+  unsigned random = 1;
+  for(std::vector<unsigned char>::iterator i = data.begin(); i != data.end(); ++i)
+  {
+    random = random * 1103515245 + 12345;
+    *i = (unsigned char) (random >> 16);
+  }
+
+  unsigned result[6];
+  const unsigned crc16BitwiseSpeed = measure(crc16Bitwise, data, 4, result[0]),
+                 crc16BytewiseSpeed = measure(crc16Bytewise, data, 32, result[1]),
+                 crc16SlicedSpeed = measure(crc16Sliced, data, 32, result[2]),
+                 crc32BitwiseSpeed = measure(crc32Bitwise, data, 4, result[3]),
+                 crc32BytewiseSpeed = measure(crc32Bytewise, data, 32, result[4]),
+                 crc32SlicedSpeed = measure(crc32Sliced, data, 32, result[5]);
+  OUTPUT(idText, text, "CRC16 (MB/s): bitwise " << crc16BitwiseSpeed << ", bytewise " << crc16BytewiseSpeed
+         << ", slicing-by-8 " << crc16SlicedSpeed << (result[0] == result[1] && result[0] == result[2] ? "" : ", results differ!"));
+  OUTPUT(idText, text, "CRC32 (MB/s): bitwise " << crc32BitwiseSpeed << ", bytewise " << crc32BytewiseSpeed
+         << ", slicing-by-8 " << crc32SlicedSpeed << (result[3] == result[4] && result[3] == result[5] ? "" : ", results differ!"));
+}
@@ -0,0 +1,53 @@
+/**
+* @file Tools/CRC.h
+*
+* Declaration of a class that calculates CRC checksums.
+*/
+
+#ifndef __CRC_h_
+#define __CRC_h_
+
+#include <cstddef>
+
+/**
+* @class CRC
+*
+* The class calculates CRC16 and CRC32 checksums. It uses the slicing-by-8
+* algorithm, i.e. eight lookup tables per checksum that allow processing eight
+* bytes at once with independent table accesses. The CRC16 uses the polynomial
+* 0x8005 without reflection and with the initial value 0, as the team
+* communication always did. The CRC32 is the one of Ethernet and zlib
+* (reflected polynomial 0xedb88320, initial and final value 0xffffffff).
+* Both checksums can be calculated over several blocks of memory by passing
+* the checksum of the previous blocks as the initial value.
+* The tables are filled when the program starts.
+*/
+class CRC
+{
+public:
+  /**
+  * The method calculates the CRC16 checksum of a memory area.
+  * @param address The begin of the area.
+  * @param size The length of the area in bytes.
+  * @param crc16 The checksum of the data preceding this area.
+  * @return The checksum.
+  */
+  static unsigned short calcCRC16(const void* address, size_t size, unsigned short crc16 = 0);
+
+  /**
+  * The method calculates the CRC32 checksum of a memory area.
+  * @param address The begin of the area.
+  * @param size The length of the area in bytes.
+  * @param crc32 The checksum of the data preceding this area.
+  * @return The checksum.
+  */
+  static unsigned calcCRC32(const void* address, size_t size, unsigned crc32 = 0);
+
+  /**
+  * The method measures the throughput of the bitwise, the bytewise, and the
+  * slicing-by-8 calculation of both checksums and sends it as text.
+  */
+  static void benchmark();
+};
+
+#endif //__CRC_h_
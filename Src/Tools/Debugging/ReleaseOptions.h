@@ -24,6 +24,7 @@ private:
     STREAM(robotHealth);
     STREAM(motionRequest);
     STREAM(linePercept);
+    STREAM(moduleTimings);
     STREAM_REGISTER_FINISH();
   }
 
@@ -36,13 +37,15 @@ public:
     sensorData(false),
     robotHealth(true), // Send health data per default
     motionRequest(true), // same here
-    linePercept(false) {}
+    linePercept(false),
+    moduleTimings(false) {}
 
   char stopwatch;     /**< The first character of the name of the stopwatch to send. */
   bool sensorData,    /**< Activate sending sensorData. */
        robotHealth,   /**< Activate sending robot health data. */
        motionRequest, /**< Activate sending motion requests. */
-       linePercept; /**< Activate sending line percepts. */
+       linePercept, /**< Activate sending line percepts. */
+       moduleTimings; /**< Activate measuring and sending the execution times of all providers. */
 };
 
 #endif // __ReleaseOptions_h_
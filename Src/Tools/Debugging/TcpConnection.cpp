@@ -8,10 +8,12 @@
 
 #include "TcpConnection.h"
 #include "Platform/GTAssert.h"
+#include "Tools/CRC.h"
 
-void TcpConnection::connect(const char* ip, int port, Handshake handshake, int maxPackageSendSize, int maxPackageReceiveSize)
+void TcpConnection::connect(const char* ip, int port, Handshake handshake, int maxPackageSendSize, int maxPackageReceiveSize, bool checksum)
 {
   this->handshake = handshake;
+  this->checksum = checksum;
   ack = false;
 
   tcpComm = new TcpComm(ip, port, maxPackageSendSize, maxPackageReceiveSize);
@@ -46,8 +48,11 @@ bool TcpConnection::sendAndReceive(const unsigned char* dataToSend, int sendSize
   if((handshake != receiver || ack) &&
      isConnected() && sendSize > 0)
   {
-    if(tcpComm->send((unsigned char*) &sendSize, sizeof(sendSize)) && // sends size of block
-       tcpComm->send(dataToSend, sendSize))                           // sends data
+    const int flaggedSize = checksum ? sendSize | CHECKSUM_FLAG : sendSize;
+    const unsigned crc32 = checksum ? CRC::calcCRC32(dataToSend, sendSize) : 0;
+    if(tcpComm->send((unsigned char*) &flaggedSize, sizeof(flaggedSize)) && // sends size of block
+       tcpComm->send(dataToSend, sendSize) &&                               // sends data
+       (!checksum || tcpComm->send((unsigned char*) &crc32, sizeof(crc32)))) // sends checksum
     {
       ack = false;
       return true;
@@ -75,6 +80,9 @@ int TcpConnection::receive(unsigned char*& buffer)
     }
     else
     {
+      const bool hasChecksum = (size & CHECKSUM_FLAG) != 0;
+      size &= ~CHECKSUM_FLAG;
+
       // prevent from allocating to much buffer
       if(size > MAX_PACKAGE_SIZE)
         return -1;
@@ -86,11 +94,19 @@ int TcpConnection::receive(unsigned char*& buffer)
         delete [] buffer;
         return -1; // error
       }
-      else
+      else if(hasChecksum)
       {
-        ack = true;
-        return size; // package received
+        unsigned crc32;
+        if(!tcpComm->receive((unsigned char*) &crc32, sizeof(crc32), true) ||
+           crc32 != CRC::calcCRC32(buffer, size))
+        {
+          delete [] buffer;
+          return -1; // error or corrupted package
+        }
+        checksum = true; // answer with checksums as well
       }
+      ack = true;
+      return size; // package received
     }
   }
   else
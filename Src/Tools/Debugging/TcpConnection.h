@@ -12,10 +12,16 @@
 #include "Platform/TcpComm.h"
 
 #define MAX_PACKAGE_SIZE    67108864      // max package size that can be received. prevent from allocating to much buffer (max ~64 MB)
+#define CHECKSUM_FLAG       0x40000000    // set in the size of a package that is followed by a CRC32 checksum
 
 /**
 * @class TcpConnection
 * The class implements a tcp connection.
+* Each package is preceded by its size. Optionally, a CRC32 checksum of the data
+* follows each package, which is marked by setting CHECKSUM_FLAG in the size.
+* Packages with wrong checksums are treated as failures. Both kinds of packages
+* are always accepted. As soon as a package with a checksum was received, all
+* further packages are also sent with checksums.
 */
 class TcpConnection
 {
@@ -32,6 +38,7 @@ private:
   bool ack,
        client;
   Handshake handshake; /**< The handshake mode. */
+  bool checksum; /**< Are packages sent with a CRC32 checksum? */
 
   /**
   * The function tries to receive a package.
@@ -47,7 +54,7 @@ public:
   /**
   * Default constructor.
   */
-  TcpConnection() : tcpComm(0), client(false) {}
+  TcpConnection() : tcpComm(0), client(false), checksum(false) {}
 
   /**
   * Constructor.
@@ -62,10 +69,11 @@ public:
   *                           If 0, this setting is ignored. 
   * @param maxPackageReceiveSize The maximum size of an incouming package. 
   *                              If 0, this setting is ignored. 
+  * @param checksum Send packages with a CRC32 checksum?
   */
   TcpConnection(const char* ip, int port, Handshake handshake = noHandshake, 
-                int maxPackageSendSize = 0, int maxPackageReceiveSize = 0)
-    {connect(ip, port, handshake, maxPackageSendSize, maxPackageReceiveSize);}
+                int maxPackageSendSize = 0, int maxPackageReceiveSize = 0, bool checksum = false)
+    {connect(ip, port, handshake, maxPackageSendSize, maxPackageReceiveSize, checksum);}
 
 
   /**
@@ -82,9 +90,10 @@ public:
   * @param handshake The handshake mode.
   * @param maxPackageSendSize The maximum size of packages to send.
   * @param maxPackageReceiveSize The maximum size of packages to receive.
+  * @param checksum Send packages with a CRC32 checksum?
   */
   void connect(const char* ip, int port, Handshake handshake = noHandshake,
-               int maxPackageSendSize = 0, int maxPackageReceiveSize = 0);
+               int maxPackageSendSize = 0, int maxPackageReceiveSize = 0, bool checksum = false);
 
   /** 
   * The function sends and receives data.
@@ -21,6 +21,7 @@ class ReleaseOptions;
 
 class Process;
 class ConsoleRoboCupCtrl;
+class ParallelExecutor;
 
 /** 
 * @class Global
@@ -52,6 +53,12 @@ public:
   */
   static OutMessage& getTeamOut() {return *theTeamOut;}
 
+  /**
+  * The method returns whether this process has an outgoing team message queue.
+  * @return Can getTeamOut() be called?
+  */
+  static bool hasTeamOut() {return theTeamOut != 0;}
+
   /**
   * The method returns a reference to the process wide instance.
   * @return The instance of the settings in this process.
@@ -97,6 +104,7 @@ public:
   friend class Process; // The class Process can set these pointers.
   friend class Cognition; // The class Cognition can set theTeamOut.
   friend class ConsoleRoboCupCtrl; // The class ConsoleRoboCupCtrl can set theStreamHandler.
+  friend class ParallelExecutor; // The class ParallelExecutor can share these pointers with its threads.
 };
 
 #endif //__Global_h_
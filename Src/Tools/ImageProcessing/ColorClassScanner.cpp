@@ -0,0 +1,135 @@
+/**
+* @file ColorClassScanner.cpp
+* Implementation of a class that searches runs in lines of color classes block-wise.
+*/
+
+#include "ColorClassScanner.h"
+#include "Platform/GTAssert.h"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COLORCLASSSCANNER_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+int ColorClassScanner::findGap(const unsigned char* line, int start, int end, unsigned char color, int gapLength, bool reverse)
+{
+  ASSERT(gapLength > 0 && gapLength <= 16);
+  int carry = 0; // the number of pixels != color directly before the current block
+  for(int pos = start; reverse ? pos > end : pos < end; pos += reverse ? -16 : 16)
+  {
+    int n;
+    unsigned mask;
+    if(reverse)
+    {
+      n = std::min(16, pos - end);
+      mask = reverseBits(notEqualMask(line + pos - n + 1, n, color), n);
+    }
+    else
+    {
+      n = std::min(16, end - pos);
+      mask = notEqualMask(line + pos, n, color);
+    }
+
+    // prepend the pixels of the previous block that might belong to the gap
+    const unsigned bits = mask << carry | ((1 << carry) - 1);
+    unsigned gaps = bits;
+    for(int i = 1; i < gapLength; ++i)
+      gaps &= bits >> i;
+    if(gaps)
+    {
+      const int offset = lowestBit(gaps) - carry;
+      return reverse ? pos - offset : pos + offset;
+    }
+
+    // no gap found, so carry < gapLength and used < 32
+    const int used = n + carry;
+    const unsigned zeros = ~bits & ((1 << used) - 1);
+    carry = zeros ? used - 1 - highestBit(zeros) : used;
+  }
+  return end;
+}
+
+int ColorClassScanner::findSample(const unsigned char* line, int start, int end, int step, unsigned char color1, unsigned char color2)
+{
+  ASSERT(step > 0);
+  for(int pos = start + 1; pos < end; pos += 16)
+  {
+    const int n = std::min(16, end - pos);
+    unsigned samples = 0;
+    for(int i = (step - (pos - start) % step) % step; i < n; i += step)
+      samples |= 1 << i;
+    const unsigned found = equalMask(line + pos, n, color1, color2) & samples;
+    if(found)
+      return pos + lowestBit(found);
+  }
+  return end;
+}
+
+unsigned ColorClassScanner::notEqualMask(const unsigned char* line, int n, unsigned char color)
+{
+#ifdef COLORCLASSSCANNER_SSE2
+  if(n == 16)
+  {
+    const __m128i pixels = _mm_loadu_si128((const __m128i*) line);
+    return ~_mm_movemask_epi8(_mm_cmpeq_epi8(pixels, _mm_set1_epi8((char) color))) & 0xffff;
+  }
+#endif
+  unsigned mask = 0;
+  for(int i = 0; i < n; ++i)
+    if(line[i] != color)
+      mask |= 1 << i;
+  return mask;
+}
+
+unsigned ColorClassScanner::equalMask(const unsigned char* line, int n, unsigned char color1, unsigned char color2)
+{
+#ifdef COLORCLASSSCANNER_SSE2
+  if(n == 16)
+  {
+    const __m128i pixels = _mm_loadu_si128((const __m128i*) line);
+    return _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(pixels, _mm_set1_epi8((char) color1)),
+                                          _mm_cmpeq_epi8(pixels, _mm_set1_epi8((char) color2))));
+  }
+#endif
+  unsigned mask = 0;
+  for(int i = 0; i < n; ++i)
+    if(line[i] == color1 || line[i] == color2)
+      mask |= 1 << i;
+  return mask;
+}
+
+unsigned ColorClassScanner::reverseBits(unsigned mask, int n)
+{
+  mask = (mask & 0x5555) << 1 | (mask >> 1 & 0x5555);
+  mask = (mask & 0x3333) << 2 | (mask >> 2 & 0x3333);
+  mask = (mask & 0x0f0f) << 4 | (mask >> 4 & 0x0f0f);
+  mask = (mask & 0x00ff) << 8 | (mask >> 8 & 0x00ff);
+  return mask >> (16 - n);
+}
+
+int ColorClassScanner::lowestBit(unsigned mask)
+{
+#ifdef _MSC_VER
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return (int) index;
+#else
+  return __builtin_ctz(mask);
+#endif
+}
+
+int ColorClassScanner::highestBit(unsigned mask)
+{
+#ifdef _MSC_VER
+  unsigned long index;
+  _BitScanReverse(&index, mask);
+  return (int) index;
+#else
+  return 31 - __builtin_clz(mask);
+#endif
+}
@@ -0,0 +1,120 @@
+/**
+* @file ColorClassScanner.h
+* Declaration of a class that searches runs in lines of color classes block-wise.
+*/
+
+#ifndef __ColorClassScanner_h_
+#define __ColorClassScanner_h_
+
+/**
+* @class ColorClassScanner
+*
+* The class provides the run-length searches of the PointExplorer on contiguous
+* lines of color classes, e.g. the columns and rows of the ColorClassPlane.
+* The lines are compared with the colors searched 16 pixels at a time (using
+* SSE2 if available, otherwise with a scalar loop producing the same masks),
+* and the positions are determined from the resulting bit masks.
+* All methods return exactly the same results as the pixel-wise loops in the
+* PointExplorer.
+*/
+class ColorClassScanner
+{
+public:
+  /**
+  * Searches the first gap of at least gapLength pixels that do not have the given color,
+  * running from start towards higher positions.
+  * @param line The color classes of the line.
+  * @param start The first pixel that is examined.
+  * @param end The pixel after the last one that is examined.
+  * @param color The color of the run.
+  * @param gapLength The minimum length of the gap (1..16).
+  * @return The position of the first pixel of the gap or end if there is none.
+  */
+  static int findGap(const unsigned char* line, int start, int end, unsigned char color, int gapLength)
+  {
+    return findGap(line, start, end, color, gapLength, false);
+  }
+
+  /**
+  * Searches the first gap of at least gapLength pixels that do not have the given color,
+  * running from start towards lower positions.
+  * @param line The color classes of the line.
+  * @param start The first pixel that is examined.
+  * @param end The pixel before the last one that is examined (end < start).
+  * @param color The color of the run.
+  * @param gapLength The minimum length of the gap (1..16).
+  * @return The position of the first pixel of the gap (i.e. its highest one) or end if there is none.
+  */
+  static int findGapReverse(const unsigned char* line, int start, int end, unsigned char color, int gapLength)
+  {
+    return findGap(line, start, end, color, gapLength, true);
+  }
+
+  /**
+  * Searches the first of the sampled pixels start + k * step (k >= 1) that has color1 or color2.
+  * @param line The color classes of the line.
+  * @param start The pixel the sampling starts from.
+  * @param end The pixel after the last one that is examined.
+  * @param step The distance between the sampled pixels.
+  * @param color1 The first color searched.
+  * @param color2 The second color searched (can be the same as color1).
+  * @return The position of the pixel found or end if there is none.
+  */
+  static int findSample(const unsigned char* line, int start, int end, int step, unsigned char color1, unsigned char color2);
+
+private:
+  /**
+  * The method implements the search for gaps in both directions.
+  * @param line The color classes of the line.
+  * @param start The first pixel that is examined.
+  * @param end The pixel after the last one that is examined in search direction.
+  * @param color The color of the run.
+  * @param gapLength The minimum length of the gap (1..16).
+  * @param reverse Search towards lower positions?
+  * @return The position of the first pixel of the gap or end if there is none.
+  */
+  static int findGap(const unsigned char* line, int start, int end, unsigned char color, int gapLength, bool reverse);
+
+  /**
+  * The method compares up to 16 pixels with a color.
+  * @param line The first pixel compared.
+  * @param n The number of pixels compared.
+  * @param color The color.
+  * @return A mask in which bit i is set if line[i] != color.
+  */
+  static unsigned notEqualMask(const unsigned char* line, int n, unsigned char color);
+
+  /**
+  * The method compares up to 16 pixels with two colors.
+  * @param line The first pixel compared.
+  * @param n The number of pixels compared.
+  * @param color1 The first color.
+  * @param color2 The second color.
+  * @return A mask in which bit i is set if line[i] == color1 or line[i] == color2.
+  */
+  static unsigned equalMask(const unsigned char* line, int n, unsigned char color1, unsigned char color2);
+
+  /**
+  * Reverses the order of the lower n bits of a mask.
+  * @param mask The mask. All other bits must be 0.
+  * @param n The number of bits used.
+  * @return The reversed mask.
+  */
+  static unsigned reverseBits(unsigned mask, int n);
+
+  /**
+  * Returns the index of the lowest bit set.
+  * @param mask The mask. Must not be 0.
+  * @return The index of the lowest bit set.
+  */
+  static int lowestBit(unsigned mask);
+
+  /**
+  * Returns the index of the highest bit set.
+  * @param mask The mask. Must not be 0.
+  * @return The index of the highest bit set.
+  */
+  static int highestBit(unsigned mask);
+};
+
+#endif //__ColorClassScanner_h_
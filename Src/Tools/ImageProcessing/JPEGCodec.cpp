@@ -0,0 +1,384 @@
+/**
+* @file JPEGCodec.cpp
+*
+* Implementation of classes that compress images to JPEG and decompress them again.
+*/
+
+#include "JPEGCodec.h"
+#include "Platform/GTAssert.h"
+#include "Platform/Thread.h"
+#include <string.h>
+#include <algorithm>
+
+#ifndef LINUX
+
+// INT32 and FAR conflict with any other header files...
+#define INT32 _INT32
+#undef FAR
+
+// "boolean" conflicts with "rpcndr.h", so we force "jpeglib.h" not to define boolean
+#ifdef __RPCNDR_H__
+#define HAVE_BOOLEAN
+#endif
+
+#include <../Util/libjpeg/src/jpeglib.h>
+
+#undef INT32
+#undef FAR
+
+
+#else
+extern "C"
+{
+#include <../Util/libjpeg/src/jpeglib.h>
+}
+#endif
+
+/**
+* The class represents a horizontal strip of the image and the context
+* that compresses it. It is also its own libjpeg destination manager.
+*/
+class JPEGEncoder::Strip : public jpeg_destination_mgr
+{
+public:
+  jpeg_compress_struct cInfo; /**< The libjpeg compression context. */
+  jpeg_error_mgr errorManager; /**< The libjpeg error handler. */
+  std::vector<unsigned char> buffer; /**< The compressed strip. Grows if required. */
+  int size; /**< The number of bytes in buffer actually used. */
+  std::vector<JSAMPROW> rows; /**< The addresses of the rows of the strip. */
+  Semaphore startStrip; /**< Signals that the strip can be compressed. */
+  Semaphore stripDone; /**< Signals that the strip was compressed. */
+  Thread<Strip> thread; /**< The thread. Declared last, so it is terminated before the semaphores are destroyed. */
+
+  /** Constructor. */
+  Strip();
+
+  /** Destructor. Terminates the thread if it was started. */
+  ~Strip();
+
+  /**
+  * The method sets the rows of the image that belong to this strip.
+  * @param image The image.
+  * @param width The width of the image.
+  * @param firstRow The first row of the strip.
+  * @param numOfRows The number of rows of the strip.
+  */
+  void setRows(const Image& image, int width, int firstRow, int numOfRows);
+
+  /** The method compresses the rows set. */
+  void compress();
+
+  /** The main function of the thread. It compresses the strip whenever it is signaled. */
+  void run();
+
+  //!@name Handlers for the libjpeg destination manager
+  //!@{
+  static void onDestInit(j_compress_ptr cInfo);
+  static boolean onDestEmpty(j_compress_ptr cInfo);
+  static void onDestTerm(j_compress_ptr cInfo);
+  //!@}
+};
+
+/**
+* The class contains the libjpeg decompression context. It reads from memory.
+*/
+class JPEGDecoder::Context
+{
+public:
+  jpeg_decompress_struct cInfo; /**< The libjpeg decompression context. */
+  jpeg_error_mgr errorManager; /**< The libjpeg error handler. */
+  jpeg_source_mgr source; /**< The libjpeg source manager. It reads from memory. */
+  std::vector<JSAMPROW> rows; /**< The addresses of the rows of the image decompressed. */
+
+  /** Constructor. */
+  Context();
+
+  /** Destructor. */
+  ~Context();
+
+  //!@name Handlers for the libjpeg source manager
+  //!@{
+  static void onSrcSkip(j_decompress_ptr cInfo, long numBytes);
+  static boolean onSrcEmpty(j_decompress_ptr cInfo);
+  static void onSrcIgnore(j_decompress_ptr cInfo);
+  //!@}
+};
+
+/**
+* The function searches a marker in the header of a JPEG image.
+* @param data The JPEG image.
+* @param size The size of the JPEG image.
+* @param marker The second byte of the marker.
+* @return The offset of the marker or -1 if it was not found before the scan.
+*/
+static int findMarker(const unsigned char* data, int size, unsigned char marker)
+{
+  int i = 2; // skip SOI
+  while(i + 4 <= size && data[i] == 0xff)
+  {
+    if(data[i + 1] == marker)
+      return i;
+    else if(data[i + 1] == 0xda) // the scan follows, no more headers
+      return -1;
+    i += 2 + (data[i + 2] << 8 | data[i + 3]);
+  }
+  return -1;
+}
+
+JPEGEncoder::Strip::Strip() : size(0)
+{
+  cInfo.err = jpeg_std_error(&errorManager);
+  jpeg_create_compress(&cInfo);
+  cInfo.dest = this;
+  init_destination = onDestInit;
+  empty_output_buffer = onDestEmpty;
+  term_destination = onDestTerm;
+  buffer.resize(0x10000);
+
+  cInfo.input_components = 4;
+  cInfo.in_color_space = JCS_CMYK;
+  jpeg_set_defaults(&cInfo);
+  cInfo.dct_method = JDCT_FASTEST;
+}
+
+JPEGEncoder::Strip::~Strip()
+{
+  if(thread.isRunning())
+  {
+    thread.announceStop();
+    startStrip.post();
+  }
+  jpeg_destroy_compress(&cInfo);
+}
+
+void JPEGEncoder::Strip::setRows(const Image& image, int width, int firstRow, int numOfRows)
+{
+  cInfo.image_width = width;
+  cInfo.image_height = numOfRows;
+  rows.resize(numOfRows);
+  for(int i = 0; i < numOfRows; ++i)
+    rows[i] = (JSAMPROW) &image.image[firstRow + i][0];
+}
+
+void JPEGEncoder::Strip::compress()
+{
+  jpeg_start_compress(&cInfo, TRUE);
+  while(cInfo.next_scanline < cInfo.image_height)
+    jpeg_write_scanlines(&cInfo, &rows[cInfo.next_scanline], cInfo.image_height - cInfo.next_scanline);
+  jpeg_finish_compress(&cInfo);
+}
+
+void JPEGEncoder::Strip::run()
+{
+  for(;;)
+  {
+    startStrip.wait();
+    if(!thread.isRunning())
+      break;
+    compress();
+    stripDone.post();
+  }
+}
+
+void JPEGEncoder::Strip::onDestInit(j_compress_ptr cInfo)
+{
+  Strip& strip = *static_cast<Strip*>(cInfo->dest);
+  strip.next_output_byte = &strip.buffer[0];
+  strip.free_in_buffer = strip.buffer.size();
+}
+
+boolean JPEGEncoder::Strip::onDestEmpty(j_compress_ptr cInfo)
+{
+  // libjpeg only calls this if the whole buffer is full, so double its size
+  Strip& strip = *static_cast<Strip*>(cInfo->dest);
+  const size_t size = strip.buffer.size();
+  strip.buffer.resize(size * 2);
+  strip.next_output_byte = &strip.buffer[size];
+  strip.free_in_buffer = size;
+  return TRUE;
+}
+
+void JPEGEncoder::Strip::onDestTerm(j_compress_ptr cInfo)
+{
+  Strip& strip = *static_cast<Strip*>(cInfo->dest);
+  strip.size = int(strip.next_output_byte - &strip.buffer[0]);
+}
+
+JPEGEncoder::JPEGEncoder(int numOfStrips, int quality) :
+  started(false)
+{
+  ASSERT(numOfStrips > 0);
+  for(int i = 0; i < numOfStrips; ++i)
+  {
+    strips.push_back(new Strip);
+    jpeg_set_quality(&strips.back()->cInfo, quality, TRUE);
+  }
+}
+
+JPEGEncoder::~JPEGEncoder()
+{
+  for(std::vector<Strip*>::iterator i = strips.begin(); i != strips.end(); ++i)
+    delete *i;
+}
+
+int JPEGEncoder::encode(const Image& src, unsigned char* dest, int maxSize)
+{
+  // The threads are started when the encoder is used for the first time.
+  if(!started)
+  {
+    for(std::vector<Strip*>::iterator i = strips.begin() + 1; i < strips.end(); ++i)
+      (*i)->thread.start(*i, &Strip::run);
+    started = true;
+  }
+
+  if(src.cameraInfo.resolutionHeight <= 0)
+    return 0;
+
+  // Strips consist of complete rows of MCUs, i.e. 8 rows of pixels.
+  const int width = src.cameraInfo.resolutionWidth,
+            height = src.cameraInfo.resolutionHeight,
+            rowsPerStrip = ((height + 7) / 8 + (int) strips.size() - 1) / (int) strips.size() * 8,
+            numOfStrips = (height + rowsPerStrip - 1) / rowsPerStrip;
+  for(int i = 0; i < numOfStrips; ++i)
+    strips[i]->setRows(src, width, i * rowsPerStrip, std::min(rowsPerStrip, height - i * rowsPerStrip));
+
+  for(int i = 1; i < numOfStrips; ++i)
+    strips[i]->startStrip.post();
+  strips[0]->compress();
+  for(int i = 1; i < numOfStrips; ++i)
+    strips[i]->stripDone.wait();
+
+  return join(numOfStrips, height, (width + 7) / 8 * rowsPerStrip / 8, dest, maxSize);
+}
+
+int JPEGEncoder::join(int numOfStrips, int height, int restartInterval, unsigned char* dest, int maxSize) const
+{
+  const Strip& first = *strips[0];
+  if(numOfStrips == 1)
+  {
+    if(first.size > maxSize)
+      return 0;
+    memcpy(dest, &first.buffer[0], first.size);
+    return first.size;
+  }
+
+  // The headers of the first strip are used for the whole image.
+  // The image height is corrected and a restart interval is defined.
+  const unsigned char* header = &first.buffer[0];
+  const int sof = findMarker(header, first.size, 0xc0),
+            sos = findMarker(header, first.size, 0xda);
+  if(sof < 0 || sos < 0 || restartInterval > 0xffff)
+    return 0;
+
+  // The scan data of each strip lies between its scan header and its EOI marker.
+  std::vector<int> begins(numOfStrips);
+  int size = sos + 6 + 2 * (numOfStrips - 1) + 2;
+  for(int i = 0; i < numOfStrips; ++i)
+  {
+    const Strip& strip = *strips[i];
+    const int scan = i ? findMarker(&strip.buffer[0], strip.size, 0xda) : sos;
+    if(scan < 0)
+      return 0;
+    begins[i] = i ? scan + 2 + (strip.buffer[scan + 2] << 8 | strip.buffer[scan + 3]) : sos;
+    size += strip.size - 2 - begins[i];
+  }
+  if(size > maxSize)
+    return 0;
+
+  unsigned char* p = dest;
+  memcpy(p, header, sos);
+  p[sof + 5] = (unsigned char) (height >> 8);
+  p[sof + 6] = (unsigned char) height;
+  p += sos;
+  *p++ = 0xff; // DRI
+  *p++ = 0xdd;
+  *p++ = 0;
+  *p++ = 4;
+  *p++ = (unsigned char) (restartInterval >> 8);
+  *p++ = (unsigned char) restartInterval;
+  for(int i = 0; i < numOfStrips; ++i)
+  {
+    const Strip& strip = *strips[i];
+    if(i)
+    {
+      *p++ = 0xff; // RSTn
+      *p++ = (unsigned char) (0xd0 + ((i - 1) & 7));
+    }
+    const int length = strip.size - 2 - begins[i]; // without EOI
+    memcpy(p, &strip.buffer[begins[i]], length);
+    p += length;
+  }
+  *p++ = 0xff; // EOI
+  *p++ = 0xd9;
+  ASSERT(p - dest == size);
+  return size;
+}
+
+JPEGDecoder::Context::Context()
+{
+  cInfo.err = jpeg_std_error(&errorManager);
+  jpeg_create_decompress(&cInfo);
+  source.init_source = onSrcIgnore;
+  source.fill_input_buffer = onSrcEmpty;
+  source.skip_input_data = onSrcSkip;
+  source.resync_to_restart = jpeg_resync_to_restart;
+  source.term_source = onSrcIgnore;
+  cInfo.src = &source;
+}
+
+JPEGDecoder::Context::~Context()
+{
+  jpeg_destroy_decompress(&cInfo);
+}
+
+JPEGDecoder::JPEGDecoder() :
+  context(new Context)
+{
+}
+
+JPEGDecoder::~JPEGDecoder()
+{
+  delete context;
+}
+
+void JPEGDecoder::decode(const unsigned char* src, int size, Image& dest)
+{
+  jpeg_decompress_struct& cInfo = context->cInfo;
+  jpeg_source_mgr& source = context->source;
+  std::vector<JSAMPROW>& rows = context->rows;
+  source.next_input_byte = (const JOCTET*) src;
+  source.bytes_in_buffer = size;
+  jpeg_read_header(&cInfo, TRUE);
+  jpeg_start_decompress(&cInfo);
+
+  const int height = cInfo.output_height;
+  ASSERT(height <= cameraResolutionHeight);
+  rows.resize(height);
+  for(int i = 0; i < height; ++i)
+    rows[i] = (JSAMPROW) &dest.image[i][0];
+  while(cInfo.output_scanline < cInfo.output_height)
+    jpeg_read_scanlines(&cInfo, &rows[cInfo.output_scanline], cInfo.output_height - cInfo.output_scanline);
+
+  jpeg_finish_decompress(&cInfo);
+}
+
+void JPEGDecoder::Context::onSrcSkip(j_decompress_ptr cInfo, long numBytes)
+{
+  if(numBytes > (long) cInfo->src->bytes_in_buffer)
+    numBytes = (long) cInfo->src->bytes_in_buffer;
+  cInfo->src->next_input_byte += numBytes;
+  cInfo->src->bytes_in_buffer -= numBytes;
+}
+
+boolean JPEGDecoder::Context::onSrcEmpty(j_decompress_ptr cInfo)
+{
+  // The image is truncated. Insert an EOI marker, so libjpeg does not wait for more data.
+  static const JOCTET eoi[2] = {0xff, JPEG_EOI};
+  cInfo->src->next_input_byte = eoi;
+  cInfo->src->bytes_in_buffer = 2;
+  return TRUE;
+}
+
+void JPEGDecoder::Context::onSrcIgnore(j_decompress_ptr)
+{
+}
@@ -0,0 +1,97 @@
+/**
+* @file JPEGCodec.h
+*
+* Declaration of classes that compress images to JPEG and decompress them again.
+*/
+
+#ifndef __JPEGCodec_h_
+#define __JPEGCodec_h_
+
+#include "Representations/Infrastructure/Image.h"
+#include <vector>
+
+/**
+* @class JPEGEncoder
+*
+* The class compresses images to JPEG. The four bytes of each pixel are
+* compressed as the channels of a CMYK image. The libjpeg contexts and all
+* buffers are kept between images, so compressing an image does not allocate
+* memory once the buffers have grown to their final sizes.
+* The image can be split into several horizontal strips that are compressed
+* by threads of their own. The strips are joined to a single JPEG image in
+* which they are separated by restart markers. Each strip except the first
+* one requires an additional thread, so this is only useful on multi-core
+* machines.
+* libjpeg is only included by the implementation, because its definition of
+* boolean conflicts with files that define HAVE_BOOLEAN, e.g. Cognition.cpp.
+*/
+class JPEGEncoder
+{
+private:
+  class Strip; /**< A horizontal strip of the image and the libjpeg context that compresses it. */
+
+  std::vector<Strip*> strips; /**< The strips. The first one is compressed by the calling thread. */
+  bool started; /**< Were the threads started? */
+
+  /**
+  * The method joins the compressed strips to a single JPEG image.
+  * @param numOfStrips The number of strips actually used.
+  * @param height The height of the image.
+  * @param restartInterval The number of MCUs per strip.
+  * @param dest The memory the JPEG image is written to.
+  * @param maxSize The number of bytes available.
+  * @return The size of the JPEG image or 0 if it did not fit.
+  */
+  int join(int numOfStrips, int height, int restartInterval, unsigned char* dest, int maxSize) const;
+
+public:
+  /**
+  * Constructor.
+  * @param numOfStrips The number of strips that are compressed in parallel.
+  * @param quality The JPEG quality (0..100).
+  */
+  JPEGEncoder(int numOfStrips = 1, int quality = 75);
+
+  /** Destructor. */
+  ~JPEGEncoder();
+
+  /**
+  * The method compresses an image.
+  * @param src The image. Its size is taken from its camera info.
+  * @param dest The memory the JPEG image is written to.
+  * @param maxSize The number of bytes available.
+  * @return The size of the JPEG image or 0 if it did not fit.
+  */
+  int encode(const Image& src, unsigned char* dest, int maxSize);
+};
+
+/**
+* @class JPEGDecoder
+*
+* The class decompresses images compressed by JPEGEncoder. The libjpeg
+* context is kept between images.
+*/
+class JPEGDecoder
+{
+private:
+  class Context; /**< The libjpeg decompression context and its source manager. */
+
+  Context* context; /**< The context. */
+
+public:
+  /** Constructor. */
+  JPEGDecoder();
+
+  /** Destructor. */
+  ~JPEGDecoder();
+
+  /**
+  * The method decompresses an image.
+  * @param src The JPEG image.
+  * @param size The size of the JPEG image in bytes.
+  * @param dest The image decompressed. Its camera info is not changed.
+  */
+  void decode(const unsigned char* src, int size, Image& dest);
+};
+
+#endif //__JPEGCodec_h_
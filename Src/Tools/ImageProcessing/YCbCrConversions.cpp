@@ -0,0 +1,147 @@
+/**
+* @file YCbCrConversions.cpp
+*
+* Implementation of a class that converts rows of RGB pixels into the YCbCr format of the camera.
+*/
+
+#include "YCbCrConversions.h"
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define YCBCRCONVERSIONS_SSE2
+#include <emmintrin.h>
+#endif
+
+/**
+* The function converts a single pixel. It is the reference for the vectorized conversion.
+* The offset of 127.5 * 1024 keeps all sums within 0..255 * 1024, so no clipping is required.
+* @param r The red channel.
+* @param g The green channel.
+* @param b The blue channel.
+* @param dest The converted pixel.
+*/
+static inline void convertPixel(int r, int g, int b, Image::Pixel& dest)
+{
+  const int y = 306 * r + 601 * g + 117 * b,
+            cb = 130560 - 173 * r - 339 * g + 512 * b,
+            cr = 130560 + 512 * r - 429 * g - 83 * b;
+  dest.y = dest.yCbCrPadding = (unsigned char) (y >> 10);
+  dest.cb = (unsigned char) (cb >> 10);
+  dest.cr = (unsigned char) (cr >> 10);
+}
+
+/** The scalar reference of YCbCrConversions::fromBGR. */
+static void referenceFromBGR(const unsigned char* src, Image::Pixel* dest, int numOfPixels)
+{
+  for(const unsigned char* end = src + numOfPixels * 3; src < end; src += 3)
+    convertPixel(src[2], src[1], src[0], *dest++);
+}
+
+/** The scalar reference of YCbCrConversions::fromRGB. */
+static void referenceFromRGB(const Image::Pixel* src, Image::Pixel* dest, int numOfPixels)
+{
+  for(const Image::Pixel* end = src + numOfPixels; src < end; ++src)
+    convertPixel(src->r, src->g, src->b, *dest++);
+}
+
+#ifdef YCBCRCONVERSIONS_SSE2
+
+/**
+* The function adds neighboring pairs of 32 bit values.
+* @param a The pairs of the first two pixels.
+* @param b The pairs of the last two pixels.
+* @return The sums of the four pixels.
+*/
+static inline __m128i sumPairs(__m128i a, __m128i b)
+{
+  a = _mm_shuffle_epi32(_mm_add_epi32(a, _mm_srli_epi64(a, 32)), _MM_SHUFFLE(3, 1, 2, 0));
+  b = _mm_shuffle_epi32(_mm_add_epi32(b, _mm_srli_epi64(b, 32)), _MM_SHUFFLE(3, 1, 2, 0));
+  return _mm_unpacklo_epi64(a, b);
+}
+
+/**
+* The function converts four pixels of four bytes each. The coefficients
+* define the order of the channels. The fourth byte is multiplied by 0.
+* The sums are calculated with 32 bits, as in convertPixel().
+* @param pixels The source pixels.
+* @param coeffsY The coefficients of the Y channel, twice.
+* @param coeffsCb The coefficients of the Cb channel, twice.
+* @param coeffsCr The coefficients of the Cr channel, twice.
+* @return The pixels converted.
+*/
+static inline __m128i convert4(__m128i pixels, __m128i coeffsY, __m128i coeffsCb, __m128i coeffsCr)
+{
+  const __m128i zero = _mm_setzero_si128(),
+                offset = _mm_set1_epi32(130560),
+                lo = _mm_unpacklo_epi8(pixels, zero),
+                hi = _mm_unpackhi_epi8(pixels, zero),
+                y = _mm_srli_epi32(sumPairs(_mm_madd_epi16(lo, coeffsY), _mm_madd_epi16(hi, coeffsY)), 10),
+                cb = _mm_srli_epi32(_mm_add_epi32(sumPairs(_mm_madd_epi16(lo, coeffsCb), _mm_madd_epi16(hi, coeffsCb)), offset), 10),
+                cr = _mm_srli_epi32(_mm_add_epi32(sumPairs(_mm_madd_epi16(lo, coeffsCr), _mm_madd_epi16(hi, coeffsCr)), offset), 10);
+
+  // the bytes of a pixel are yCbCrPadding, cb, y, cr
+  return _mm_or_si128(_mm_or_si128(y, _mm_slli_epi32(cb, 8)),
+                      _mm_or_si128(_mm_slli_epi32(y, 16), _mm_slli_epi32(cr, 24)));
+}
+
+#endif
+
+void YCbCrConversions::fromBGR(const unsigned char* src, Image::Pixel* dest, int numOfPixels)
+{
+  int i = 0;
+#ifdef YCBCRCONVERSIONS_SSE2
+  const __m128i coeffsY = _mm_set_epi16(0, 306, 601, 117, 0, 306, 601, 117),
+                coeffsCb = _mm_set_epi16(0, -173, -339, 512, 0, -173, -339, 512),
+                coeffsCr = _mm_set_epi16(0, 512, -429, -83, 0, 512, -429, -83);
+
+  // 16 bytes are loaded for 4 pixels, so at least 6 pixels must remain
+  for(; i + 6 <= numOfPixels; i += 4)
+  {
+    const __m128i p = _mm_loadu_si128((const __m128i*) (src + i * 3)),
+                  pixels = _mm_unpacklo_epi64(_mm_unpacklo_epi32(p, _mm_srli_si128(p, 3)),
+                                              _mm_unpacklo_epi32(_mm_srli_si128(p, 6), _mm_srli_si128(p, 9)));
+    _mm_storeu_si128((__m128i*) (dest + i), convert4(pixels, coeffsY, coeffsCb, coeffsCr));
+  }
+#endif
+  referenceFromBGR(src + i * 3, dest + i, numOfPixels - i);
+}
+
+void YCbCrConversions::fromRGB(const Image::Pixel* src, Image::Pixel* dest, int numOfPixels)
+{
+  int i = 0;
+#ifdef YCBCRCONVERSIONS_SSE2
+  const __m128i coeffsY = _mm_set_epi16(0, 117, 601, 306, 0, 117, 601, 306),
+                coeffsCb = _mm_set_epi16(0, 512, -339, -173, 0, 512, -339, -173),
+                coeffsCr = _mm_set_epi16(0, -83, -429, 512, 0, -83, -429, 512);
+
+  for(; i + 4 <= numOfPixels; i += 4)
+    _mm_storeu_si128((__m128i*) (dest + i),
+                     convert4(_mm_loadu_si128((const __m128i*) (src + i)), coeffsY, coeffsCb, coeffsCr));
+#endif
+  referenceFromRGB(src + i, dest + i, numOfPixels - i);
+}
+
+bool YCbCrConversions::selfTest()
+{
+  // compare all colors in blocks of 4096 pixels
+  std::vector<unsigned char> bgr(4096 * 3);
+  std::vector<Image::Pixel> rgb(4096), dest(4096), reference(4096);
+  for(int block = 0; block < 4096; ++block)
+  {
+    for(int i = 0; i < 4096; ++i)
+    {
+      const int color = block << 12 | i;
+      bgr[i * 3] = rgb[i].b = (unsigned char) color;
+      bgr[i * 3 + 1] = rgb[i].g = (unsigned char) (color >> 8);
+      bgr[i * 3 + 2] = rgb[i].r = (unsigned char) (color >> 16);
+      rgb[i].rgbPadding = (unsigned char) i; // must be ignored
+    }
+    referenceFromRGB(&rgb[0], &reference[0], 4096);
+    fromBGR(&bgr[0], &dest[0], 4096);
+    fromRGB(&rgb[0], &rgb[0], 4096);
+    for(int i = 0; i < 4096; ++i)
+      if(dest[i].color != reference[i].color || rgb[i].color != reference[i].color)
+        return false;
+  }
+  return true;
+}
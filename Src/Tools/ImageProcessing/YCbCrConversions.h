@@ -0,0 +1,53 @@
+/**
+* @file YCbCrConversions.h
+*
+* Declaration of a class that converts rows of RGB pixels into the YCbCr format of the camera.
+*/
+
+#ifndef __YCbCrConversions_h_
+#define __YCbCrConversions_h_
+
+#include "Representations/Infrastructure/Image.h"
+
+/**
+* @class YCbCrConversions
+*
+* The class converts whole rows of RGB pixels into the pixel format of the
+* camera images, i.e. the Y channel is also written to yCbCrPadding. The
+* conversion uses integer coefficients scaled by 1024, so its results do not
+* depend on the floating point unit. If SSE2 is available, four pixels are
+* converted at once. The results are bit-exact with the scalar reference
+* implementation that is used for the remaining pixels and on platforms
+* without SSE2.
+*/
+class YCbCrConversions
+{
+public:
+  /**
+  * The method converts a row of pixels with three bytes each in the order
+  * blue, green, red, as delivered by the simulated cameras.
+  * @param src The first source pixel.
+  * @param dest The first destination pixel.
+  * @param numOfPixels The number of pixels to convert.
+  */
+  static void fromBGR(const unsigned char* src, Image::Pixel* dest, int numOfPixels);
+
+  /**
+  * The method converts a row of RGB pixels of an image. Source and
+  * destination may be the same row.
+  * @param src The first source pixel.
+  * @param dest The first destination pixel.
+  * @param numOfPixels The number of pixels to convert.
+  */
+  static void fromRGB(const Image::Pixel* src, Image::Pixel* dest, int numOfPixels);
+
+  /**
+  * The method compares the results of both conversions with the scalar
+  * reference for all 2^24 colors. This takes a while, so it is only called
+  * on demand by the console command "test yCbCr".
+  * @return Are the results bit-exact?
+  */
+  static bool selfTest();
+};
+
+#endif //__YCbCrConversions_h_
@@ -0,0 +1,27 @@
+/**
+ * @file Math/Common.cpp
+ *
+ * Implementation of the random number generator declared in Common.h.
+ */
+
+#include "Common.h"
+#include "Platform/SystemCall.h"
+
+/** The state of the random number generator of the current process. Never 0. */
+PROCESS_WIDE_STORAGE_STATIC unsigned randomState = 2463534242u;
+
+void randomSeed(unsigned seed)
+{
+  randomState = seed ? seed : 2463534242u;
+}
+
+int randomInt()
+{
+  // xorshift32 (Marsaglia, 2003)
+  unsigned x = randomState;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  randomState = x;
+  return (int) (x & RAND_MAX);
+}
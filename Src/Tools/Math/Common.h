@@ -86,11 +86,26 @@ inline double normalize(double data)
   return ndata;
 }
 
+/**
+* The function seeds the random number generator of the current process.
+* Each process has a generator of its own, so the random numbers a process
+* draws do not depend on the other processes.
+* @param seed The seed.
+*/
+void randomSeed(unsigned seed);
+
+/**
+* The function returns a random integer number in the range of [0..RAND_MAX].
+* It replaces rand() and uses the generator of the current process.
+* @return The random number.
+*/
+int randomInt();
+
 /**
 * The function returns a random number in the range of [0..1].
 * @return The random number.
 */
-inline double randomDouble() {return double(rand()) / RAND_MAX;}
+inline double randomDouble() {return double(randomInt()) / RAND_MAX;}
 
 /**
 * The function returns a random integer number in the range of [0..n-1].
@@ -109,7 +124,7 @@ const double RAND_MAX_DOUBLE = static_cast<double>(RAND_MAX);
 */
 inline int randomFast(int n)
 {
-  return static_cast<int>((rand()*n) / RAND_MAX_DOUBLE);
+  return static_cast<int>((randomInt()*n) / RAND_MAX_DOUBLE);
 }
 
 /**
@@ -132,4 +147,14 @@ inline double roundNumber(double d)
   return floor(d+0.5);
 }
 
+/**
+* Round to the next short integer, saturating at the limits of its range
+* @param d A number
+* @return The number as short integer
+*/
+inline short roundNumberToShort(double d)
+{
+  return d >= 32767.0 ? 32767 : d <= -32768.0 ? -32768 : static_cast<short>(floor(d+0.5));
+}
+
 #endif // __Math_Common_h__
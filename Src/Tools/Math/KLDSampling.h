@@ -0,0 +1,80 @@
+/**
+* @file KLDSampling.h
+*
+* Definition of class KLDSampling
+*/
+
+#ifndef __KLDSampling_h_
+#define __KLDSampling_h_
+
+#include <vector>
+#include <cmath>
+
+/**
+* @class KLDSampling
+* The class determines the number of samples a particle filter requires
+* to approximate its posterior with a given accuracy (Fox, 2003).
+* The samples are sorted into bins of a grid covering the state space.
+* The number of bins occupied determines how many samples are needed, so
+* that the Kullback-Leibler distance between the sample-based approximation
+* and the true posterior does not exceed epsilon with probability 1 - delta.
+*/
+class KLDSampling
+{
+public:
+  /** Default constructor. */
+  KLDSampling() : numberOfOccupiedBins(0) {}
+
+  /**
+  * The method removes all samples from the bins.
+  * @param numberOfBins The number of bins of the grid.
+  */
+  void clear(int numberOfBins)
+  {
+    occupied.assign(numberOfBins, 0);
+    numberOfOccupiedBins = 0;
+  }
+
+  /**
+  * The method adds a sample to a bin.
+  * @param bin The index of the bin the sample falls into. 0 <= bin < numberOfBins.
+  */
+  void add(int bin)
+  {
+    if(!occupied[bin])
+    {
+      occupied[bin] = 1;
+      ++numberOfOccupiedBins;
+    }
+  }
+
+  /**
+  * The method returns the number of bins that contain at least one sample.
+  * @return The number of occupied bins.
+  */
+  int getNumberOfOccupiedBins() const {return numberOfOccupiedBins;}
+
+  /**
+  * The method returns the number of samples required for the bins occupied.
+  * It uses the Wilson-Hilferty approximation of the chi-square quantile.
+  * @param epsilon The maximum Kullback-Leibler distance.
+  * @param z The upper 1 - delta quantile of the standard normal distribution,
+  *          e.g. 2.33 for delta = 0.01.
+  * @return The number of samples. It is 0 if less than two bins are occupied.
+  */
+  int getNumberOfSamples(double epsilon, double z) const
+  {
+    if(numberOfOccupiedBins < 2)
+      return 0;
+    const double k1 = numberOfOccupiedBins - 1,
+                 a = 2.0 / (9.0 * k1),
+                 b = 1.0 - a + sqrt(a) * z;
+    return int(ceil(k1 / (2.0 * epsilon) * b * b * b));
+  }
+
+private:
+  std::vector<unsigned char> occupied; /**< For each bin: Does it contain a sample? */
+  int numberOfOccupiedBins; /**< The number of bins that contain at least one sample. */
+};
+
+#endif //__KLDSampling_h_
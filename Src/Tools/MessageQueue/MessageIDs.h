@@ -58,6 +58,7 @@ enum MessageID
   idRobotHealth,
   idMotionRequest,
   idTeamMateGoalPercept,
+  idModuleTimings,
   // insert new team comm ids here
 
   // infrastructure
@@ -135,6 +136,7 @@ static const char* getMessageIDName(MessageID id)
   case idNTPResponse: return "NTPResponse";
   case idReleaseOptions: return "ReleaseOptions";
   case idStopwatch: return "Stopwatch";
+  case idModuleTimings: return "ModuleTimings";
   case idTeamMateBallModel: return "TeamMateBallModel";
   case idTeamMateRobotPose: return "TeamMateRobotPose";
   case idTeamMateBehaviorData: return "TeamMateBehaviorData";
@@ -13,7 +13,7 @@
 
 void MessageQueue::handleAllMessages(MessageHandler& handler)
 {
-  for(int i = 0; i < queue.numberOfMessages; ++i)
+  for(int i = 0; i < (int) queue.messages.size(); ++i)
   {
     queue.setSelectedMessageForReading(i);
     in.config.reset();
@@ -24,17 +24,25 @@ void MessageQueue::handleAllMessages(MessageHandler& handler)
 
 void MessageQueue::copyAllMessages(MessageQueue& other)
 {
-  char* dest = other.queue.reserve(queue.usedSize - MessageQueueBase::headerSize);
-  if(dest)
-  {
-    memcpy(dest - MessageQueueBase::headerSize, queue.buf, queue.usedSize);
-    other.queue.numberOfMessages += queue.numberOfMessages;
-    other.queue.usedSize += queue.usedSize;
-    other.queue.writePosition = 0;
-  }
-  else // Not all messages fit in there, so try step by step (some will be missing).
-    for(int i = 0; i < queue.numberOfMessages; ++i)
-      copyMessage(i, other);
+  // Each chunk contains a sequence of complete messages, so it can be copied as a whole.
+  int message = 0;
+  for(std::vector<MessageQueueBase::Chunk>::const_iterator i = queue.chunks.begin(); i != queue.chunks.end(); ++i)
+    if(i->used)
+    {
+      int next = message;
+      while(next < (int) queue.messages.size() && queue.messages[next] >= i->data && queue.messages[next] < i->data + i->used)
+        ++next;
+      char* dest = other.queue.reserve(i->used - MessageQueueBase::headerSize);
+      if(dest)
+      {
+        memcpy(dest - MessageQueueBase::headerSize, i->data, i->used);
+        other.queue.finishMessages(i->used);
+      }
+      else // Not all messages fit in there, so try step by step (some will be missing).
+        for(int j = message; j < next; ++j)
+          copyMessage(j, other);
+      message = next;
+    }
 }
 
 void MessageQueue::moveAllMessages(MessageQueue& other)
@@ -43,17 +51,85 @@ void MessageQueue::moveAllMessages(MessageQueue& other)
   clear();
 }
 
-void MessageQueue::copyMessage(int message, MessageQueue& other)
+void MessageQueue::copyAllMessages(OutMessage& out)
+{
+  for(int i = 0; i < (int) queue.messages.size(); ++i)
+    copyMessage(i, out);
+}
+
+int MessageQueue::writeCompact(char* buffer, int size) const
+{
+  char* p = buffer;
+  for(std::vector<char*>::const_iterator i = queue.messages.begin(); i != queue.messages.end(); ++i)
+  {
+    const int messageSize = MessageQueueBase::getMessageSize(*i);
+    const int headerSize = messageSize < 0x80 ? 2 : 3;
+    if(messageSize >= 0x8000 || p + headerSize + messageSize > buffer + size)
+      break;
+    *p++ = **i;
+    if(messageSize >= 0x80)
+      *p++ = (char) (0x80 | messageSize >> 8);
+    *p++ = (char) messageSize;
+    memcpy(p, *i + MessageQueueBase::headerSize, messageSize);
+    p += messageSize;
+  }
+  return int(p - buffer);
+}
+
+bool MessageQueue::isValidCompact(const char* buffer, int size)
+{
+  const unsigned char* p = (const unsigned char*) buffer;
+  const unsigned char* end = p + size;
+  while(p < end)
+  {
+    if(end - p < 2 || (p[1] & 0x80 && end - p < 3) || *p >= numOfMessageIDs)
+      return false;
+    ++p;
+    int messageSize = *p++;
+    if(messageSize & 0x80)
+      messageSize = (messageSize & 0x7f) << 8 | *p++;
+    if(end - p < messageSize)
+      return false;
+    p += messageSize;
+  }
+  return true;
+}
+
+bool MessageQueue::appendCompact(const char* buffer, int size)
+{
+  if(!isValidCompact(buffer, size))
+    return false;
+
+  const unsigned char* p = (const unsigned char*) buffer;
+  const unsigned char* end = p + size;
+  while(p < end)
+  {
+    const unsigned char id = *p++;
+    int messageSize = *p++;
+    if(messageSize & 0x80)
+      messageSize = (messageSize & 0x7f) << 8 | *p++;
+    char* dest = queue.reserve(messageSize);
+    if(dest)
+    {
+      memcpy(dest, p, messageSize);
+      out.finishMessage(MessageID(id));
+    }
+    p += messageSize;
+  }
+  return true;
+}
+
+void MessageQueue::copyMessage(int message, OutMessage& out)
 {
   queue.setSelectedMessageForReading(message);
-  other.out.bin.write(queue.getData(), queue.getMessageSize());
-  other.out.finishMessage(queue.getMessageID());
+  out.bin.write(queue.getData(), queue.getMessageSize());
+  out.finishMessage(queue.getMessageID());
 }
 
 void MessageQueue::write(Out& stream) const
 {
-  stream << queue.usedSize << queue.numberOfMessages;
-  stream.write(queue.buf, queue.usedSize);
+  stream << (int) queue.usedSize << (int) queue.messages.size();
+  append(stream);
 }
 
 void MessageQueue::writeAppendableHeader(Out& stream) const
@@ -63,7 +139,9 @@ void MessageQueue::writeAppendableHeader(Out& stream) const
 
 void MessageQueue::append(Out& stream) const
 {
-  stream.write(queue.buf, queue.usedSize);
+  for(std::vector<MessageQueueBase::Chunk>::const_iterator i = queue.chunks.begin(); i != queue.chunks.end(); ++i)
+    if(i->used)
+      stream.write(i->data, i->used);
 }
 
 void MessageQueue::append(In& stream)
@@ -72,13 +150,11 @@ void MessageQueue::append(In& stream)
       numberOfMessages;
   stream >> usedSize >> numberOfMessages;
   // Trying a direct copy. This is hacked, but fast.
-  char* dest = numberOfMessages == -1 ? 0 : queue.reserve(usedSize - MessageQueueBase::headerSize);
+  char* dest = numberOfMessages == -1 || usedSize <= 0 ? 0 : queue.reserve(usedSize - MessageQueueBase::headerSize);
   if(dest)
   {
     stream.read(dest - MessageQueueBase::headerSize, usedSize);
-    queue.numberOfMessages += numberOfMessages;
-    queue.usedSize += usedSize;
-    queue.writePosition = 0;
+    queue.finishMessages(usedSize);
   }
   else // Not all messages fit in there, so try step by step (some will be missing).
     for(int i = 0; (numberOfMessages == -1 && !stream.eof()) || i < numberOfMessages; ++i)
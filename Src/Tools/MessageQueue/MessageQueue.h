@@ -99,13 +99,13 @@ public:
   * The method returns whether the queue is empty. 
   * @return Aren't there any messages in the queue?
   */
-  bool isEmpty() const {return queue.numberOfMessages == 0;}
+  bool isEmpty() const {return queue.messages.empty();}
 
   /**
   * The method returns the number of messages in the queue.
   * @return The number of messages.
   */
-  int getNumberOfMessages() const {return queue.numberOfMessages;}
+  int getNumberOfMessages() const {return (int) queue.messages.size();}
 
   /**
   * The method removes a message from the queue.
@@ -130,13 +130,56 @@ public:
   */
   void append(Out& stream) const;
 
+  /**
+  * The method copies all messages to an outgoing message stream, e.g. the one of
+  * another queue.
+  * @param out The stream the messages are written to.
+  */
+  void copyAllMessages(OutMessage& out);
+
+  /**
+  * The method writes the messages in the compact format used for team communication.
+  * Each message is preceded by its id and its size. The size takes one byte if it
+  * is less than 128 and two bytes otherwise. Messages are written in their sequence
+  * until the next one does not fit into the memory.
+  * @param buffer The memory the messages are written to.
+  * @param size The number of bytes available.
+  * @return The number of bytes written.
+  */
+  int writeCompact(char* buffer, int size) const;
+
+  /**
+  * The method checks whether memory contains only complete messages in the
+  * compact format with valid ids.
+  * @param buffer The memory the messages are read from.
+  * @param size The number of bytes in the memory.
+  * @return Is the memory valid?
+  */
+  static bool isValidCompact(const char* buffer, int size);
+
+  /**
+  * The method appends messages in the compact format to the queue.
+  * Nothing is appended if the memory is not valid.
+  * @param buffer The memory the messages are read from.
+  * @param size The number of bytes in the memory.
+  * @return Was the memory valid?
+  */
+  bool appendCompact(const char* buffer, int size);
+
 protected:
   /**
   * The method copies a single message to another queue.
   * @param message The number of the message.
   * @param other The other queue.
   */
-  void copyMessage(int message, MessageQueue& other);
+  void copyMessage(int message, MessageQueue& other) {copyMessage(message, other.out);}
+
+  /**
+  * The method copies a single message to an outgoing message stream.
+  * @param message The number of the message.
+  * @param out The stream the message is written to.
+  */
+  void copyMessage(int message, OutMessage& out);
 
   /**
   * The method write the message queue to a stream.
@@ -10,99 +10,164 @@
 #include <string.h>
 
 MessageQueueBase::MessageQueueBase()
-: buf(0),
+: currentChunk(0),
 #ifndef TARGET_ROBOT
-  maximumSize(0x4000000), // 64 MB
-  reservedSize(16384)
-{
-  buf = (char*) malloc(reservedSize);
-  ASSERT(buf);
+  maximumSize(0x4000000) // 64 MB
 #else
   maximumSize(0)
-{
 #endif
+{
   clear();
 }
 
+MessageQueueBase::~MessageQueueBase()
+{
+  for(std::vector<Chunk>::iterator i = chunks.begin(); i != chunks.end(); ++i)
+    free(i->data);
+}
+
 void MessageQueueBase::setSize(size_t size)
 {
 #ifdef TARGET_ROBOT
-  ASSERT(!buf);
-  buf = (char*) malloc(size);
-  ASSERT(buf);
+  ASSERT(chunks.empty());
+  chunks.push_back(Chunk(size));
+  ASSERT(chunks[0].data);
+  messages.reserve(size / 256); // a guess that avoids growing the index in most cases
 #else
   ASSERT(size >= usedSize);
-  if(size < reservedSize)
-  {
-    char* newBuf = (char*) realloc(buf, size);
-    if(newBuf)
-    {
-      buf = newBuf;
-      reservedSize = size;
-    }
-  }
 #endif
   maximumSize = size;
 }
 
 void MessageQueueBase::clear()
 {
+  // all memory remains allocated for the next messages
+  for(std::vector<Chunk>::iterator i = chunks.begin(); i != chunks.end(); ++i)
+    i->used = 0;
+  currentChunk = 0;
+  messages.clear();
   usedSize = 0;
-  numberOfMessages = 0;
   writePosition = 0;
   writingOfLastMessageFailed = false;
-  selectedMessageForReadingPosition = 0;
+  selectedMessage = 0;
   readPosition = 0;
   lastMessage = 0;
 }
 
 void MessageQueueBase::removeMessage(int message)
 {
-  selectedMessageForReadingPosition = 0;
-  int i;
-  for(i = 0; i < message; ++i)
-    selectedMessageForReadingPosition += getMessageSize() + headerSize;
-  usedSize = selectedMessageForReadingPosition;
-  for(++i; i < numberOfMessages; ++i)
-  {
-    int mlength = getMessageSize() + headerSize;
-    selectedMessageForReadingPosition += mlength;
-    memcpy(buf + usedSize, buf + selectedMessageForReadingPosition, mlength);
-    usedSize = selectedMessageForReadingPosition;
-  }
+  ASSERT(message >= 0);
+  ASSERT(message < (int) messages.size());
+
+  char* m = messages[message];
+  Chunk& chunk = getChunk(m);
+  const size_t size = headerSize + getMessageSize(m);
+  char* end = chunk.data + chunk.used;
+
+  // move the messages behind the removed one in the same chunk, including the one currently written
+  size_t bytesBehind = end - m - size;
+  if(&chunk == &chunks[currentChunk] && writePosition)
+    bytesBehind += headerSize + writePosition;
+  memmove(m, m + size, bytesBehind);
+  chunk.used -= size;
+  usedSize -= size;
+
+  messages.erase(messages.begin() + message);
+  for(std::vector<char*>::iterator i = messages.begin() + message; i != messages.end() && *i > m && *i < end; ++i)
+    *i -= size;
+
   readPosition = 0;
-  --numberOfMessages;
-  selectedMessageForReadingPosition = 0;
+  selectedMessage = messages.empty() ? 0 : messages[0];
   lastMessage = 0;
 }
 
 char* MessageQueueBase::reserve(size_t size)
 {
-  if(usedSize + headerSize + writePosition + size > maximumSize)
+  const size_t required = headerSize + writePosition + size;
+  if(usedSize + required > maximumSize ||
+     ((chunks.empty() || chunks[currentChunk].used + required > chunks[currentChunk].size) && !nextChunk(required)))
     return 0;
   else
   {
-#ifndef TARGET_ROBOT
-    size_t r = reservedSize;
-    while(usedSize + headerSize + writePosition + size >= r)
-      r *= 2;
-    if(r > maximumSize)
-      r = maximumSize;
-    char* newBuf = (char*) realloc(buf, r);
-    if(newBuf)
+    Chunk& chunk = chunks[currentChunk];
+    writePosition += size;
+    return chunk.data + chunk.used + headerSize + writePosition - size;
+  }
+}
+
+bool MessageQueueBase::nextChunk(size_t required)
+{
+#ifdef TARGET_ROBOT
+  return false; // the only chunk was allocated by setSize()
+#else
+  int next = chunks.empty() ? 0 : currentChunk + 1;
+
+  // chunks remaining from before the queue was cleared are reused if they are big enough
+  while(next < (int) chunks.size() && chunks[next].size < required)
+    ++next;
+
+  if(next == (int) chunks.size())
+  {
+    size_t size = chunks.empty() ? (size_t) minChunkSize : chunks.back().size * 2;
+    if(size > (size_t) maxChunkSize)
+      size = maxChunkSize;
+    if(size > maximumSize)
+      size = maximumSize;
+    if(size < required)
+      size = required;
+    Chunk chunk(size);
+    if(!chunk.data)
     {
-      buf = newBuf;
-      reservedSize = r;
+      maximumSize = usedSize;
+      return false;
     }
-    else
+    chunks.push_back(chunk);
+  }
+
+  if(writePosition) // move the part of the current message that was already written
+  {
+    const Chunk& current = chunks[currentChunk];
+    memcpy(chunks[next].data + headerSize, current.data + current.used + headerSize, writePosition);
+  }
+  currentChunk = next;
+  return true;
+#endif
+}
+
+MessageQueueBase::Chunk& MessageQueueBase::getChunk(const char* message)
+{
+  for(int i = currentChunk; i > 0; --i)
+    if(message >= chunks[i].data && message < chunks[i].data + chunks[i].used)
+      return chunks[i];
+  return chunks[0];
+}
+
+void MessageQueueBase::compact()
+{
+  // The index is sorted by chunks, so all chunks can be processed in a single pass.
+  std::vector<char*>::iterator m = messages.begin();
+  usedSize = 0;
+  for(int i = 0; i < (int) chunks.size(); ++i)
+  {
+    Chunk& chunk = chunks[i];
+    char* dest = chunk.data;
+    const char* end = chunk.data + chunk.used;
+    for(; m != messages.end() && *m >= chunk.data && *m < end; ++m)
     {
-      maximumSize = reservedSize;
-      return 0;
+      const size_t size = headerSize + getMessageSize(*m);
+      if(*m != dest)
+      {
+        memmove(dest, *m, size);
+        *m = dest;
+      }
+      dest += size;
     }
-#endif
-    writePosition += size;
-    return buf + usedSize + headerSize + writePosition - size;
+    if(i == currentChunk && writePosition) // the message currently written follows the finished ones
+      memmove(dest, end, headerSize + writePosition);
+    chunk.used = dest - chunk.data;
+    usedSize += chunk.used;
   }
+  ASSERT(m == messages.end());
 }
 
 void MessageQueueBase::write(const void* p, int size)
@@ -122,15 +187,34 @@ void MessageQueueBase::finishMessage(MessageID id)
   if (!writingOfLastMessageFailed)
   {
     ASSERT(writePosition > 0);
-    memcpy(buf + usedSize, (char*)&id, 1); // write the id of the message
-    memcpy(buf + usedSize + 1, &writePosition, 3); // write the size of the message
-    ++numberOfMessages;
+    Chunk& chunk = chunks[currentChunk];
+    char* message = chunk.data + chunk.used;
+    memcpy(message, (char*)&id, 1); // write the id of the message
+    memcpy(message + 1, &writePosition, 3); // write the size of the message
+    messages.push_back(message);
+    if(!selectedMessage) // as before, the first message is selected by default
+      selectedMessage = message;
+    chunk.used += writePosition + headerSize;
     usedSize += writePosition + headerSize;
   }
   writePosition = 0;
   writingOfLastMessageFailed = false;
 }
 
+void MessageQueueBase::finishMessages(size_t size)
+{
+  ASSERT(writePosition + headerSize == size);
+  Chunk& chunk = chunks[currentChunk];
+  char* end = chunk.data + chunk.used + size;
+  if(!selectedMessage)
+    selectedMessage = chunk.data + chunk.used;
+  for(char* m = chunk.data + chunk.used; m < end; m += headerSize + getMessageSize(m))
+    messages.push_back(m);
+  chunk.used += size;
+  usedSize += size;
+  writePosition = 0;
+}
+
 void MessageQueueBase::removeRepetitions()
 {
   unsigned short messagesPerType[5][numOfMessageIDs];
@@ -140,10 +224,10 @@ void MessageQueueBase::removeRepetitions()
 
   memset(messagesPerType, 0, sizeof(messagesPerType));
   memset(processes, 255, sizeof(processes));
-  selectedMessageForReadingPosition = 0;
 
-  for(int i = 0; i < numberOfMessages; ++i)
+  for(int i = 0; i < (int) messages.size(); ++i)
   {
+    selectedMessage = messages[i];
     if(getMessageID() == idProcessBegin)
     {
       unsigned char process = getData()[0] - 'a';
@@ -152,18 +236,15 @@ void MessageQueueBase::removeRepetitions()
       currentProcess = processes[process];
     }
     ++messagesPerType[currentProcess][getMessageID()];
-    selectedMessageForReadingPosition += getMessageSize() + headerSize;
   }
 
-  selectedMessageForReadingPosition = 0;
-  usedSize = 0;
-  int numOfDeleted = 0;
+  int numOfKept = 0;
   int frameBegin = -1;
   bool frameEmpty = true;
 
-  for(int i = 0; i < numberOfMessages; ++i)
+  for(int i = 0; i < (int) messages.size(); ++i)
   {
-    int mlength = getMessageSize() + headerSize;
+    selectedMessage = messages[i];
     bool copy;
     switch(getMessageID())
     {
@@ -195,10 +276,7 @@ void MessageQueueBase::removeRepetitions()
     // always accept, but may be reverted later
     case idProcessBegin:
       if(frameBegin != -1) // nothing between last idProcessBegin and this one, so remove idProcessBegin as well
-      {
-        usedSize = frameBegin;
-        ++numOfDeleted;
-      }
+        numOfKept = frameBegin;
       currentProcess = processes[getData()[0] - 'a'];
       copy = true;
       break;
@@ -222,7 +300,7 @@ void MessageQueueBase::removeRepetitions()
       // So idProcessBegin idProcessFinished+ will be removed.
       if(getMessageID() == idProcessBegin) // remember begin of frame
       {
-        frameBegin = usedSize;
+        frameBegin = numOfKept;
         frameEmpty = true; // assume next frame as empty
       }
       else if(getMessageID() == idProcessFinished)
@@ -233,38 +311,22 @@ void MessageQueueBase::removeRepetitions()
         frameEmpty = false;
       }
 
-      //this message is important, it shall be copied
-      if(usedSize != selectedMessageForReadingPosition)
-        memcpy(buf + usedSize, buf + selectedMessageForReadingPosition, mlength);
-      usedSize += mlength;
+      //this message is important, it shall be kept
+      messages[numOfKept++] = messages[i];
     }
-    else
-      ++numOfDeleted;
-    selectedMessageForReadingPosition += mlength;
   }
-  numberOfMessages -= numOfDeleted;
+  messages.resize(numOfKept);
+  compact();
   readPosition = 0;
-  selectedMessageForReadingPosition = 0;
+  selectedMessage = messages.empty() ? 0 : messages[0];
   lastMessage = 0;
 }
 
 void MessageQueueBase::setSelectedMessageForReading(int message)
 {
   ASSERT(message >= 0);
-  ASSERT(message < numberOfMessages);
-
-  int m = message;
-  if(m >= lastMessage)
-  {
-    ASSERT(lastMessage < numberOfMessages);
-    m -= lastMessage;
-  }
-  else
-    selectedMessageForReadingPosition = 0;
-
-  for (int i = 0; i < m; ++i)
-    selectedMessageForReadingPosition += getMessageSize() + headerSize;
-
+  ASSERT(message < (int) messages.size());
+  selectedMessage = messages[message];
   readPosition = 0;
   lastMessage = message;
 }
@@ -272,13 +334,6 @@ void MessageQueueBase::setSelectedMessageForReading(int message)
 void MessageQueueBase::read(void* p, int size)
 {
   ASSERT(readPosition + size <= getMessageSize());
-  memcpy(p, buf + selectedMessageForReadingPosition + headerSize + readPosition, size);
+  memcpy(p, selectedMessage + headerSize + readPosition, size);
   readPosition += size;
 } 
-
-int MessageQueueBase::getMessageSize() const
-{
-  int size = 0;
-  memcpy(&size, buf + selectedMessageForReadingPosition + 1, 3);
-  return size;
-}
@@ -10,14 +10,21 @@
 
 #include "MessageIDs.h"
 #include <stdlib.h>
+#include <vector>
+#include <string.h>
 
 class MessageQueueBase;
 
 /**
 * @class MessageQueueBase 
 * The class performs the memory management for the class MessageQueue.
-* On Windows, the queue will grow when needed, on the robot, it will remain constant at
-* the size defined by setSize() and reject further messages.
+* The messages are stored in chunks of memory. A message never crosses the border of
+* a chunk, and finished messages are never moved when further messages are added.
+* An index contains the address of each message, so selecting a message for reading
+* takes constant time. Clearing the queue keeps all memory allocated, so a queue that
+* is cleared every frame does not allocate memory anymore after a few frames.
+* On Windows, the queue will grow by adding chunks when needed, on the robot, it consists
+* of a single chunk of the size defined by setSize() and rejects further messages.
 */
 class MessageQueueBase
 {
@@ -30,10 +37,11 @@ public:
   /**
   * Destructor.
   */
-  ~MessageQueueBase() {if(buf) free(buf);}
+  ~MessageQueueBase();
 
   /**
-  * Sets the size of the queue. Ignored on the Win32 platform.
+  * Sets the size of the queue. On the robot, the memory is allocated here.
+  * On Windows, it only limits the growth of the queue.
   * @param size The maximum size of the queue in bytes. 
   */
   void setSize(size_t size);
@@ -93,19 +101,19 @@ public:
   * The method gives direct read access to the selected message for reading.
   * @return The address of the first byte of the message
   */
-  const char* getData() const {return buf + selectedMessageForReadingPosition + headerSize;}
+  const char* getData() const {return selectedMessage + headerSize;}
 
   /**
   * The method returns the message id of the currently selected message for reading.
   * @return The message id.
   */
-  MessageID getMessageID() const {return MessageID(buf[selectedMessageForReadingPosition]);}
+  MessageID getMessageID() const {return MessageID(*selectedMessage);}
 
   /** 
   * The method returns the message size of the currently selected message for reading.
   * @return The size in bytes.
   */
-  int getMessageSize() const;
+  int getMessageSize() const {return getMessageSize(selectedMessage);}
 
   /** 
   * The method resets read position of the currently selected message for reading
@@ -133,17 +141,80 @@ public:
   void removeRepetitions();
 
 private:
-  enum {headerSize = 4}; /**< The size of the header of each message in bytes. */
-  char* buf; /**< The buffer on that the queue works. */
-  size_t selectedMessageForReadingPosition; /**< The position of the message that is selected for reading. */
+  /**
+  * The class represents a block of memory messages are stored in. The bytes used
+  * always contain a sequence of complete messages without gaps.
+  */
+  class Chunk
+  {
+  public:
+    char* data; /**< The memory of the chunk. */
+    size_t size; /**< The size of the chunk in bytes. */
+    size_t used; /**< The number of bytes occupied by finished messages. */
+
+    /**
+    * Constructor.
+    * @param size The size of the chunk in bytes.
+    */
+    Chunk(size_t size) : data((char*) malloc(size)), size(size), used(0) {}
+  };
+
+  enum 
+  {
+    headerSize = 4, /**< The size of the header of each message in bytes. */
+    minChunkSize = 16384, /**< The size of the first chunk on Windows. */
+    maxChunkSize = 0x1000000 /**< Chunks do not grow beyond this size, unless a single message is bigger. */
+  };
+  std::vector<Chunk> chunks; /**< The chunks in the sequence they are filled. */
+  int currentChunk; /**< The chunk the next message is written to. */
+  std::vector<char*> messages; /**< The index: the address of the header of each message in the sequence they were added. */
+  const char* selectedMessage; /**< The address of the message that is selected for reading. */
   size_t maximumSize; /**< The maximum queue size (in bytes). */
-  size_t reservedSize; /**< The queue size reserved (in bytes). */
-  size_t usedSize; /** The queue size used (in bytes). It is also the position where the next message starts. */
+  size_t usedSize; /** The size of all messages stored (in bytes). */
   size_t writePosition; /**< The current size of the next message. */
   bool writingOfLastMessageFailed; /**< If true, then the writing of the last message failed because there was not enough space. */
   int readPosition; /**< The position up to where a message is already read. */
   int lastMessage; /**< Cache the current message in the message queue. */
-  int numberOfMessages; /**< The number of messages stored. */
+
+  /**
+  * The method returns the size of a message.
+  * @param message The address of the header of the message.
+  * @return The size in bytes without the header.
+  */
+  static int getMessageSize(const char* message)
+  {
+    int size = 0;
+    memcpy(&size, message + 1, 3);
+    return size;
+  }
+
+  /**
+  * The method switches to a chunk that can hold a message of a certain size.
+  * The part of the current message already written is moved to the new chunk.
+  * @param required The number of bytes required including the header.
+  * @return Could such a chunk be provided?
+  */
+  bool nextChunk(size_t required);
+
+  /**
+  * The method determines the chunk a message is stored in.
+  * @param message The address of the header of the message.
+  * @return The chunk.
+  */
+  Chunk& getChunk(const char* message);
+
+  /**
+  * The method moves all messages in the index to the beginning of their chunks.
+  * It must be called after messages were removed from the index.
+  */
+  void compact();
+
+  /**
+  * The method adds a block of complete messages including their headers to the index.
+  * The block must have been written to the address returned by reserve(size - headerSize).
+  * @param size The size of the block in bytes.
+  */
+  void finishMessages(size_t size);
 
   friend class MessageQueue;
 };
@@ -12,6 +12,12 @@ void Requirements::add(const char* name, void (*create)(),void (*free)(), void (
     entries.push_back(Entry(name, create, free, in));
 }
 
+void Usages::add(const char* name)
+{
+  if(record)
+    entries.push_back(name);
+}
+
 void Representations::add(const char* name, void (*update)(Blackboard&), void (*create)(),void (*free)(), void (*out)(Out&))
 {
   if(record)
@@ -33,6 +39,8 @@ void Representations::add(const char* name, void (*update)(Blackboard&), void (*
 
 std::list<Requirements::Entry> Requirements::entries FIRST;
 bool Requirements::record = 0;
+std::list<const char*> Usages::entries FIRST;
+bool Usages::record = 0;
 std::list<Representations::Entry> Representations::entries FIRST;
 bool Representations::record;
 std::list<ModuleBase*> ModuleBase::modules FIRST;
@@ -127,6 +127,45 @@ public:
   void operator=(const Requirement&) {add(getName(), create, free, in);}
 };
 
+/**
+* @class Usages
+* The class collects all usages of a certain module, i.e. the representations
+* that are accessed, but do not have to be updated before the module is executed.
+* Its contents are only temporary and will be created and deleted for
+* each module.
+*/
+class Usages
+{
+public:
+  typedef std::list<const char*> List; /**< Type of the list of all usages. */
+  static List entries; /**< The list of all usages. */
+  static bool record; /**< A flag that determines whether usages are currently recorded or not. */
+
+protected:
+  /**
+  * The method adds a new usage to the list but only if the class
+  * is currently in recording mode.
+  * @param name The name of the representation used.
+  */
+  void add(const char* name);
+};
+
+/**
+* @class Usage
+* The class adds a single usage to the list of usages.
+* It uses the same assignment trick as the class Requirement.
+* @param getName A function which returns the name of the representation.
+*/
+template<const char* (*getName)()> class Usage : private Usages
+{
+public:
+  /**
+  * The assignment operator add the name of the template parameter
+  * as a usage.
+  */
+  void operator=(const Usage&) {add(getName());}
+};
+
 /**
 * @class Representations
 * The class collects all representations a certain module provides.
@@ -229,6 +268,7 @@ private:
 
 protected:
   Requirements::List requirements; /**< The list of all requirements of the module created by this instance. */
+  Usages::List usages; /**< The list of all representations used by the module created by this instance. */
   Representations::List representations; /**< The list of all representations provided by the module created by this instance. */
 
   /**
@@ -292,12 +332,14 @@ public:
   {
     Representations::entries.clear();
     Requirements::entries.clear();
-    Representations::record = Requirements::record = true;
+    Usages::entries.clear();
+    Representations::record = Requirements::record = Usages::record = true;
     char buf[sizeof(B)];
     // executes assignment operators -> recording information!
     (B&) *buf = (const B&) *buf;
-    Representations::record = Requirements::record = false;
+    Representations::record = Requirements::record = Usages::record = false;
     requirements = Requirements::entries;
+    usages = Usages::entries;
     representations = Representations::entries;
   }
 }; 
@@ -388,7 +430,15 @@ public:
 * @param representation The representation that is used.
 */
 #define USES(representation) \
-  protected: using Blackboard::the##representation;
+  protected: using Blackboard::the##representation; \
+  \
+  private: \
+  /** \
+  * The method returns the name of the representation. \
+  */ \
+  static const char* getName3##representation() {return #representation;}\
+  \
+  Usage<&_Me::getName3##representation> y##representation;
 
 /**
 * The macro defines a representation that is updated by this module.
@@ -5,8 +5,10 @@
 */
 
 #include "ModuleManager.h"
+#include "ParallelExecutor.h"
 #include "Platform/GTAssert.h"
 #include "Tools/Settings.h"
+#include "Tools/Debugging/ReleaseOptions.h"
 #include "Tools/Streams/InStreams.h"
 #include <algorithm>
 
@@ -28,7 +30,9 @@ void DefaultModule::setRepresentations(const std::list<ModuleManager::ModuleStat
 
 ModuleManager::ModuleManager() :
 timeStamp(0),
-defaultModule(new DefaultModule)
+defaultModule(new DefaultModule),
+numOfThreads(1),
+executor(0)
 {
   for(std::list<ModuleBase*>::iterator i = ModuleBase::modules.begin(); i != ModuleBase::modules.end(); ++i)
     modules.push_back(ModuleState(*i));
@@ -38,7 +42,10 @@ defaultModule(new DefaultModule)
 
 ModuleManager::ModuleManager(const std::string& process) :
 timeStamp(0),
-defaultModule(new DefaultModule)
+defaultModule(new DefaultModule),
+process(process),
+numOfThreads(1),
+executor(0)
 {
   InTextFile stream("Processes/" + process + "Modules.cfg");
   ASSERT(stream.exists());
@@ -70,6 +77,8 @@ void ModuleManager::destroy()
     update(empty); // destruct everything
     delete defaultModule;
     defaultModule = 0;
+    delete executor;
+    executor = 0;
   }
 }
 
@@ -93,12 +102,18 @@ void ModuleManager::update(In& stream, unsigned timeStamp)
   for(std::list<ModuleState>::iterator j = modules.begin(); j != modules.end(); ++j)
     j->required = false;
 
-  // Skip until section [Shared]
+  // Skip until section [Shared], but read the number of threads from section [Execution]
+  int numOfThreads = this->numOfThreads; // keep the current one if not specified
+  bool execution = false;
   while(!stream.eof())
   {
     stream >> representation;
     if(representation == "[Shared]")
       break;
+    else if(representation == "[Execution]")
+      execution = true;
+    else if(execution && representation == process)
+      stream >> numOfThreads;
   }
 
   // read section [Shared]
@@ -278,6 +293,13 @@ void ModuleManager::update(In& stream, unsigned timeStamp)
     if(j->required && !j->instance)
       j->instance = j->module->createNew();
 
+  this->numOfThreads = numOfThreads;
+  createExecutor();
+
+  timings.clear();
+  for(std::list<Provider>::const_iterator j = providers.begin(); j != providers.end(); ++j)
+    timings.addProvider(j->representation);
+
   this->timeStamp = timeStamp;
 }
 
@@ -346,6 +368,54 @@ bool ModuleManager::sortProviders()
   return true;
 }
 
+void ModuleManager::createExecutor()
+{
+  delete executor;
+  executor = 0;
+
+#ifdef RELEASE // the debugging infrastructure is not thread-safe, so only use multiple threads in release code
+  if(numOfThreads > 1 && !providers.empty())
+  {
+    executor = new ParallelExecutor(numOfThreads);
+    std::list<Provider>::const_iterator i, j;
+    int task = 0;
+    for(i = providers.begin(); i != providers.end(); ++i, ++task)
+    {
+      // Modules of these categories use data that only exists in the thread of the process
+      // (e.g. static instances or the process wide blackboard access). The state of the random
+      // number generator also exists per thread, so the particle filters are pinned as well.
+      const std::string category(i->moduleState->module->category),
+                        name(i->moduleState->module->name);
+      const bool pinned = category == "Infrastructure" || category == "Behavior Control" ||
+                          category == "Motion Control" ||
+                          name == "SelfLocator" || name == "ParticleFilterBallLocator";
+      executor->addTask(i->update, i->moduleState->instance, pinned);
+      int predecessor = 0;
+      for(j = providers.begin(); j != i; ++j, ++predecessor)
+        if(dependsOn(*i, *j))
+          executor->addDependency(predecessor, task);
+    }
+  }
+#endif
+}
+
+bool ModuleManager::dependsOn(const Provider& provider, const Provider& predecessor)
+{
+  return provider.moduleState == predecessor.moduleState || // same module
+         accesses(*provider.moduleState->module, predecessor.representation) || // read after write
+         accesses(*predecessor.moduleState->module, provider.representation); // write after read
+}
+
+bool ModuleManager::accesses(const ModuleBase& module, const std::string& representation)
+{
+  if(std::find(module.requirements.begin(), module.requirements.end(), representation) != module.requirements.end())
+    return true;
+  for(Usages::List::const_iterator i = module.usages.begin(); i != module.usages.end(); ++i)
+    if(representation == *i)
+      return true;
+  return false;
+}
+
 void ModuleManager::load()
 {
   InConfigFile stream(Global::getSettings().expandLocationFilename("modules.cfg"));
@@ -355,10 +425,34 @@ void ModuleManager::load()
 
 void ModuleManager::execute()
 {
-  // Execute all providers in the given sequence
-  for(std::list<Provider>::iterator i = providers.begin(); i != providers.end(); ++i)
-    if(i->moduleState->instance)
-        i->update(*i->moduleState->instance);
+#ifdef RELEASE
+  // Only measure on request, and only in processes that can send the results to the team
+  const bool measure = Global::getReleaseOptions().moduleTimings && Global::hasTeamOut();
+#else
+  const bool measure = true;
+#endif
+
+  if(executor)
+    executor->execute(measure ? &timings : 0);
+  else
+  {
+    // Execute all providers in the given sequence
+    int index = 0;
+    for(std::list<Provider>::iterator i = providers.begin(); i != providers.end(); ++i, ++index)
+      if(i->moduleState->instance)
+      {
+        if(measure)
+        {
+          const unsigned startTime = SystemCall::getUsSystemTime();
+          i->update(*i->moduleState->instance);
+          timings.add(index, SystemCall::getUsSystemTime() - startTime);
+        }
+        else
+          i->update(*i->moduleState->instance);
+      }
+  }
+  if(measure)
+    timings.finishFrame();
   BH_TRACE;
   
   DEBUG_RESPONSE("automated requests:ModuleTable",
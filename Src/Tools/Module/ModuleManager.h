@@ -8,10 +8,12 @@
 #define __ModuleManager_h_
 
 #include "Module.h"
+#include "ModuleTimings.h"
 #include "Tools/Streams/InOut.h"
 #include <map>
 
 class DefaultModule;
+class ParallelExecutor;
 
 /** 
 * @class ModuleManager
@@ -116,12 +118,40 @@ private:
 
   DefaultModule* defaultModule; /**< A module that can provide everything. */
 
+  std::string process; /**< The name of the process. Used to find its entry in the section [Execution]. */
+  int numOfThreads; /**< The number of threads used to execute the providers. */
+  ParallelExecutor* executor; /**< The executor used if more than one thread is used. Otherwise 0. */
+  ModuleTimings timings; /**< The execution times of all providers. */
+
   /**
   * The method brings the providers in the correct sequence.
   * @return Is the set of providers consistent?
   */
   bool sortProviders();
 
+  /**
+  * The method creates the executor for the current sequence of providers if
+  * more than one thread should be used. Otherwise, it deletes it.
+  */
+  void createExecutor();
+
+  /**
+  * The method determines whether a provider must be executed after another one
+  * that precedes it in the sequence of providers.
+  * @param provider The provider.
+  * @param predecessor The provider that precedes it.
+  * @return Does the provider depend on its predecessor?
+  */
+  static bool dependsOn(const Provider& provider, const Provider& predecessor);
+
+  /**
+  * The method determines whether a module accesses a representation it does not provide.
+  * @param module The module.
+  * @param representation The name of the representation.
+  * @return Does the module require or use the representation?
+  */
+  static bool accesses(const ModuleBase& module, const std::string& representation);
+
 public:
   /**
   * Default constructor. Used on the robot.
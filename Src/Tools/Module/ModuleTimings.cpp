@@ -0,0 +1,86 @@
+/**
+* @file ModuleTimings.cpp
+* Implementation of a class that measures the execution times of all providers.
+*/
+
+#include "ModuleTimings.h"
+#include "Tools/Global.h"
+#include "Tools/MessageQueue/OutMessage.h"
+#include <algorithm>
+
+/**
+* The class compares the statistics of two providers by their longest durations.
+*/
+class SlowerThan
+{
+public:
+  bool operator()(const ModuleTimings::Entry& a, const ModuleTimings::Entry& b) const {return a.maxTime > b.maxTime;}
+};
+
+bool ModuleTimings::getStatistics(const Samples& samples, Entry& entry)
+{
+  const int numOfDurations = std::min((int) samples.numOfAdded, (int) numOfSamples);
+  if(!numOfDurations)
+    return false;
+
+  unsigned short durations[numOfSamples];
+  unsigned sum = 0;
+  entry.minTime = 65535;
+  entry.maxTime = 0;
+  for(int i = 0; i < numOfDurations; ++i)
+  {
+    const unsigned short duration = samples.durations[i];
+    durations[i] = duration;
+    sum += duration;
+    if(duration < entry.minTime)
+      entry.minTime = duration;
+    if(duration > entry.maxTime)
+      entry.maxTime = duration;
+  }
+  entry.avgTime = (unsigned short) (sum / numOfDurations);
+  const int p99 = (numOfDurations * 99 + 99) / 100 - 1;
+  std::nth_element(durations, durations + p99, durations + numOfDurations);
+  entry.p99Time = durations[p99];
+  entry.representation = samples.representation;
+  return true;
+}
+
+void ModuleTimings::finishFrame()
+{
+  if(++frameCounter < framesPerMessage)
+    return;
+  frameCounter = 0;
+
+  std::vector<Entry> entries;
+  entries.reserve(samples.size());
+  Entry entry;
+  for(std::vector<Samples>::const_iterator i = samples.begin(); i != samples.end(); ++i)
+    if(getStatistics(*i, entry))
+      entries.push_back(entry);
+
+#ifdef RELEASE
+  // team packets are small, so only send the slowest providers
+  if(entries.size() > (unsigned) maxTeamEntries)
+  {
+    std::partial_sort(entries.begin(), entries.begin() + maxTeamEntries, entries.end(), SlowerThan());
+    entries.resize(maxTeamEntries);
+  }
+  OutMessage& out = Global::getTeamOut();
+#else
+  OutMessage& out = Global::getDebugOut();
+#endif
+  out.bin << (unsigned short) entries.size();
+  for(std::vector<Entry>::const_iterator i = entries.begin(); i != entries.end(); ++i)
+    out.bin << *i;
+  out.finishMessage(idModuleTimings);
+}
+
+Out& operator<<(Out& stream, const ModuleTimings::Entry& entry)
+{
+  return stream << entry.representation << entry.minTime << entry.avgTime << entry.maxTime << entry.p99Time;
+}
+
+In& operator>>(In& stream, ModuleTimings::Entry& entry)
+{
+  return stream >> entry.representation >> entry.minTime >> entry.avgTime >> entry.maxTime >> entry.p99Time;
+}
@@ -0,0 +1,128 @@
+/**
+* @file ModuleTimings.h
+* Declaration of a class that measures the execution times of all providers.
+*/
+
+#ifndef __ModuleTimings_h_
+#define __ModuleTimings_h_
+
+#include "Tools/Streams/InOut.h"
+#include <string>
+#include <vector>
+
+/**
+* @class ModuleTimings
+*
+* The class collects the execution times of all providers of a process. For each
+* provider, the durations of the last frames are kept in a ring buffer. Each buffer
+* is only written by the thread that executes the provider and is only read after
+* all providers were executed, so no locking is required. Every few frames,
+* the minimum, average, maximum, and 99th percentile of each provider are sent
+* as a single message with the id idModuleTimings. In release code, only the
+* slowest providers are sent through team communication.
+*/
+class ModuleTimings
+{
+public:
+  enum
+  {
+    numOfSamples = 128, /**< The number of durations per provider the statistics are computed from. */
+    framesPerMessage = 30, /**< The number of frames between two messages. */
+    maxTeamEntries = 10 /**< The maximum number of providers sent through team communication. */
+  };
+
+  /**
+  * The class represents the statistics of a single provider as they are sent.
+  * All times are in microseconds and are limited to 65535.
+  */
+  class Entry
+  {
+  public:
+    std::string representation; /**< The name of the representation provided. */
+    unsigned short minTime, /**< The shortest duration. */
+                   avgTime, /**< The average duration. */
+                   maxTime, /**< The longest duration. */
+                   p99Time; /**< The duration that 99% of all executions do not exceed. */
+
+    /** Default constructor. */
+    Entry() : minTime(0), avgTime(0), maxTime(0), p99Time(0) {}
+  };
+
+private:
+  /**
+  * The class is the ring buffer of the durations of a single provider.
+  */
+  class Samples
+  {
+  public:
+    std::string representation; /**< The name of the representation provided. */
+    unsigned short durations[numOfSamples]; /**< The ring buffer of durations in microseconds. */
+    volatile int numOfAdded; /**< The number of durations added so far. */
+
+    /**
+    * Constructor.
+    * @param representation The name of the representation provided.
+    */
+    Samples(const std::string& representation) : representation(representation), numOfAdded(0) {}
+  };
+
+  std::vector<Samples> samples; /**< The ring buffers of all providers in their sequential order. */
+  int frameCounter; /**< The number of frames since the last message was sent. */
+
+  /**
+  * The method calculates the statistics of a provider.
+  * @param samples The durations of the provider.
+  * @param entry The statistics are returned to this object.
+  * @return Was the provider executed at all?
+  */
+  static bool getStatistics(const Samples& samples, Entry& entry);
+
+public:
+  /** Constructor. */
+  ModuleTimings() : frameCounter(0) {}
+
+  /** The method removes all providers. */
+  void clear() {samples.clear();}
+
+  /**
+  * The method adds a provider. Providers must be added in their sequential order.
+  * @param representation The name of the representation provided.
+  */
+  void addProvider(const std::string& representation) {samples.push_back(Samples(representation));}
+
+  /**
+  * The method adds a measurement.
+  * @param provider The index of the provider in the sequence of providers.
+  * @param duration The duration of its execution in microseconds.
+  */
+  void add(int provider, unsigned duration)
+  {
+    Samples& s = samples[provider];
+    s.durations[s.numOfAdded % numOfSamples] = (unsigned short) (duration < 65535 ? duration : 65535);
+    s.numOfAdded = s.numOfAdded + 1;
+  }
+
+  /**
+  * The method has to be called after all providers were executed.
+  * It sends the statistics every framesPerMessage frames.
+  */
+  void finishFrame();
+};
+
+/**
+* Streaming operator that writes the statistics of a provider to a stream.
+* @param stream The stream to write on.
+* @param entry The statistics.
+* @return The stream.
+*/
+Out& operator<<(Out& stream, const ModuleTimings::Entry& entry);
+
+/**
+* Streaming operator that reads the statistics of a provider from a stream.
+* @param stream The stream from which is read.
+* @param entry The statistics.
+* @return The stream.
+*/
+In& operator>>(In& stream, ModuleTimings::Entry& entry);
+
+#endif //__ModuleTimings_h_
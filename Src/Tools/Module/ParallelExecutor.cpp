@@ -0,0 +1,269 @@
+/**
+* @file ParallelExecutor.cpp
+* Implementation of a class that executes the providers of a process in parallel.
+*/
+
+#include "ParallelExecutor.h"
+#include "ModuleTimings.h"
+#include "Representations/Blackboard.h"
+#include "Platform/GTAssert.h"
+#include "Platform/SystemCall.h"
+
+ParallelExecutor::Task::Task(void (*update)(Blackboard&), Blackboard* instance, bool pinned) :
+  update(update),
+  instance(instance),
+  pinned(pinned),
+  numOfPredecessors(0),
+  pending(0)
+{
+  teamOut.setSize(1400);
+}
+
+void ParallelExecutor::ReadyQueue::reset(int size)
+{
+  if(size > capacity)
+  {
+    delete [] slots;
+    slots = new int[size];
+    capacity = size;
+  }
+  for(int i = 0; i < size; ++i)
+    slots[i] = 0;
+  head = tail = 0;
+}
+
+void ParallelExecutor::ReadyQueue::push(int task)
+{
+  const int slot = Atomic::add(tail, 1) - 1;
+  ASSERT(slot < capacity);
+  slots[slot] = task + 1;
+}
+
+int ParallelExecutor::ReadyQueue::pop()
+{
+  for(;;)
+  {
+    const int slot = head;
+    if(slot == tail)
+      return -1;
+    const int task = slots[slot];
+    if(!task) // reserved, but not filled yet
+      return -1;
+    if(Atomic::compareAndSwap(head, slot, slot + 1))
+      return task - 1;
+  }
+}
+
+bool ParallelExecutor::Event::unregister()
+{
+  for(;;)
+  {
+    const int w = waiting;
+    if(!w)
+      return false;
+    if(Atomic::compareAndSwap(waiting, w, w - 1))
+      return true;
+  }
+}
+
+void ParallelExecutor::Event::wait(bool block)
+{
+  // If the registration was already removed by a notification, its post must be consumed.
+  if(block || !unregister())
+    semaphore.wait();
+}
+
+void ParallelExecutor::Event::notifyOne()
+{
+  if(unregister())
+    semaphore.post();
+}
+
+ParallelExecutor::Worker::~Worker()
+{
+  if(thread.isRunning())
+  {
+    thread.announceStop();
+    startFrame.post();
+  }
+}
+
+void ParallelExecutor::Worker::run()
+{
+  for(;;)
+  {
+    startFrame.wait();
+    if(!thread.isRunning())
+      break;
+    executor.shareProcessWideData();
+    for(;;)
+    {
+      executor.runReadyTasks();
+      executor.taskReady.prepareWait();
+      const bool finished = executor.numOfFinished == (int) executor.tasks.size();
+      executor.taskReady.wait(!finished && executor.readyQueue.isEmpty());
+      if(finished)
+        break;
+    }
+    frameDone.post();
+  }
+}
+
+ParallelExecutor::ParallelExecutor(int numOfThreads) :
+  numOfFinished(0),
+  timings(0),
+  started(false),
+  blackboard(0),
+  debugOut(0),
+  teamOut(0),
+  settings(0),
+  debugRequestTable(0),
+  debugDataTable(0),
+  streamHandler(0),
+  drawingManager(0),
+  drawingManager3D(0),
+  releaseOptions(0)
+{
+  for(int i = 1; i < numOfThreads; ++i)
+    workers.push_back(new Worker(*this));
+}
+
+ParallelExecutor::~ParallelExecutor()
+{
+  for(std::vector<Worker*>::iterator i = workers.begin(); i != workers.end(); ++i)
+    delete *i;
+  for(std::vector<Task*>::iterator i = tasks.begin(); i != tasks.end(); ++i)
+    delete *i;
+}
+
+int ParallelExecutor::addTask(void (*update)(Blackboard&), Blackboard* instance, bool pinned)
+{
+  tasks.push_back(new Task(update, instance, pinned));
+  return (int) tasks.size() - 1;
+}
+
+void ParallelExecutor::addDependency(int before, int after)
+{
+  ASSERT(before < after);
+  tasks[before]->successors.push_back(after);
+  ++tasks[after]->numOfPredecessors;
+}
+
+void ParallelExecutor::execute(ModuleTimings* timings)
+{
+  // The additional threads are started here, because this is the thread of the process
+  if(!started)
+  {
+    for(std::vector<Worker*>::iterator i = workers.begin(); i != workers.end(); ++i)
+      (*i)->thread.start(*i, &Worker::run);
+    started = true;
+  }
+
+  blackboard = Blackboard::theInstance;
+  debugOut = Global::theDebugOut;
+  teamOut = Global::theTeamOut;
+  settings = Global::theSettings;
+  debugRequestTable = Global::theDebugRequestTable;
+  debugDataTable = Global::theDebugDataTable;
+  streamHandler = Global::theStreamHandler;
+  drawingManager = Global::theDrawingManager;
+  drawingManager3D = Global::theDrawingManager3D;
+  releaseOptions = Global::theReleaseOptions;
+  this->timings = timings;
+
+  const int numOfTasks = (int) tasks.size();
+  readyQueue.reset(numOfTasks);
+  numOfFinished = 0;
+  for(int i = 0; i < numOfTasks; ++i)
+  {
+    Task& task = *tasks[i];
+    task.pending = task.numOfPredecessors;
+    if(!task.numOfPredecessors && !task.pinned)
+      readyQueue.push(i);
+  }
+  Atomic::barrier();
+
+  for(std::vector<Worker*>::iterator i = workers.begin(); i != workers.end(); ++i)
+    (*i)->startFrame.post();
+
+  // Pinned tasks are executed in their sequential order. Help with the others while waiting.
+  for(int i = 0; i < numOfTasks; ++i)
+    if(tasks[i]->pinned)
+    {
+      for(;;)
+      {
+        runReadyTasks();
+        pinnedTaskReady.prepareWait();
+        const bool ready = !tasks[i]->pending;
+        pinnedTaskReady.wait(!ready && readyQueue.isEmpty());
+        if(ready)
+          break;
+      }
+      run(i);
+    }
+  runReadyTasks(); // the workers finish the rest
+
+  for(std::vector<Worker*>::iterator i = workers.begin(); i != workers.end(); ++i)
+    (*i)->frameDone.wait();
+
+  // Forward the messages to the team in the sequence of a sequential execution
+  if(teamOut)
+    for(std::vector<Task*>::iterator i = tasks.begin(); i != tasks.end(); ++i)
+      if(!(*i)->teamOut.isEmpty())
+      {
+        (*i)->teamOut.copyAllMessages(*teamOut);
+        (*i)->teamOut.clear();
+      }
+}
+
+void ParallelExecutor::run(int task)
+{
+  Task& t = *tasks[task];
+  if(t.instance)
+  {
+    if(teamOut)
+      Global::theTeamOut = &t.teamOut.out;
+    if(timings)
+    {
+      const unsigned startTime = SystemCall::getUsSystemTime();
+      t.update(*t.instance);
+      timings->add(task, SystemCall::getUsSystemTime() - startTime);
+    }
+    else
+      t.update(*t.instance);
+    Global::theTeamOut = teamOut;
+  }
+  for(std::vector<int>::const_iterator i = t.successors.begin(); i != t.successors.end(); ++i)
+    if(!Atomic::add(tasks[*i]->pending, -1))
+    {
+      if(tasks[*i]->pinned)
+        pinnedTaskReady.notifyAll();
+      else
+      {
+        readyQueue.push(*i);
+        taskReady.notifyOne();
+      }
+    }
+  if(Atomic::add(numOfFinished, 1) == (int) tasks.size())
+    taskReady.notifyAll();
+}
+
+void ParallelExecutor::runReadyTasks()
+{
+  for(int task = readyQueue.pop(); task >= 0; task = readyQueue.pop())
+    run(task);
+}
+
+void ParallelExecutor::shareProcessWideData() const
+{
+  Blackboard::theInstance = blackboard;
+  Global::theDebugOut = debugOut;
+  Global::theTeamOut = teamOut;
+  Global::theSettings = settings;
+  Global::theDebugRequestTable = debugRequestTable;
+  Global::theDebugDataTable = debugDataTable;
+  Global::theStreamHandler = streamHandler;
+  Global::theDrawingManager = drawingManager;
+  Global::theDrawingManager3D = drawingManager3D;
+  Global::theReleaseOptions = releaseOptions;
+}
@@ -0,0 +1,243 @@
+/**
+* @file ParallelExecutor.h
+* Declaration of a class that executes the providers of a process in parallel.
+*/
+
+#ifndef __ParallelExecutor_h_
+#define __ParallelExecutor_h_
+
+#include "Tools/Global.h"
+#include "Tools/MessageQueue/MessageQueue.h"
+#include "Platform/Thread.h"
+#include <vector>
+
+class Blackboard;
+class ModuleTimings;
+
+/**
+* @class ParallelExecutor
+*
+* The class executes the providers of a process using a number of threads.
+* The providers are added in the sequence determined by the ModuleManager.
+* Together with the dependencies between them, they form a directed acyclic graph.
+* A provider becomes ready when all providers it depends on were executed. Ready
+* providers are put into a lock-free queue from which all threads take their work.
+* Threads that have nothing to do block until they are notified.
+* Pinned providers, i.e. the ones of modules that use process wide data that only
+* exists in the thread of the process, are always executed by the thread of the
+* process in their original sequence. While waiting for their predecessors,
+* the thread of the process helps executing the other providers.
+* Messages sent to the team are collected per provider and are forwarded in the
+* original sequence after all providers were executed, so the messages (including
+* the stopwatch measurements) are the same as in a sequential execution.
+*/
+class ParallelExecutor
+{
+private:
+  /**
+  * The class represents a provider that is executed.
+  */
+  class Task
+  {
+  public:
+    void (*update)(Blackboard&); /**< The update handler within the module. */
+    Blackboard* instance; /**< The instance of the module or 0 if the representation is not updated. */
+    bool pinned; /**< Must this task be executed by the thread of the process? */
+    std::vector<int> successors; /**< The tasks that depend on this one. */
+    int numOfPredecessors; /**< The number of tasks this one depends on. */
+    volatile int pending; /**< The number of predecessors not executed yet in this frame. */
+    MessageQueue teamOut; /**< The messages sent to the team while executing this task. */
+
+    /**
+    * Constructor.
+    * @param update The update handler within the module.
+    * @param instance The instance of the module or 0 if the representation is not updated.
+    * @param pinned Must this task be executed by the thread of the process?
+    */
+    Task(void (*update)(Blackboard&), Blackboard* instance, bool pinned);
+  };
+
+  /**
+  * The class implements a bounded queue of ready tasks that can be used by
+  * multiple threads at the same time without locking. Since each task is put
+  * into the queue at most once per frame, the queue never wraps around. It is
+  * reset at the beginning of each frame.
+  */
+  class ReadyQueue
+  {
+  private:
+    volatile int* slots; /**< The slots. Each contains the number of a task + 1 or 0 if it was not filled yet. */
+    int capacity; /**< The number of slots allocated. */
+    volatile int head, /**< The next slot that will be read. */
+                 tail; /**< The next slot that will be reserved for writing. */
+
+  public:
+    /** Constructor. */
+    ReadyQueue() : slots(0), capacity(0), head(0), tail(0) {}
+
+    /** Destructor. */
+    ~ReadyQueue() {delete [] slots;}
+
+    /**
+    * The method empties the queue. It must not be called while other threads access the queue.
+    * @param size The maximum number of entries.
+    */
+    void reset(int size);
+
+    /**
+    * The method adds a task to the queue.
+    * @param task The number of the task.
+    */
+    void push(int task);
+
+    /**
+    * The method removes the first task from the queue.
+    * @return The number of the task or -1 if the queue is empty.
+    */
+    int pop();
+
+    /**
+    * The method returns whether the queue is empty. A task that is currently
+    * being added counts as not empty.
+    * @return Is the queue empty?
+    */
+    bool isEmpty() const {return head == tail;}
+  };
+
+  /**
+  * The class lets threads block until a condition may have changed. A thread
+  * registers before it checks the condition, so a notification between the
+  * check and waiting is not lost. Only registered threads are woken up, so
+  * the semaphore does not accumulate posts.
+  */
+  class Event
+  {
+  private:
+    Semaphore semaphore; /**< Posted once for each thread woken up. */
+    volatile int waiting; /**< The number of threads registered and not woken up yet. */
+
+    /**
+    * The method tries to remove one registration.
+    * @return Was there a registration to remove?
+    */
+    bool unregister();
+
+  public:
+    /** Constructor. */
+    Event() : waiting(0) {}
+
+    /** The method registers the calling thread. The condition must be checked afterwards. */
+    void prepareWait() {Atomic::add(waiting, 1);}
+
+    /**
+    * The method either blocks the registered calling thread until it is notified or
+    * cancels its registration.
+    * @param block Does the condition require to wait?
+    */
+    void wait(bool block);
+
+    /** The method wakes up one registered thread, if there is any. */
+    void notifyOne();
+
+    /** The method wakes up all registered threads. */
+    void notifyAll() {while(unregister()) semaphore.post();}
+  };
+
+  /**
+  * The class represents an additional thread that executes tasks.
+  */
+  class Worker
+  {
+  public:
+    ParallelExecutor& executor; /**< The executor this thread works for. */
+    Semaphore startFrame; /**< Signals that the tasks of the next frame can be executed. */
+    Semaphore frameDone; /**< Signals that this thread has finished the current frame. */
+    Thread<Worker> thread; /**< The thread. Declared last, so it is terminated before the semaphores are destroyed. */
+
+    /**
+    * Constructor.
+    * @param executor The executor this thread works for.
+    */
+    Worker(ParallelExecutor& executor) : executor(executor) {}
+
+    /** Destructor. Terminates the thread. */
+    ~Worker();
+
+    /** The main function of the thread. */
+    void run();
+  };
+
+  std::vector<Task*> tasks; /**< All tasks in their sequential order. */
+  std::vector<Worker*> workers; /**< The additional threads. */
+  ReadyQueue readyQueue; /**< The tasks that are ready to be executed by any thread. */
+  Event taskReady; /**< Notified when a task was put into the ready queue and when the frame is finished. The workers wait for it. */
+  Event pinnedTaskReady; /**< Notified when a pinned task becomes ready. The thread of the process waits for it. */
+  volatile int numOfFinished; /**< The number of tasks executed in the current frame. */
+  ModuleTimings* timings; /**< The execution times are recorded here in the current frame. 0 if they are not measured. */
+  bool started; /**< Were the additional threads started? */
+
+  // The process wide data of the thread of the process that is shared with the additional threads.
+  Blackboard* blackboard;
+  OutMessage* debugOut;
+  OutMessage* teamOut;
+  Settings* settings;
+  DebugRequestTable* debugRequestTable;
+  DebugDataTable* debugDataTable;
+  StreamHandler* streamHandler;
+  DrawingManager* drawingManager;
+  DrawingManager3D* drawingManager3D;
+  ReleaseOptions* releaseOptions;
+
+  /**
+  * The method executes a task and marks its successors as ready if all their
+  * predecessors were executed.
+  * @param task The number of the task.
+  */
+  void run(int task);
+
+  /**
+  * The method executes tasks from the queue of ready tasks until it is empty.
+  */
+  void runReadyTasks();
+
+  /**
+  * The method sets the process wide data of the calling thread to the ones of
+  * the thread of the process.
+  */
+  void shareProcessWideData() const;
+
+public:
+  /**
+  * Constructor.
+  * @param numOfThreads The number of threads including the one of the process.
+  */
+  ParallelExecutor(int numOfThreads);
+
+  /** Destructor. Terminates the additional threads. */
+  ~ParallelExecutor();
+
+  /**
+  * The method adds a task. Tasks must be added in their sequential order.
+  * @param update The update handler within the module.
+  * @param instance The instance of the module or 0 if the representation is not updated.
+  * @param pinned Must this task be executed by the thread of the process?
+  * @return The number of the task.
+  */
+  int addTask(void (*update)(Blackboard&), Blackboard* instance, bool pinned);
+
+  /**
+  * The method adds a dependency between two tasks.
+  * @param before The number of the task that must be executed first.
+  * @param after The number of the task that must be executed afterwards (before < after).
+  */
+  void addDependency(int before, int after);
+
+  /**
+  * The method executes all tasks. It must be called by the thread of the process.
+  * @param timings If not 0, the execution times of all tasks are recorded here.
+  *                The tasks use the same indices as the providers in the timings.
+  */
+  void execute(ModuleTimings* timings);
+};
+
+#endif //__ParallelExecutor_h_
@@ -11,6 +11,7 @@
 
 #include "Tools/Math/Pose2D.h"
 #include "Platform/GTAssert.h"
+#include <vector>
 
 /**
  * @class SelfLocatorSample
@@ -155,23 +156,27 @@ template<class T> class SampleSetProxy : public SampleSetProxyBase
  * A container for samples. Two independant sets are maintained.
  * As the sample set can be used by different modules that require
  * a different number of samples, the size of the set can be changed
- * at runtime.
+ * at runtime. It can also shrink and grow within the capacity
+ * allocated at construction, e.g. for adapting the number of samples
+ * to the uncertainty of the estimate.
  */
 template<class T> class SampleSet
 {
   private:
     int num; /**< The number of samples. */
+    int capacity; /**< The number of samples allocated. */
     T* current, /**< The actual sample set. */
      * other; /**< The secondary sample set. */
 
   public:
     /**
      * Constructor.
+     * @param num_ The number of samples allocated. Initially, all of them are used.
      */
     SampleSet(int num_)
     {
       ASSERT(num_ > 0);
-      num = num_;
+      num = capacity = num_;
       current = new T[num];
       other = new T[num];
     }
@@ -200,6 +205,20 @@ template<class T> class SampleSet
     */
     int size() const {return num;}
 
+    /**
+    * The function returns the maximum number of samples in the set.
+    * @return The number of samples allocated.
+    */
+    int getCapacity() const {return capacity;}
+
+    /**
+    * The function changes the number of samples in the set. The samples
+    * that remain in the set are not changed. Added samples keep the
+    * values they had when they were used the last time.
+    * @param num_ The new number of samples. 0 < num_ <= getCapacity().
+    */
+    void resize(int num_) {ASSERT(num_ > 0 && num_ <= capacity); num = num_;}
+
     /**
      * Access operator.
      * @param index The index of the sample to access.
@@ -225,4 +244,50 @@ template<class T> class SampleSet
     }
 };
 
+/**
+ * @class SelfLocatorSampleArrays
+ * The poses of a set of SelfLocatorSamples stored as a structure of arrays.
+ * The sensor models process all samples for one observation at a time. In
+ * this layout, the values of consecutive samples are adjacent in memory, so
+ * the compiler can vectorize these loops.
+ */
+class SelfLocatorSampleArrays
+{
+  public:
+    std::vector<int> x, /**< The x coordinates of the samples in mm. */
+                     y, /**< The y coordinates of the samples in mm. */
+                     cosAngle, /**< The cosinus of the rotations multiplied by 1024. */
+                     sinAngle; /**< The sinus of the rotations multiplied by 1024. */
+    std::vector<double> angle; /**< The rotations in radians. */
+
+    /**
+    * The function copies the poses of all samples of a sample set.
+    * @param samples The sample set.
+    */
+    void fill(const SampleSet<SelfLocatorSample>& samples)
+    {
+      const int num = samples.size();
+      x.resize(num);
+      y.resize(num);
+      cosAngle.resize(num);
+      sinAngle.resize(num);
+      angle.resize(num);
+      for(int i = 0; i < num; ++i)
+      {
+        const SelfLocatorSample& s = samples.at(i);
+        x[i] = s.translation.x;
+        y[i] = s.translation.y;
+        cosAngle[i] = s.rotation.x;
+        sinAngle[i] = s.rotation.y;
+        angle[i] = s.angle;
+      }
+    }
+
+    /**
+    * The function returns the number of samples.
+    * @return The number of samples.
+    */
+    int size() const {return (int) x.size();}
+};
+
 #endif //SampleSet_h_
@@ -677,6 +677,57 @@ protected:
   { if(memory != 0) { memcpy(memory,p,size); memory += size; length += size; } }
 };
 
+/**
+* @class OutBoundedMemory
+*
+* A PhysicalOutStream that writes the data to a memory block of a limited size.
+* Data that does not fit into the block is not written, but it is still counted,
+* so the size required can be determined afterwards.
+*/
+class OutBoundedMemory : public PhysicalOutStream
+{
+private:
+  char* memory; /**< Points to the first byte of the memory block. */
+  int capacity; /**< The size of the memory block. */
+  int length; /**< The number of bytes streamed so far. */
+
+public:
+  /** Default constructor */
+  OutBoundedMemory() : memory(0), capacity(0), length(0) {}
+
+  /**
+  * Returns the number of bytes streamed. If it is larger than the size of 
+  * the memory block, the data was not written completely.
+  */
+  int getLength() const {return length;}
+
+  /**
+  * Returns whether all data streamed was written to the memory block.
+  */
+  bool isComplete() const {return length <= capacity;}
+
+protected:
+  /**
+  * opens the stream.
+  * @param mem The address of the memory block into which is written.
+  * @param size The size of the memory block.
+  */
+  void open(void* mem, int size)
+  { memory = (char*) mem; capacity = size; length = 0;}
+
+  /**
+  * The function writes a number of bytes into memory if they still fit in.
+  * @param p The address the data is located at.
+  * @param size The number of bytes to be written.
+  */
+  virtual void writeToStream(const void *p, int size)
+  {
+    if(length + size <= capacity)
+      memcpy(memory + length, p, size);
+    length += size;
+  }
+};
+
 /**
 * @class OutSize
 *
@@ -776,6 +827,29 @@ public:
   virtual bool isBinary() const {return true;}
 };
 
+/**
+* @class OutBinaryBoundedMemory
+* 
+* A binary stream into a memory region of a limited size.
+*/
+class OutBinaryBoundedMemory : public OutStream<OutBoundedMemory,OutBinary>
+{
+public:  
+  /**
+  * Constructor.
+  * @param mem The address of the memory block into which is written.
+  * @param size The size of the memory block.
+  */
+  OutBinaryBoundedMemory(void* mem, int size) 
+  { open(mem, size); }
+
+  /**
+  * The function returns whether this is a binary stream.
+  * @return Does it output data in binary format?
+  */
+  virtual bool isBinary() const {return true;}
+};
+
 /** 
 * @class OutBinarySize
 *